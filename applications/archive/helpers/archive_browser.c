@@ -39,6 +39,13 @@ static void
     }
 }
 
+static void archive_folder_change_cb(void* context) {
+    furi_assert(context);
+    ArchiveBrowserView* browser = (ArchiveBrowserView*)context;
+
+    archive_refresh_dir(browser);
+}
+
 static void archive_list_load_cb(void* context, uint32_t list_load_offset) {
     furi_assert(context);
     ArchiveBrowserView* browser = (ArchiveBrowserView*)context;
@@ -82,6 +89,7 @@ void archive_file_browser_set_callbacks(ArchiveBrowserView* browser) {
 
     file_browser_worker_set_callback_context(browser->worker, browser);
     file_browser_worker_set_folder_callback(browser->worker, archive_folder_open_cb);
+    file_browser_worker_set_folder_change_callback(browser->worker, archive_folder_change_cb);
     file_browser_worker_set_list_callback(browser->worker, archive_list_load_cb);
     file_browser_worker_set_item_callback(browser->worker, archive_list_item_cb);
     file_browser_worker_set_long_load_callback(browser->worker, archive_long_load_cb);
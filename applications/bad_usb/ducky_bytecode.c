@@ -0,0 +1,664 @@
+#include "ducky_bytecode.h"
+
+#include <m-array.h>
+#include <m-string.h>
+
+#define TAG "BadUSB"
+#define WORKER_TAG TAG "Worker"
+#define FILE_BUFFER_LEN 16
+
+// Heap left to the rest of the app after bytecode is allocated
+#define DUCKY_BYTECODE_HEAP_RESERVE (16 * 1024)
+#define DUCKY_BYTECODE_STRING_RUN_MAX UINT16_MAX
+#define DUCKY_BYTECODE_NO_LINE UINT32_MAX
+
+/** Bytecode instructions, operands follow in little endian */
+typedef enum {
+    DuckyOpLine, // uint16_t line number, starts every script line
+    DuckyOpKey, // uint16_t key code with modifiers, pressed and released
+    DuckyOpString, // uint16_t length, characters
+    DuckyOpAltCode, // uint8_t length, decimal digits typed on keypad while ALT is held
+    DuckyOpNumlock, // turn NUMLOCK on
+    DuckyOpDelay, // uint32_t delay in ms
+    DuckyOpDefaultDelay, // uint32_t delay added after every line
+    DuckyOpRepeat, // uint32_t count, uint32_t offset of the repeated line
+    DuckyOpRollover, // uint8_t 1 to pack STRING characters into multi-key reports, 0 not to
+    DuckyOpError, // line can't be parsed
+} DuckyOp;
+
+ARRAY_DEF(DuckyBytecodeData, uint8_t, M_POD_OPLIST)
+
+struct DuckyBytecode {
+    const DuckyHidSink* sink;
+    void* context;
+    bool rollover_default;
+
+    DuckyBytecodeData_t data;
+    size_t size; // Emitted bytes, the only thing counted while measuring
+    bool measure;
+    uint16_t line_count;
+    uint32_t repeat_target;
+    FuriHalUsbHidConfig hid_cfg;
+    bool hid_cfg_set;
+
+    uint32_t pc;
+    uint32_t defdelay;
+    bool rollover;
+    uint32_t repeat_cnt;
+    uint32_t repeat_pc;
+    uint16_t line_cur;
+    uint16_t error_line;
+};
+
+typedef struct {
+    char* name;
+    uint16_t keycode;
+} DuckyKey;
+
+static const DuckyKey ducky_keys[] = {
+    {"CTRL-ALT", KEY_MOD_LEFT_CTRL | KEY_MOD_LEFT_ALT},
+    {"CTRL-SHIFT", KEY_MOD_LEFT_CTRL | KEY_MOD_LEFT_SHIFT},
+    {"ALT-SHIFT", KEY_MOD_LEFT_ALT | KEY_MOD_LEFT_SHIFT},
+    {"ALT-GUI", KEY_MOD_LEFT_ALT | KEY_MOD_LEFT_GUI},
+    {"GUI-SHIFT", KEY_MOD_LEFT_GUI | KEY_MOD_LEFT_SHIFT},
+
+    {"CTRL", KEY_MOD_LEFT_CTRL},
+    {"CONTROL", KEY_MOD_LEFT_CTRL},
+    {"SHIFT", KEY_MOD_LEFT_SHIFT},
+    {"ALT", KEY_MOD_LEFT_ALT},
+    {"GUI", KEY_MOD_LEFT_GUI},
+    {"WINDOWS", KEY_MOD_LEFT_GUI},
+
+    {"DOWNARROW", HID_KEYBOARD_DOWN_ARROW},
+    {"DOWN", HID_KEYBOARD_DOWN_ARROW},
+    {"LEFTARROW", HID_KEYBOARD_LEFT_ARROW},
+    {"LEFT", HID_KEYBOARD_LEFT_ARROW},
+    {"RIGHTARROW", HID_KEYBOARD_RIGHT_ARROW},
+    {"RIGHT", HID_KEYBOARD_RIGHT_ARROW},
+    {"UPARROW", HID_KEYBOARD_UP_ARROW},
+    {"UP", HID_KEYBOARD_UP_ARROW},
+
+    {"ENTER", HID_KEYBOARD_RETURN},
+    {"BREAK", HID_KEYBOARD_PAUSE},
+    {"PAUSE", HID_KEYBOARD_PAUSE},
+    {"CAPSLOCK", HID_KEYBOARD_CAPS_LOCK},
+    {"DELETE", HID_KEYBOARD_DELETE},
+    {"BACKSPACE", HID_KEYPAD_BACKSPACE},
+    {"END", HID_KEYBOARD_END},
+    {"ESC", HID_KEYBOARD_ESCAPE},
+    {"ESCAPE", HID_KEYBOARD_ESCAPE},
+    {"HOME", HID_KEYBOARD_HOME},
+    {"INSERT", HID_KEYBOARD_INSERT},
+    {"NUMLOCK", HID_KEYPAD_NUMLOCK},
+    {"PAGEUP", HID_KEYBOARD_PAGE_UP},
+    {"PAGEDOWN", HID_KEYBOARD_PAGE_DOWN},
+    {"PRINTSCREEN", HID_KEYBOARD_PRINT_SCREEN},
+    {"SCROLLOCK", HID_KEYBOARD_SCROLL_LOCK},
+    {"SPACE", HID_KEYBOARD_SPACEBAR},
+    {"TAB", HID_KEYBOARD_TAB},
+    {"MENU", HID_KEYBOARD_APPLICATION},
+    {"APP", HID_KEYBOARD_APPLICATION},
+
+    {"F1", HID_KEYBOARD_F1},
+    {"F2", HID_KEYBOARD_F2},
+    {"F3", HID_KEYBOARD_F3},
+    {"F4", HID_KEYBOARD_F4},
+    {"F5", HID_KEYBOARD_F5},
+    {"F6", HID_KEYBOARD_F6},
+    {"F7", HID_KEYBOARD_F7},
+    {"F8", HID_KEYBOARD_F8},
+    {"F9", HID_KEYBOARD_F9},
+    {"F10", HID_KEYBOARD_F10},
+    {"F11", HID_KEYBOARD_F11},
+    {"F12", HID_KEYBOARD_F12},
+};
+
+static const char ducky_cmd_comment[] = {"REM"};
+static const char ducky_cmd_id[] = {"ID"};
+static const char ducky_cmd_delay[] = {"DELAY "};
+static const char ducky_cmd_string[] = {"STRING "};
+static const char ducky_cmd_defdelay_1[] = {"DEFAULT_DELAY "};
+static const char ducky_cmd_defdelay_2[] = {"DEFAULTDELAY "};
+static const char ducky_cmd_repeat[] = {"REPEAT "};
+static const char ducky_cmd_rollover[] = {"ROLLOVER "};
+
+static const char ducky_cmd_altchar[] = {"ALTCHAR "};
+static const char ducky_cmd_altstr_1[] = {"ALTSTRING "};
+static const char ducky_cmd_altstr_2[] = {"ALTCODE "};
+
+static const uint8_t numpad_keys[10] = {
+    HID_KEYPAD_0,
+    HID_KEYPAD_1,
+    HID_KEYPAD_2,
+    HID_KEYPAD_3,
+    HID_KEYPAD_4,
+    HID_KEYPAD_5,
+    HID_KEYPAD_6,
+    HID_KEYPAD_7,
+    HID_KEYPAD_8,
+    HID_KEYPAD_9,
+};
+
+DuckyBytecode* ducky_bytecode_alloc(const DuckyHidSink* sink, void* context) {
+    furi_assert(sink);
+    DuckyBytecode* instance = malloc(sizeof(DuckyBytecode));
+    instance->sink = sink;
+    instance->context = context;
+    instance->rollover_default = true;
+    instance->rollover = true;
+    DuckyBytecodeData_init(instance->data);
+    return instance;
+}
+
+void ducky_bytecode_free(DuckyBytecode* instance) {
+    furi_assert(instance);
+    DuckyBytecodeData_clear(instance->data);
+    free(instance);
+}
+
+static void ducky_emit(DuckyBytecode* instance, const void* data, size_t size) {
+    instance->size += size;
+    if(instance->measure) return;
+
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < size; i++) {
+        DuckyBytecodeData_push_back(instance->data, bytes[i]);
+    }
+}
+
+static void ducky_emit_op(DuckyBytecode* instance, DuckyOp op) {
+    uint8_t opcode = op;
+    ducky_emit(instance, &opcode, sizeof(opcode));
+}
+
+static void ducky_emit_u8(DuckyBytecode* instance, uint8_t value) {
+    ducky_emit(instance, &value, sizeof(value));
+}
+
+static void ducky_emit_u16(DuckyBytecode* instance, uint16_t value) {
+    ducky_emit(instance, &value, sizeof(value));
+}
+
+static void ducky_emit_u32(DuckyBytecode* instance, uint32_t value) {
+    ducky_emit(instance, &value, sizeof(value));
+}
+
+static bool ducky_get_number(const char* param, uint32_t* val) {
+    uint32_t value = 0;
+    if(sscanf(param, "%lu", &value) == 1) {
+        *val = value;
+        return true;
+    }
+    return false;
+}
+
+static uint32_t ducky_get_command_len(const char* line) {
+    uint32_t len = strlen(line);
+    for(uint32_t i = 0; i < len; i++) {
+        if(line[i] == ' ') return i;
+    }
+    return 0;
+}
+
+static bool ducky_is_line_end(const char chr) {
+    return ((chr == ' ') || (chr == '\0') || (chr == '\r') || (chr == '\n'));
+}
+
+static uint16_t ducky_get_keycode(const char* param, bool accept_chars) {
+    for(uint8_t i = 0; i < (sizeof(ducky_keys) / sizeof(ducky_keys[0])); i++) {
+        uint8_t key_cmd_len = strlen(ducky_keys[i].name);
+        if((strncmp(param, ducky_keys[i].name, key_cmd_len) == 0) &&
+           (ducky_is_line_end(param[key_cmd_len]))) {
+            return ducky_keys[i].keycode;
+        }
+    }
+    if((accept_chars) && (strlen(param) > 0)) {
+        return (HID_ASCII_TO_KEY(param[0]) & 0xFF);
+    }
+    return 0;
+}
+
+static void ducky_compile_altcode(DuckyBytecode* instance, const char* digits, uint8_t len) {
+    ducky_emit_op(instance, DuckyOpAltCode);
+    ducky_emit(instance, &len, sizeof(len));
+    ducky_emit(instance, digits, len);
+}
+
+static bool ducky_compile_altchar(DuckyBytecode* instance, const char* charcode) {
+    uint8_t len = 0;
+    while(!ducky_is_line_end(charcode[len]) && len < UINT8_MAX) {
+        if((charcode[len] < '0') || (charcode[len] > '9')) break;
+        len++;
+    }
+    // Digits before the first wrong character are still typed
+    ducky_compile_altcode(instance, charcode, len);
+    return (len > 0) && ducky_is_line_end(charcode[len]);
+}
+
+static bool ducky_compile_altstring(DuckyBytecode* instance, const char* param) {
+    uint32_t i = 0;
+    bool state = false;
+
+    while(param[i] != '\0') {
+        if((param[i] < ' ') || (param[i] > '~')) {
+            i++;
+            continue; // Skip non-printable chars
+        }
+
+        char temp_str[4];
+        uint8_t len = snprintf(temp_str, 4, "%u", param[i]);
+        ducky_compile_altcode(instance, temp_str, len);
+        state = true;
+        i++;
+    }
+    return state;
+}
+
+static void ducky_compile_string(DuckyBytecode* instance, const char* param) {
+    size_t len = strlen(param);
+    while(len > 0) {
+        uint16_t run = MIN(len, (size_t)DUCKY_BYTECODE_STRING_RUN_MAX);
+        ducky_emit_op(instance, DuckyOpString);
+        ducky_emit_u16(instance, run);
+        ducky_emit(instance, param, run);
+        param += run;
+        len -= run;
+    }
+}
+
+static bool ducky_set_usb_id(DuckyBytecode* instance, const char* line) {
+    FuriHalUsbHidConfig* hid_cfg = &instance->hid_cfg;
+    if(sscanf(line, "%lX:%lX", &hid_cfg->vid, &hid_cfg->pid) == 2) {
+        hid_cfg->manuf[0] = '\0';
+        hid_cfg->product[0] = '\0';
+
+        uint8_t id_len = ducky_get_command_len(line);
+        if(!ducky_is_line_end(line[id_len + 1])) {
+            sscanf(
+                &line[id_len + 1],
+                "%31[^\r\n:]:%31[^\r\n]",
+                hid_cfg->manuf,
+                hid_cfg->product);
+        }
+        FURI_LOG_D(
+            WORKER_TAG,
+            "set id: %04X:%04X mfr:%s product:%s",
+            hid_cfg->vid,
+            hid_cfg->pid,
+            hid_cfg->manuf,
+            hid_cfg->product);
+        return true;
+    }
+    return false;
+}
+
+static bool ducky_compile_line(DuckyBytecode* instance, string_t line, uint32_t line_pc) {
+    uint32_t line_len = string_size(line);
+    const char* line_tmp = string_get_cstr(line);
+    bool state = false;
+
+    for(uint32_t i = 0; i < line_len; i++) {
+        if((line_tmp[i] != ' ') && (line_tmp[i] != '\t') && (line_tmp[i] != '\n')) {
+            line_tmp = &line_tmp[i];
+            break; // Skip spaces and tabs
+        }
+        if(i == line_len - 1) return false; // Lines of spaces are not allowed
+    }
+
+    FURI_LOG_D(WORKER_TAG, "line:%s", line_tmp);
+
+    if(strncmp(line_tmp, ducky_cmd_repeat, strlen(ducky_cmd_repeat)) == 0) {
+        // REPEAT - previous line is repeated, keep it as target for the next REPEAT
+        line_tmp = &line_tmp[ducky_get_command_len(line_tmp) + 1];
+        uint32_t repeat_cnt = 0;
+        state = ducky_get_number(line_tmp, &repeat_cnt);
+        if(!state || instance->repeat_target == DUCKY_BYTECODE_NO_LINE) return false;
+        ducky_emit_op(instance, DuckyOpRepeat);
+        ducky_emit_u32(instance, repeat_cnt);
+        ducky_emit_u32(instance, instance->repeat_target);
+        return true;
+    }
+
+    instance->repeat_target = line_pc;
+
+    // General commands
+    if(strncmp(line_tmp, ducky_cmd_comment, strlen(ducky_cmd_comment)) == 0) {
+        // REM - comment line
+        return true;
+    } else if(strncmp(line_tmp, ducky_cmd_id, strlen(ducky_cmd_id)) == 0) {
+        // ID - applied before the script is started, first line only
+        if(instance->line_count == 1) {
+            instance->hid_cfg_set =
+                ducky_set_usb_id(instance, &line_tmp[strlen(ducky_cmd_id) + 1]);
+        }
+        return true;
+    } else if(strncmp(line_tmp, ducky_cmd_delay, strlen(ducky_cmd_delay)) == 0) {
+        // DELAY
+        line_tmp = &line_tmp[ducky_get_command_len(line_tmp) + 1];
+        uint32_t delay_val = 0;
+        state = ducky_get_number(line_tmp, &delay_val);
+        if((state) && (delay_val > 0)) {
+            ducky_emit_op(instance, DuckyOpDelay);
+            ducky_emit_u32(instance, delay_val);
+            return true;
+        }
+        return false;
+    } else if(
+        (strncmp(line_tmp, ducky_cmd_defdelay_1, strlen(ducky_cmd_defdelay_1)) == 0) ||
+        (strncmp(line_tmp, ducky_cmd_defdelay_2, strlen(ducky_cmd_defdelay_2)) == 0)) {
+        // DEFAULT_DELAY
+        line_tmp = &line_tmp[ducky_get_command_len(line_tmp) + 1];
+        uint32_t defdelay = 0;
+        state = ducky_get_number(line_tmp, &defdelay);
+        if(state) {
+            ducky_emit_op(instance, DuckyOpDefaultDelay);
+            ducky_emit_u32(instance, defdelay);
+        }
+        return state;
+    } else if(strncmp(line_tmp, ducky_cmd_rollover, strlen(ducky_cmd_rollover)) == 0) {
+        // ROLLOVER ON|OFF - for hosts that don't press keys of one report in array order
+        line_tmp = &line_tmp[ducky_get_command_len(line_tmp) + 1];
+        bool enable = (strncmp(line_tmp, "ON", 2) == 0);
+        if(!enable && strncmp(line_tmp, "OFF", 3) != 0) return false;
+        ducky_emit_op(instance, DuckyOpRollover);
+        ducky_emit_u8(instance, enable);
+        return true;
+    } else if(strncmp(line_tmp, ducky_cmd_string, strlen(ducky_cmd_string)) == 0) {
+        // STRING
+        line_tmp = &line_tmp[ducky_get_command_len(line_tmp) + 1];
+        ducky_compile_string(instance, line_tmp);
+        return true;
+    } else if(strncmp(line_tmp, ducky_cmd_altchar, strlen(ducky_cmd_altchar)) == 0) {
+        // ALTCHAR
+        line_tmp = &line_tmp[ducky_get_command_len(line_tmp) + 1];
+        ducky_emit_op(instance, DuckyOpNumlock);
+        return ducky_compile_altchar(instance, line_tmp);
+    } else if(
+        (strncmp(line_tmp, ducky_cmd_altstr_1, strlen(ducky_cmd_altstr_1)) == 0) ||
+        (strncmp(line_tmp, ducky_cmd_altstr_2, strlen(ducky_cmd_altstr_2)) == 0)) {
+        // ALTSTRING
+        line_tmp = &line_tmp[ducky_get_command_len(line_tmp) + 1];
+        ducky_emit_op(instance, DuckyOpNumlock);
+        return ducky_compile_altstring(instance, line_tmp);
+    } else {
+        // Special keys + modifiers
+        uint16_t key = ducky_get_keycode(line_tmp, false);
+        if(key == HID_KEYBOARD_NONE) return false;
+        if((key & 0xFF00) != 0) {
+            // It's a modifier key
+            line_tmp = &line_tmp[ducky_get_command_len(line_tmp) + 1];
+            key |= ducky_get_keycode(line_tmp, true);
+        }
+        ducky_emit_op(instance, DuckyOpKey);
+        ducky_emit_u16(instance, key);
+        return true;
+    }
+}
+
+static void ducky_compile_next_line(DuckyBytecode* instance, string_t line) {
+    uint32_t line_pc = instance->size;
+    instance->line_count++;
+    ducky_emit_op(instance, DuckyOpLine);
+    ducky_emit_u16(instance, instance->line_count);
+    if(!ducky_compile_line(instance, line, line_pc)) {
+        ducky_emit_op(instance, DuckyOpError);
+    }
+    string_reset(line);
+}
+
+static bool ducky_compile_pass(DuckyBytecode* instance, Stream* stream) {
+    instance->size = 0;
+    instance->line_count = 0;
+    instance->repeat_target = DUCKY_BYTECODE_NO_LINE;
+    instance->hid_cfg_set = false;
+
+    uint8_t buffer[FILE_BUFFER_LEN];
+    string_t line;
+    string_init(line);
+
+    bool result = true;
+    size_t ret = 0;
+    do {
+        ret = stream_read(stream, buffer, FILE_BUFFER_LEN);
+        for(size_t i = 0; i < ret; i++) {
+            if(buffer[i] == '\n' && string_size(line) > 0) {
+                ducky_compile_next_line(instance, line);
+            } else if(buffer[i] != '\n') {
+                string_push_back(line, buffer[i]);
+            }
+        }
+        if(instance->line_count == UINT16_MAX) {
+            FURI_LOG_E(WORKER_TAG, "Script has too many lines");
+            result = false;
+            break;
+        }
+    } while(ret > 0);
+
+    // Last line may have no line end
+    if(result && string_size(line) > 0) {
+        ducky_compile_next_line(instance, line);
+    }
+    string_clear(line);
+
+    return result;
+}
+
+bool ducky_bytecode_compile(DuckyBytecode* instance, Stream* stream) {
+    furi_assert(instance);
+    furi_assert(stream);
+
+    DuckyBytecodeData_reset(instance->data);
+    size_t start = stream_tell(stream);
+
+    // First pass only measures, so bytecode is allocated once at its final size
+    instance->measure = true;
+    bool result = ducky_compile_pass(instance, stream);
+    instance->measure = false;
+
+    if(result && instance->line_count == 0) {
+        FURI_LOG_E(WORKER_TAG, "Script is empty");
+        result = false;
+    }
+    if(result && instance->size + DUCKY_BYTECODE_HEAP_RESERVE > memmgr_heap_get_max_free_block()) {
+        FURI_LOG_E(WORKER_TAG, "Script is too large: %u bytes", instance->size);
+        result = false;
+    }
+    if(result) {
+        DuckyBytecodeData_reserve(instance->data, instance->size);
+        result = stream_seek(stream, start, StreamOffsetFromStart) &&
+                 ducky_compile_pass(instance, stream);
+    }
+
+    if(result) {
+        FURI_LOG_I(
+            WORKER_TAG,
+            "Compiled %u lines to %u bytes",
+            instance->line_count,
+            DuckyBytecodeData_size(instance->data));
+    } else {
+        DuckyBytecodeData_reset(instance->data);
+        instance->line_count = 0;
+    }
+
+    ducky_bytecode_rewind(instance);
+    return result;
+}
+
+bool ducky_bytecode_get_usb_id(DuckyBytecode* instance, FuriHalUsbHidConfig* hid_cfg) {
+    furi_assert(instance);
+    if(instance->hid_cfg_set) {
+        *hid_cfg = instance->hid_cfg;
+    }
+    return instance->hid_cfg_set;
+}
+
+uint16_t ducky_bytecode_get_line_count(DuckyBytecode* instance) {
+    furi_assert(instance);
+    return instance->line_count;
+}
+
+size_t ducky_bytecode_get_size(DuckyBytecode* instance) {
+    furi_assert(instance);
+    return DuckyBytecodeData_size(instance->data);
+}
+
+void ducky_bytecode_set_rollover(DuckyBytecode* instance, bool enable) {
+    furi_assert(instance);
+    instance->rollover_default = enable;
+    instance->rollover = enable;
+}
+
+void ducky_bytecode_rewind(DuckyBytecode* instance) {
+    furi_assert(instance);
+    instance->pc = 0;
+    instance->defdelay = 0;
+    instance->rollover = instance->rollover_default;
+    instance->repeat_cnt = 0;
+    instance->repeat_pc = 0;
+    instance->line_cur = 0;
+    instance->error_line = 0;
+}
+
+static bool ducky_hid_report(
+    DuckyBytecode* instance,
+    uint8_t mods,
+    const uint8_t* keys,
+    uint8_t count) {
+    return instance->sink->kb_report(instance->context, mods, keys, count);
+}
+
+static void ducky_hid_key(DuckyBytecode* instance, uint16_t keycode) {
+    uint8_t key = keycode & 0xFF;
+    ducky_hid_report(instance, keycode >> 8, &key, (key != HID_KEYBOARD_NONE) ? 1 : 0);
+    ducky_hid_report(instance, 0, NULL, 0);
+}
+
+static void ducky_hid_numlock_on(DuckyBytecode* instance) {
+    if((instance->sink->get_led_state(instance->context) & HID_KB_LED_NUM) == 0) {
+        ducky_hid_key(instance, HID_KEYBOARD_LOCK_NUM_LOCK);
+    }
+}
+
+static void ducky_hid_altcode(DuckyBytecode* instance, const uint8_t* digits, uint8_t len) {
+    const uint8_t alt = KEY_MOD_LEFT_ALT >> 8;
+
+    FURI_LOG_I(WORKER_TAG, "char %.*s", len, (const char*)digits);
+
+    ducky_hid_report(instance, alt, NULL, 0);
+    for(uint8_t i = 0; i < len; i++) {
+        ducky_hid_report(instance, alt, &numpad_keys[digits[i] - '0'], 1);
+        ducky_hid_report(instance, alt, NULL, 0);
+    }
+    ducky_hid_report(instance, 0, NULL, 0);
+}
+
+static void ducky_hid_string(DuckyBytecode* instance, const uint8_t* chars, uint16_t len) {
+    uint8_t keys[DUCKY_HID_KEYS_MAX];
+    uint8_t count = 0;
+    uint8_t mods = 0;
+
+    for(uint16_t i = 0; i < len; i++) {
+        uint16_t keycode = HID_ASCII_TO_KEY(chars[i]);
+        if(keycode == HID_KEYBOARD_NONE) continue;
+
+        // Keys of one report are pressed together in array order, so a report can hold
+        // characters with the same modifiers and no repeated keys
+        uint8_t key = keycode & 0xFF;
+        bool conflict = !instance->rollover || (count == DUCKY_HID_KEYS_MAX) ||
+                        (count > 0 && (keycode >> 8) != mods) ||
+                        (memchr(keys, key, count) != NULL);
+        if(count > 0 && conflict) {
+            ducky_hid_report(instance, mods, keys, count);
+            ducky_hid_report(instance, 0, NULL, 0);
+            count = 0;
+        }
+        mods = keycode >> 8;
+        keys[count++] = key;
+    }
+    if(count > 0) {
+        ducky_hid_report(instance, mods, keys, count);
+        ducky_hid_report(instance, 0, NULL, 0);
+    }
+}
+
+static uint16_t ducky_fetch_u16(const uint8_t* code, uint32_t* pc) {
+    uint16_t value;
+    memcpy(&value, &code[*pc], sizeof(value));
+    *pc += sizeof(value);
+    return value;
+}
+
+static uint32_t ducky_fetch_u32(const uint8_t* code, uint32_t* pc) {
+    uint32_t value;
+    memcpy(&value, &code[*pc], sizeof(value));
+    *pc += sizeof(value);
+    return value;
+}
+
+static int32_t ducky_bytecode_execute_line(DuckyBytecode* instance, uint32_t* pc) {
+    const uint8_t* code = DuckyBytecodeData_cget(instance->data, 0);
+    size_t size = DuckyBytecodeData_size(instance->data);
+    uint32_t delay_val = 0;
+
+    furi_assert(code[*pc] == DuckyOpLine);
+    (*pc)++;
+    uint16_t line_nb = ducky_fetch_u16(code, pc);
+
+    while(*pc < size && code[*pc] != DuckyOpLine) {
+        DuckyOp op = code[(*pc)++];
+        if(op == DuckyOpKey) {
+            ducky_hid_key(instance, ducky_fetch_u16(code, pc));
+        } else if(op == DuckyOpString) {
+            uint16_t len = ducky_fetch_u16(code, pc);
+            ducky_hid_string(instance, &code[*pc], len);
+            *pc += len;
+        } else if(op == DuckyOpAltCode) {
+            uint8_t len = code[(*pc)++];
+            ducky_hid_altcode(instance, &code[*pc], len);
+            *pc += len;
+        } else if(op == DuckyOpNumlock) {
+            ducky_hid_numlock_on(instance);
+        } else if(op == DuckyOpDelay) {
+            delay_val += ducky_fetch_u32(code, pc);
+        } else if(op == DuckyOpDefaultDelay) {
+            instance->defdelay = ducky_fetch_u32(code, pc);
+        } else if(op == DuckyOpRepeat) {
+            instance->repeat_cnt = ducky_fetch_u32(code, pc);
+            instance->repeat_pc = ducky_fetch_u32(code, pc);
+        } else if(op == DuckyOpRollover) {
+            instance->rollover = code[(*pc)++];
+        } else {
+            furi_assert(op == DuckyOpError);
+            instance->error_line = line_nb;
+            FURI_LOG_E(WORKER_TAG, "Unknown command at line %u", line_nb);
+            return SCRIPT_STATE_ERROR;
+        }
+    }
+
+    return (int32_t)(delay_val + instance->defdelay);
+}
+
+int32_t ducky_bytecode_execute_next(DuckyBytecode* instance) {
+    furi_assert(instance);
+
+    if(instance->repeat_cnt > 0) {
+        instance->repeat_cnt--;
+        uint32_t pc = instance->repeat_pc;
+        return ducky_bytecode_execute_line(instance, &pc);
+    }
+
+    if(instance->pc >= DuckyBytecodeData_size(instance->data)) return SCRIPT_STATE_END;
+
+    instance->line_cur++;
+    return ducky_bytecode_execute_line(instance, &instance->pc);
+}
+
+uint16_t ducky_bytecode_get_line(DuckyBytecode* instance) {
+    furi_assert(instance);
+    return instance->line_cur;
+}
+
+uint16_t ducky_bytecode_get_error_line(DuckyBytecode* instance) {
+    furi_assert(instance);
+    return instance->error_line;
+}
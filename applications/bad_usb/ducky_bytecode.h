@@ -0,0 +1,121 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <furi.h>
+#include <furi_hal_usb_hid.h>
+#include <toolbox/stream/stream.h>
+
+#define SCRIPT_STATE_ERROR (-1)
+#define SCRIPT_STATE_END (-2)
+
+#define DUCKY_HID_KEYS_MAX 6
+
+typedef struct DuckyBytecode DuckyBytecode;
+
+/** Keyboard the script is typed to */
+typedef struct {
+    /** Send keyboard report, keys that are not listed are released */
+    bool (*kb_report)(void* context, uint8_t mods, const uint8_t* keys, uint8_t count);
+    /** Get keyboard leds state, HidKeyboardLeds mask */
+    uint8_t (*get_led_state)(void* context);
+} DuckyHidSink;
+
+/** Allocate DuckyBytecode
+ *
+ * @param      sink     keyboard used by ducky_bytecode_execute_next
+ * @param      context  sink callbacks context
+ *
+ * @return     DuckyBytecode instance
+ */
+DuckyBytecode* ducky_bytecode_alloc(const DuckyHidSink* sink, void* context);
+
+/** Free DuckyBytecode
+ *
+ * @param      instance  DuckyBytecode instance
+ */
+void ducky_bytecode_free(DuckyBytecode* instance);
+
+/** Compile script to bytecode and rewind execution to the first line.
+ * Lines that can't be parsed are compiled to an error, reported when execution reaches them.
+ * Script is read twice: bytecode size is measured first, then it is allocated once and
+ * must fit the largest free heap block with 16 KB to spare. Plain scripts compile to about
+ * their own size, ALTSTRING takes up to 5 bytes per character.
+ *
+ * @param      instance  DuckyBytecode instance
+ * @param      stream    seekable script stream, read from the current position
+ *
+ * @return     false if script is empty, has 65535 lines or more, or doesn't fit the heap
+ */
+bool ducky_bytecode_compile(DuckyBytecode* instance, Stream* stream);
+
+/** Get USB device id set by ID command on the first script line
+ *
+ * @param      instance  DuckyBytecode instance
+ * @param      hid_cfg   returned USB HID config
+ *
+ * @return     false if script has no ID command
+ */
+bool ducky_bytecode_get_usb_id(DuckyBytecode* instance, FuriHalUsbHidConfig* hid_cfg);
+
+/** Get number of compiled script lines, empty lines are not counted
+ *
+ * @param      instance  DuckyBytecode instance
+ *
+ * @return     line count
+ */
+uint16_t ducky_bytecode_get_line_count(DuckyBytecode* instance);
+
+/** Get compiled bytecode size
+ *
+ * @param      instance  DuckyBytecode instance
+ *
+ * @return     size in bytes
+ */
+size_t ducky_bytecode_get_size(DuckyBytecode* instance);
+
+/** Pack STRING characters into multi-key reports, enabled by default.
+ * Characters that share modifiers and keys are sent one by one.
+ * Script can change it from any line with ROLLOVER ON or ROLLOVER OFF, for hosts that don't
+ * press keys of one report in array order. Rewind restores the value set here.
+ *
+ * @param      instance  DuckyBytecode instance
+ * @param      enable    true to pack characters
+ */
+void ducky_bytecode_set_rollover(DuckyBytecode* instance, bool enable);
+
+/** Restart execution from the first line
+ *
+ * @param      instance  DuckyBytecode instance
+ */
+void ducky_bytecode_rewind(DuckyBytecode* instance);
+
+/** Execute next script line or next repetition of REPEAT command
+ *
+ * @param      instance  DuckyBytecode instance
+ *
+ * @return     delay before the next line in ms, SCRIPT_STATE_ERROR or SCRIPT_STATE_END
+ */
+int32_t ducky_bytecode_execute_next(DuckyBytecode* instance);
+
+/** Get number of the last executed line, REPEAT command repetitions keep it unchanged
+ *
+ * @param      instance  DuckyBytecode instance
+ *
+ * @return     line number, starting from 1
+ */
+uint16_t ducky_bytecode_get_line(DuckyBytecode* instance);
+
+/** Get number of the line that stopped execution with SCRIPT_STATE_ERROR
+ *
+ * @param      instance  DuckyBytecode instance
+ *
+ * @return     line number, starting from 1
+ */
+uint16_t ducky_bytecode_get_error_line(DuckyBytecode* instance);
+
+#ifdef __cplusplus
+}
+#endif
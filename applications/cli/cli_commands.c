@@ -144,8 +144,19 @@ void cli_command_log_tx_callback(const uint8_t* buffer, size_t size, void* conte
 }
 
 void cli_command_log(Cli* cli, string_t args, void* context) {
-    UNUSED(args);
     UNUSED(context);
+    if(!string_cmp(args, "deferred")) {
+        furi_log_set_deferred(true);
+        return;
+    } else if(!string_cmp(args, "sync")) {
+        furi_log_set_deferred(false);
+        printf("Records dropped in deferred mode: %lu\r\n", furi_log_get_dropped());
+        return;
+    } else if(string_size(args)) {
+        cli_print_usage("log", "[deferred|sync]", string_get_cstr(args));
+        return;
+    }
+
     StreamBufferHandle_t ring = xStreamBufferCreate(CLI_COMMAND_LOG_RING_SIZE, 1);
     uint8_t buffer[CLI_COMMAND_LOG_BUFFER_SIZE];
 
@@ -18,6 +18,20 @@
 #define ANIMATION_MANIFEST_FILE ANIMATION_DIR "/manifest.txt"
 #define TAG "AnimationStorage"
 
+/* Packed frames: AnimationPackHeader, frame_count + 1 uint32_t offsets
+ * from the start of frame data, then frame data (same as frame_N.bm files) */
+#define ANIMATION_PACK_FILE "frames.pack"
+#define ANIMATION_PACK_MAGIC 0x6B706146 /* "Fapk" */
+#define ANIMATION_PACK_VERSION 1
+#define ANIMATION_READ_SIZE_MAX 4096
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t frame_count;
+    uint16_t reserved;
+} __attribute__((packed)) AnimationPackHeader;
+
 static void animation_storage_free_bubbles(BubbleAnimation* animation);
 static void animation_storage_free_frames(BubbleAnimation* animation);
 static void animation_storage_free_animation(BubbleAnimation** storage_animation);
@@ -252,14 +266,158 @@ static bool animation_storage_cast_align(string_t align_str, Align* align) {
 static void animation_storage_free_frames(BubbleAnimation* animation) {
     furi_assert(animation);
 
-    const Icon* icon = &animation->icon_animation;
-    for(int i = 0; i < icon->frame_count; ++i) {
-        if(icon->frames[i]) {
-            free((void*)icon->frames[i]);
+    /* frame pointers and frame data share one allocation */
+    free((void*)animation->icon_animation.frames);
+}
+
+static uint8_t* animation_storage_alloc_frames(BubbleAnimation* animation, size_t data_size) {
+    Icon* icon = (Icon*)&animation->icon_animation;
+    size_t frames_size = sizeof(const uint8_t*) * icon->frame_count;
+    icon->frames = malloc(frames_size + data_size);
+    return (uint8_t*)icon->frames + frames_size;
+}
+
+static bool animation_storage_read(File* file, uint8_t* data, size_t size) {
+    while(size) {
+        uint16_t to_read = MIN(size, (size_t)ANIMATION_READ_SIZE_MAX);
+        if(storage_file_read(file, data, to_read) != to_read) return false;
+        data += to_read;
+        size -= to_read;
+    }
+    return true;
+}
+
+static bool animation_storage_load_frames_packed(
+    File* file,
+    const char* path,
+    BubbleAnimation* animation,
+    size_t max_frame_size) {
+    Icon* icon = (Icon*)&animation->icon_animation;
+    uint32_t* offsets = NULL;
+    bool frames_ok = false;
+
+    do {
+        if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            FURI_LOG_E(TAG, "Can't open file \'%s\'", path);
+            break;
+        }
+
+        AnimationPackHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if((header.magic != ANIMATION_PACK_MAGIC) || (header.version != ANIMATION_PACK_VERSION)) {
+            FURI_LOG_E(TAG, "Unsupported pack \'%s\'", path);
+            break;
+        }
+        if(header.frame_count != icon->frame_count) {
+            FURI_LOG_E(TAG, "Pack frames %d, expected %d", header.frame_count, icon->frame_count);
+            break;
+        }
+
+        size_t offsets_size = sizeof(uint32_t) * (icon->frame_count + 1);
+        offsets = malloc(offsets_size);
+        if(storage_file_read(file, offsets, offsets_size) != offsets_size) break;
+
+        bool offsets_ok = (offsets[0] == 0);
+        for(int i = 0; offsets_ok && (i < icon->frame_count); ++i) {
+            offsets_ok = (offsets[i] < offsets[i + 1]) &&
+                         ((offsets[i + 1] - offsets[i]) <= max_frame_size);
+        }
+        if(!offsets_ok) {
+            FURI_LOG_E(TAG, "Broken frame index \'%s\'", path);
+            break;
+        }
+
+        uint8_t* data = animation_storage_alloc_frames(animation, offsets[icon->frame_count]);
+        if(!animation_storage_read(file, data, offsets[icon->frame_count])) {
+            FURI_LOG_E(TAG, "Read failed: \'%s\'", path);
+            animation_storage_free_frames(animation);
+            break;
+        }
+        for(int i = 0; i < icon->frame_count; ++i) {
+            FURI_CONST_ASSIGN_PTR(icon->frames[i], &data[offsets[i]]);
+        }
+        frames_ok = true;
+    } while(0);
+
+    storage_file_close(file);
+    if(offsets) {
+        free(offsets);
+    }
+
+    return frames_ok;
+}
+
+static bool animation_storage_load_frames_legacy(
+    Storage* storage,
+    File* file,
+    const char* name,
+    BubbleAnimation* animation,
+    size_t max_frame_size) {
+    Icon* icon = (Icon*)&animation->icon_animation;
+    uint16_t* frame_sizes = malloc(sizeof(uint16_t) * icon->frame_count);
+    FileInfo file_info;
+    string_t filename;
+    string_init(filename);
+
+    /* Collect sizes first to keep all frames in one allocation */
+    bool frames_ok = true;
+    size_t data_size = 0;
+    for(int i = 0; frames_ok && (i < icon->frame_count); ++i) {
+        string_printf(filename, ANIMATION_DIR "/%s/frame_%d.bm", name, i);
+        frames_ok = false;
+
+        if(storage_common_stat(storage, string_get_cstr(filename), &file_info) != FSE_OK) break;
+        if(file_info.size > max_frame_size) {
+            FURI_LOG_E(
+                TAG,
+                "Filesize %d, max: %d (width %d, height %d)",
+                file_info.size,
+                max_frame_size,
+                icon->width,
+                icon->height);
+            break;
         }
+        frame_sizes[i] = file_info.size;
+        data_size += file_info.size;
+        frames_ok = true;
     }
 
-    free((void*)icon->frames);
+    if(frames_ok) {
+        uint8_t* data = animation_storage_alloc_frames(animation, data_size);
+        for(int i = 0; frames_ok && (i < icon->frame_count); ++i) {
+            string_printf(filename, ANIMATION_DIR "/%s/frame_%d.bm", name, i);
+            frames_ok = false;
+
+            if(!storage_file_open(
+                   file, string_get_cstr(filename), FSAM_READ, FSOM_OPEN_EXISTING)) {
+                FURI_LOG_E(TAG, "Can't open file \'%s\'", string_get_cstr(filename));
+            } else if(storage_file_read(file, data, frame_sizes[i]) != frame_sizes[i]) {
+                FURI_LOG_E(TAG, "Read failed: \'%s\'", string_get_cstr(filename));
+            } else {
+                FURI_CONST_ASSIGN_PTR(icon->frames[i], data);
+                data += frame_sizes[i];
+                frames_ok = true;
+            }
+            storage_file_close(file);
+        }
+        if(!frames_ok) {
+            animation_storage_free_frames(animation);
+        }
+    }
+
+    if(!frames_ok) {
+        FURI_LOG_E(
+            TAG,
+            "Load \'%s\' failed, %dx%d",
+            string_get_cstr(filename),
+            icon->width,
+            icon->height);
+    }
+
+    string_clear(filename);
+    free(frame_sizes);
+
+    return frames_ok;
 }
 
 static bool animation_storage_load_frames(
@@ -286,54 +444,23 @@ static bool animation_storage_load_frames(
     FURI_CONST_ASSIGN(icon->frame_rate, 0);
     FURI_CONST_ASSIGN(icon->height, height);
     FURI_CONST_ASSIGN(icon->width, width);
-    icon->frames = malloc(sizeof(const uint8_t*) * icon->frame_count);
 
-    bool frames_ok = false;
     File* file = storage_file_alloc(storage);
-    FileInfo file_info;
     string_t filename;
-    string_init(filename);
-    size_t max_filesize = ROUND_UP_TO(width, 8) * height + 1;
-
-    for(int i = 0; i < icon->frame_count; ++i) {
-        frames_ok = false;
-        string_printf(filename, ANIMATION_DIR "/%s/frame_%d.bm", name, i);
-
-        if(storage_common_stat(storage, string_get_cstr(filename), &file_info) != FSE_OK) break;
-        if(file_info.size > max_filesize) {
-            FURI_LOG_E(
-                TAG,
-                "Filesize %d, max: %d (width %d, height %d)",
-                file_info.size,
-                max_filesize,
-                width,
-                height);
-            break;
-        }
-        if(!storage_file_open(file, string_get_cstr(filename), FSAM_READ, FSOM_OPEN_EXISTING)) {
-            FURI_LOG_E(TAG, "Can't open file \'%s\'", string_get_cstr(filename));
-            break;
-        }
+    string_init_printf(filename, ANIMATION_DIR "/%s/" ANIMATION_PACK_FILE, name);
+    /* bitmap is stored uncompressed if compression doesn't help, plus 1 byte header */
+    size_t max_frame_size = ROUND_UP_TO(width, 8) * height + 1;
 
-        FURI_CONST_ASSIGN_PTR(icon->frames[i], malloc(file_info.size));
-        if(storage_file_read(file, (void*)icon->frames[i], file_info.size) != file_info.size) {
-            FURI_LOG_E(TAG, "Read failed: \'%s\'", string_get_cstr(filename));
-            break;
-        }
-        storage_file_close(file);
-        frames_ok = true;
+    bool frames_ok = false;
+    if(storage_common_stat(storage, string_get_cstr(filename), NULL) == FSE_OK) {
+        frames_ok = animation_storage_load_frames_packed(
+            file, string_get_cstr(filename), animation, max_frame_size);
+    } else {
+        frames_ok =
+            animation_storage_load_frames_legacy(storage, file, name, animation, max_frame_size);
     }
 
-    if(!frames_ok) {
-        FURI_LOG_E(
-            TAG,
-            "Load \'%s\' failed, %dx%d, size: %d",
-            string_get_cstr(filename),
-            width,
-            height,
-            file_info.size);
-        animation_storage_free_frames(animation);
-    } else {
+    if(frames_ok) {
         furi_check(animation->icon_animation.frames);
         for(int i = 0; i < animation->icon_animation.frame_count; ++i) {
             furi_check(animation->icon_animation.frames[i]);
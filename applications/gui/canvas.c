@@ -14,11 +14,20 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
     [FontBigNumbers] = {.leading_default = 18, .leading_min = 16, .height = 15, .descender = 0},
 };
 
+// Unchanged columns that are cheaper to resend than to address the next span
+#define CANVAS_COMMIT_SPAN_GAP 3
+
 Canvas* canvas_init() {
+    return canvas_init_ex(u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
+}
+
+Canvas* canvas_init_ex(u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb) {
     Canvas* canvas = malloc(sizeof(Canvas));
 
     // Setup u8g2
-    u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
+    u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, byte_cb, gpio_and_delay_cb);
+    canvas->fb_sent = malloc(canvas_get_buffer_size(canvas));
+    canvas->fb_sent_valid = false;
     canvas->orientation = CanvasOrientationHorizontal;
     // Initialize display
     u8g2_InitDisplay(&canvas->fb);
@@ -34,6 +43,7 @@ Canvas* canvas_init() {
 
 void canvas_free(Canvas* canvas) {
     furi_assert(canvas);
+    free(canvas->fb_sent);
     free(canvas);
 }
 
@@ -49,7 +59,44 @@ void canvas_reset(Canvas* canvas) {
 
 void canvas_commit(Canvas* canvas) {
     furi_assert(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+    u8x8_t* u8x8 = u8g2_GetU8x8(&canvas->fb);
+    uint8_t* buffer = u8g2_GetBufferPtr(&canvas->fb);
+    const size_t page_size = u8g2_GetBufferTileWidth(&canvas->fb) * 8;
+    const size_t page_count = u8g2_GetBufferTileHeight(&canvas->fb);
+
+    // Buffer is in display RAM layout: a page is 8 rows, a byte is a column of a page
+    for(size_t page = 0; page < page_count; page++) {
+        uint8_t* data = &buffer[page * page_size];
+        uint8_t* sent = &canvas->fb_sent[page * page_size];
+
+        if(!canvas->fb_sent_valid) {
+            u8x8_d_st756x_draw_columns(u8x8, page, 0, page_size, data);
+            continue;
+        }
+        if(memcmp(data, sent, page_size) == 0) continue;
+
+        size_t column = 0;
+        while(column < page_size) {
+            if(data[column] == sent[column]) {
+                column++;
+                continue;
+            }
+
+            // Extend span over unchanged columns that are cheaper to resend than to readdress
+            size_t start = column;
+            size_t end = column + 1;
+            for(column = end; column < page_size && column - end <= CANVAS_COMMIT_SPAN_GAP;
+                column++) {
+                if(data[column] != sent[column]) end = column + 1;
+            }
+
+            u8x8_d_st756x_draw_columns(u8x8, page, start, end - start, &data[start]);
+            column = end;
+        }
+    }
+
+    memcpy(canvas->fb_sent, buffer, canvas_get_buffer_size(canvas));
+    canvas->fb_sent_valid = true;
 }
 
 uint8_t* canvas_get_buffer(Canvas* canvas) {
@@ -12,6 +12,8 @@
  */
 struct Canvas {
     u8g2_t fb;
+    uint8_t* fb_sent; /**< Frame in display RAM, valid if fb_sent_valid */
+    bool fb_sent_valid;
     CanvasOrientation orientation;
     uint8_t offset_x;
     uint8_t offset_y;
@@ -25,6 +27,15 @@ struct Canvas {
  */
 Canvas* canvas_init();
 
+/** Allocate memory and initialize canvas on custom display bus
+ *
+ * @param      byte_cb            u8x8 byte callback, display SPI bus
+ * @param      gpio_and_delay_cb  u8x8 gpio and delay callback
+ *
+ * @return     Canvas instance
+ */
+Canvas* canvas_init_ex(u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
 /** Free canvas memory
  *
  * @param      canvas  Canvas instance
@@ -38,6 +49,7 @@ void canvas_free(Canvas* canvas);
 void canvas_reset(Canvas* canvas);
 
 /** Commit canvas. Send buffer to display
+ * Only column spans that differ from the previously sent frame are sent
  *
  * @param      canvas  Canvas instance
  */
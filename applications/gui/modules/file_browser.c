@@ -96,6 +96,7 @@ static bool file_browser_view_input_callback(InputEvent* event, void* context);
 
 static void
     browser_folder_open_cb(void* context, uint32_t item_cnt, int32_t file_idx, bool is_root);
+static void browser_folder_change_cb(void* context);
 static void browser_list_load_cb(void* context, uint32_t list_load_offset);
 static void browser_list_item_cb(void* context, string_t item_path, bool is_folder, bool is_last);
 static void browser_long_load_cb(void* context);
@@ -162,6 +163,7 @@ void file_browser_start(FileBrowser* browser, string_t path) {
     browser->worker = file_browser_worker_alloc(path, browser->ext_filter, browser->skip_assets);
     file_browser_worker_set_callback_context(browser->worker, browser);
     file_browser_worker_set_folder_callback(browser->worker, browser_folder_open_cb);
+    file_browser_worker_set_folder_change_callback(browser->worker, browser_folder_change_cb);
     file_browser_worker_set_list_callback(browser->worker, browser_list_load_cb);
     file_browser_worker_set_item_callback(browser->worker, browser_list_item_cb);
     file_browser_worker_set_long_load_callback(browser->worker, browser_long_load_cb);
@@ -274,6 +276,21 @@ static void
     file_browser_worker_load(browser->worker, load_offset, ITEM_LIST_LEN_MAX);
 }
 
+static void browser_folder_change_cb(void* context) {
+    furi_assert(context);
+    FileBrowser* browser = (FileBrowser*)context;
+
+    int32_t select_index = 0;
+    with_view_model(
+        browser->view, (FileBrowserModel * model) {
+            // Back item is not a folder item
+            select_index = model->is_root ? model->item_idx : model->item_idx - 1;
+            return false;
+        });
+
+    file_browser_worker_folder_refresh(browser->worker, select_index);
+}
+
 static void browser_list_load_cb(void* context, uint32_t list_load_offset) {
     furi_assert(context);
     FileBrowser* browser = (FileBrowser*)context;
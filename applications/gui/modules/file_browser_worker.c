@@ -8,6 +8,7 @@
 #include <storage/storage.h>
 #include <furi.h>
 #include <stddef.h>
+#include <strings.h>
 #include "toolbox/path.h"
 
 #define TAG "BrowserWorker"
@@ -16,6 +17,7 @@
 #define BROWSER_ROOT STORAGE_ANY_PATH_PREFIX
 #define FILE_NAME_LEN_MAX 256
 #define LONG_LOAD_THRESHOLD 100
+#define LISTING_NAMES_SIZE_MAX (16 * 1024)
 
 typedef enum {
     WorkerEvtStop = (1 << 0),
@@ -24,13 +26,28 @@ typedef enum {
     WorkerEvtFolderExit = (1 << 3),
     WorkerEvtFolderRefresh = (1 << 4),
     WorkerEvtConfigChange = (1 << 5),
+    WorkerEvtStorageChange = (1 << 6),
 } WorkerEvtFlags;
 
 #define WORKER_FLAGS_ALL                                                          \
     (WorkerEvtStop | WorkerEvtLoad | WorkerEvtFolderEnter | WorkerEvtFolderExit | \
-     WorkerEvtFolderRefresh | WorkerEvtConfigChange)
+     WorkerEvtFolderRefresh | WorkerEvtConfigChange | WorkerEvtStorageChange)
 
 ARRAY_DEF(idx_last_array, int32_t)
+ARRAY_DEF(listing_item_array, uint16_t)
+
+/** Filtered items of the current folder, pages are loaded without reading the folder again.
+ * Every item is stored in the names arena as a folder flag byte and a null-terminated name.
+ * Items that don't fit the arena are not cached, pages with them are read from the storage.
+ */
+typedef struct {
+    char* names;
+    size_t names_size;
+    size_t names_capacity;
+    listing_item_array_t items;
+    bool complete;
+    bool valid;
+} BrowserListing;
 
 struct BrowserWorker {
     FuriThread* thread;
@@ -42,14 +59,92 @@ struct BrowserWorker {
     uint32_t load_count;
     bool skip_assets;
     idx_last_array_t idx_last;
+    BrowserListing listing;
+    FuriPubSubSubscription* storage_sub;
+    FuriMutex* listing_mutex;
+    string_t listing_path; // Read by the storage callback, guarded by listing_mutex
 
     void* cb_ctx;
     BrowserWorkerFolderOpenCallback folder_cb;
+    BrowserWorkerFolderChangeCallback folder_change_cb;
     BrowserWorkerListLoadCallback list_load_cb;
     BrowserWorkerListItemCallback list_item_cb;
     BrowserWorkerLongLoadCallback long_load_cb;
 };
 
+static void browser_listing_reset(BrowserListing* listing) {
+    free(listing->names);
+    listing->names = NULL;
+    listing->names_size = 0;
+    listing->names_capacity = 0;
+    listing_item_array_reset(listing->items);
+    listing->complete = true;
+    listing->valid = false;
+}
+
+static void browser_listing_add(BrowserListing* listing, const char* name, bool is_folder) {
+    if(!listing->complete) return;
+
+    size_t item_size = strlen(name) + 2;
+    if(listing->names_size + item_size > LISTING_NAMES_SIZE_MAX) {
+        listing->complete = false;
+        return;
+    }
+    if(listing->names_size + item_size > listing->names_capacity) {
+        listing->names_capacity = MIN(
+            MAX(listing->names_capacity * 2, listing->names_size + item_size),
+            (size_t)LISTING_NAMES_SIZE_MAX);
+        listing->names = realloc(listing->names, listing->names_capacity);
+    }
+
+    listing_item_array_push_back(listing->items, listing->names_size);
+    listing->names[listing->names_size] = is_folder;
+    memcpy(&listing->names[listing->names_size + 1], name, item_size - 1);
+    listing->names_size += item_size;
+}
+
+static bool browser_storage_path_affects(const char* folder, const char* path) {
+    // Listing can be under /any, events come with /ext or /int. FAT on SD card ignores case.
+    folder += MIN(strlen(folder), strlen(BROWSER_ROOT));
+    path += MIN(strlen(path), strlen(BROWSER_ROOT));
+    size_t folder_len = strlen(folder);
+    size_t path_len = strlen(path);
+
+    // Item of the listed folder
+    const char* name = strrchr(path, '/');
+    size_t parent_len = name ? (size_t)(name - path) : 0;
+    if((parent_len == folder_len) && (strncasecmp(folder, path, parent_len) == 0)) {
+        return true;
+    }
+
+    // Listed folder itself or one of its parents
+    return (path_len <= folder_len) && (strncasecmp(folder, path, path_len) == 0) &&
+           ((folder[path_len] == '/') || (folder[path_len] == '\0'));
+}
+
+static void browser_storage_callback(const void* message, void* context) {
+    const StorageEvent* event = message;
+    BrowserWorker* browser = context;
+    bool changed = false;
+
+    // Folder closes don't change anything, the worker closes them itself
+    if((event->type == StorageEventTypeCardMount) ||
+       (event->type == StorageEventTypeCardUnmount)) {
+        changed = true;
+    } else if(
+        (event->type == StorageEventTypeFileClose) || (event->type == StorageEventTypeRemove) ||
+        (event->type == StorageEventTypeMkDir)) {
+        furi_check(furi_mutex_acquire(browser->listing_mutex, FuriWaitForever) == FuriStatusOk);
+        const char* folder = string_get_cstr(browser->listing_path);
+        changed = (folder[0] != '\0') && browser_storage_path_affects(folder, event->path);
+        furi_mutex_release(browser->listing_mutex);
+    }
+
+    if(changed) {
+        furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtStorageChange);
+    }
+}
+
 static bool browser_path_is_file(string_t path) {
     bool state = false;
     FileInfo file_info;
@@ -120,7 +215,8 @@ static bool browser_folder_init(
     string_t path,
     string_t filename,
     uint32_t* item_cnt,
-    int32_t* file_idx) {
+    int32_t* file_idx,
+    bool long_load_notify) {
     bool state = false;
     FileInfo file_info;
     uint32_t total_files_cnt = 0;
@@ -134,6 +230,10 @@ static bool browser_folder_init(
 
     *item_cnt = 0;
     *file_idx = -1;
+    browser_listing_reset(&browser->listing);
+    furi_check(furi_mutex_acquire(browser->listing_mutex, FuriWaitForever) == FuriStatusOk);
+    string_set(browser->listing_path, path);
+    furi_mutex_release(browser->listing_mutex);
 
     if(storage_dir_open(directory, string_get_cstr(path))) {
         state = true;
@@ -150,9 +250,11 @@ static bool browser_folder_init(
                             *file_idx = *item_cnt;
                         }
                     }
+                    browser_listing_add(
+                        &browser->listing, name_temp, (file_info.flags & FSF_DIRECTORY));
                     (*item_cnt)++;
                 }
-                if(total_files_cnt == LONG_LOAD_THRESHOLD) {
+                if(long_load_notify && (total_files_cnt == LONG_LOAD_THRESHOLD)) {
                     // There are too many files in folder and counting them will take some time - send callback to app
                     if(browser->long_load_cb) {
                         browser->long_load_cb(browser->cb_ctx);
@@ -169,11 +271,23 @@ static bool browser_folder_init(
 
     furi_record_close(RECORD_STORAGE);
 
+    browser->listing.valid = state;
+    if(!browser->listing.complete) {
+        FURI_LOG_D(
+            TAG,
+            "Listing cache full: %u of %lu items",
+            listing_item_array_size(browser->listing.items),
+            *item_cnt);
+    }
+
     return state;
 }
 
-static bool
-    browser_folder_load(BrowserWorker* browser, string_t path, uint32_t offset, uint32_t count) {
+static bool browser_folder_load_from_storage(
+    BrowserWorker* browser,
+    string_t path,
+    uint32_t offset,
+    uint32_t count) {
     FileInfo file_info;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -246,6 +360,54 @@ static bool
     return (items_cnt == count);
 }
 
+static bool
+    browser_folder_load(BrowserWorker* browser, string_t path, uint32_t offset, uint32_t count) {
+    BrowserListing* listing = &browser->listing;
+
+    if(!listing->valid) {
+        // Folder could be changed since it was listed
+        uint32_t item_cnt = 0;
+        int32_t file_idx = 0;
+        string_t filename;
+        string_init(filename);
+        browser_folder_init(browser, path, filename, &item_cnt, &file_idx, false);
+        string_clear(filename);
+    }
+
+    size_t cached_cnt = listing_item_array_size(listing->items);
+    if(!listing->valid || (!listing->complete && (offset + count > cached_cnt))) {
+        return browser_folder_load_from_storage(browser, path, offset, count);
+    }
+    if(offset > cached_cnt) {
+        return false;
+    }
+
+    if(browser->list_load_cb) {
+        browser->list_load_cb(browser->cb_ctx, offset);
+    }
+
+    string_t item_path;
+    string_init(item_path);
+
+    uint32_t items_cnt = 0;
+    while((items_cnt < count) && (offset + items_cnt < cached_cnt)) {
+        const char* item =
+            &listing->names[*listing_item_array_get(listing->items, offset + items_cnt)];
+        string_printf(item_path, "%s/%s", string_get_cstr(path), &item[1]);
+        if(browser->list_item_cb) {
+            browser->list_item_cb(browser->cb_ctx, item_path, item[0], false);
+        }
+        items_cnt++;
+    }
+    if(browser->list_item_cb) {
+        browser->list_item_cb(browser->cb_ctx, NULL, false, true);
+    }
+
+    string_clear(item_path);
+
+    return (items_cnt == count);
+}
+
 static int32_t browser_worker(void* context) {
     BrowserWorker* browser = (BrowserWorker*)context;
     furi_assert(browser);
@@ -266,6 +428,14 @@ static int32_t browser_worker(void* context) {
             furi_thread_flags_wait(WORKER_FLAGS_ALL, FuriFlagWaitAny, FuriWaitForever);
         furi_assert((flags & FuriFlagError) == 0);
 
+        if(flags & WorkerEvtStorageChange) {
+            browser->listing.valid = false;
+            // View asks for a refresh with its current selection
+            if(browser->folder_change_cb) {
+                browser->folder_change_cb(browser->cb_ctx);
+            }
+        }
+
         if(flags & WorkerEvtConfigChange) {
             // If start path is a path to the file - try finding index of this file in a folder
             if(browser_path_is_file(browser->path_next)) {
@@ -284,7 +454,7 @@ static int32_t browser_worker(void* context) {
             idx_last_array_push_back(browser->idx_last, browser->item_sel_idx);
 
             int32_t file_idx = 0;
-            browser_folder_init(browser, path, filename, &items_cnt, &file_idx);
+            browser_folder_init(browser, path, filename, &items_cnt, &file_idx, true);
             FURI_LOG_D(
                 TAG,
                 "Enter folder: %s items: %u idx: %d",
@@ -302,7 +472,7 @@ static int32_t browser_worker(void* context) {
             bool is_root = browser_folder_check_and_switch(path);
 
             int32_t file_idx = 0;
-            browser_folder_init(browser, path, filename, &items_cnt, &file_idx);
+            browser_folder_init(browser, path, filename, &items_cnt, &file_idx, true);
             if(idx_last_array_size(browser->idx_last) > 0) {
                 // Pop previous selected item index from history array
                 idx_last_array_pop_back(&file_idx, browser->idx_last);
@@ -319,15 +489,17 @@ static int32_t browser_worker(void* context) {
 
             int32_t file_idx = 0;
             string_reset(filename);
-            browser_folder_init(browser, path, filename, &items_cnt, &file_idx);
+            browser_folder_init(browser, path, filename, &items_cnt, &file_idx, true);
+            // Items could be removed since the selection was made
+            file_idx = MIN(browser->item_sel_idx, (int32_t)items_cnt - 1);
             FURI_LOG_D(
                 TAG,
                 "Refresh folder: %s items: %u idx: %d",
                 string_get_cstr(path),
                 items_cnt,
-                browser->item_sel_idx);
+                file_idx);
             if(browser->folder_cb) {
-                browser->folder_cb(browser->cb_ctx, items_cnt, browser->item_sel_idx, is_root);
+                browser->folder_cb(browser->cb_ctx, items_cnt, file_idx, is_root);
             }
         }
 
@@ -352,10 +524,15 @@ BrowserWorker* file_browser_worker_alloc(string_t path, const char* filter_ext,
     BrowserWorker* browser = malloc(sizeof(BrowserWorker));
 
     idx_last_array_init(browser->idx_last);
+    browser->listing.names = NULL;
+    listing_item_array_init(browser->listing.items);
+    browser_listing_reset(&browser->listing);
 
     string_init_set_str(browser->filter_extension, filter_ext);
     browser->skip_assets = skip_assets;
     string_init_set(browser->path_next, path);
+    browser->listing_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    string_init(browser->listing_path);
 
     browser->thread = furi_thread_alloc();
     furi_thread_set_name(browser->thread, "BrowserWorker");
@@ -364,20 +541,33 @@ BrowserWorker* file_browser_worker_alloc(string_t path, const char* filter_ext,
     furi_thread_set_callback(browser->thread, browser_worker);
     furi_thread_start(browser->thread);
 
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    browser->storage_sub =
+        furi_pubsub_subscribe(storage_get_pubsub(storage), browser_storage_callback, browser);
+    furi_record_close(RECORD_STORAGE);
+
     return browser;
 }
 
 void file_browser_worker_free(BrowserWorker* browser) {
     furi_assert(browser);
 
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    furi_pubsub_unsubscribe(storage_get_pubsub(storage), browser->storage_sub);
+    furi_record_close(RECORD_STORAGE);
+
     furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtStop);
     furi_thread_join(browser->thread);
     furi_thread_free(browser->thread);
 
     string_clear(browser->filter_extension);
     string_clear(browser->path_next);
+    string_clear(browser->listing_path);
+    furi_mutex_free(browser->listing_mutex);
 
     idx_last_array_clear(browser->idx_last);
+    browser_listing_reset(&browser->listing);
+    listing_item_array_clear(browser->listing.items);
 
     free(browser);
 }
@@ -394,6 +584,13 @@ void file_browser_worker_set_folder_callback(
     browser->folder_cb = cb;
 }
 
+void file_browser_worker_set_folder_change_callback(
+    BrowserWorker* browser,
+    BrowserWorkerFolderChangeCallback cb) {
+    furi_assert(browser);
+    browser->folder_change_cb = cb;
+}
+
 void file_browser_worker_set_list_callback(
     BrowserWorker* browser,
     BrowserWorkerListLoadCallback cb) {
@@ -14,6 +14,8 @@ typedef void (*BrowserWorkerFolderOpenCallback)(
     uint32_t item_cnt,
     int32_t file_idx,
     bool is_root);
+/** Listed folder was changed on storage, called from the worker thread */
+typedef void (*BrowserWorkerFolderChangeCallback)(void* context);
 typedef void (*BrowserWorkerListLoadCallback)(void* context, uint32_t list_load_offset);
 typedef void (*BrowserWorkerListItemCallback)(
     void* context,
@@ -32,6 +34,10 @@ void file_browser_worker_set_folder_callback(
     BrowserWorker* browser,
     BrowserWorkerFolderOpenCallback cb);
 
+void file_browser_worker_set_folder_change_callback(
+    BrowserWorker* browser,
+    BrowserWorkerFolderChangeCallback cb);
+
 void file_browser_worker_set_list_callback(
     BrowserWorker* browser,
     BrowserWorkerListLoadCallback cb);
@@ -2,14 +2,34 @@
 
 #include <stdlib.h>
 #include <m-dict.h>
+#include <m-array.h>
 #include <m-string.h>
 #include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/crc32_calc.h>
 
 #include "infrared_signal.h"
 
+#define TAG "InfraredBruteForce"
+
+/* Sidecar index: for every signal name - offsets right after its "name" value in db file */
+#define INFRARED_BRUTE_FORCE_INDEX_EXTENSION ".idx"
+#define INFRARED_BRUTE_FORCE_INDEX_MAGIC 0x58444952 // "RIDX"
+#define INFRARED_BRUTE_FORCE_INDEX_VERSION 2
+/* Storage has no modification time, whole db file checksum is used together with its size */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t db_size;
+    uint32_t db_crc;
+    uint32_t name_count;
+} InfraredBruteForceIndexHeader;
+
 typedef struct {
     uint32_t index;
     uint32_t count;
+    uint32_t index_offset;
 } InfraredBruteForceRecord;
 
 DICT_DEF2(
@@ -19,17 +39,32 @@ DICT_DEF2(
     InfraredBruteForceRecord,
     M_POD_OPLIST);
 
+ARRAY_DEF(InfraredBruteForceOffsetArray, uint32_t, M_POD_OPLIST);
+
+DICT_DEF2(
+    InfraredBruteForceOffsetDict,
+    string_t,
+    STRING_OPLIST,
+    InfraredBruteForceOffsetArray_t,
+    ARRAY_OPLIST(InfraredBruteForceOffsetArray, M_POD_OPLIST));
+
 struct InfraredBruteForce {
     FlipperFormat* ff;
     const char* db_filename;
     string_t current_record_name;
     InfraredBruteForceRecordDict_t records;
+    bool is_indexed;
+    uint32_t* offsets;
+    uint32_t offsets_count;
+    uint32_t offsets_sent;
 };
 
 InfraredBruteForce* infrared_brute_force_alloc() {
     InfraredBruteForce* brute_force = malloc(sizeof(InfraredBruteForce));
     brute_force->ff = NULL;
     brute_force->db_filename = NULL;
+    brute_force->is_indexed = false;
+    brute_force->offsets = NULL;
     string_init(brute_force->current_record_name);
     InfraredBruteForceRecordDict_init(brute_force->records);
     return brute_force;
@@ -46,8 +81,169 @@ void infrared_brute_force_set_db_filename(InfraredBruteForce* brute_force, const
     brute_force->db_filename = db_filename;
 }
 
-bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
-    furi_assert(brute_force->db_filename);
+static void infrared_brute_force_get_index_filename(
+    InfraredBruteForce* brute_force,
+    string_t index_filename) {
+    string_printf(
+        index_filename, "%s%s", brute_force->db_filename, INFRARED_BRUTE_FORCE_INDEX_EXTENSION);
+}
+
+static bool infrared_brute_force_get_db_stamp(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceIndexHeader* header) {
+    File* file = storage_file_alloc(storage);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(file, brute_force->db_filename, FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        header->magic = INFRARED_BRUTE_FORCE_INDEX_MAGIC;
+        header->version = INFRARED_BRUTE_FORCE_INDEX_VERSION;
+        header->db_size = storage_file_size(file);
+        // Any edit moves offsets of the following records, even if the size stays the same
+        header->db_crc = crc32_calc_file(file, NULL, NULL);
+        success = (storage_file_tell(file) == header->db_size);
+    } while(false);
+
+    storage_file_free(file);
+    return success;
+}
+
+/* Read name table, fill counts and offsets position for known records */
+static bool infrared_brute_force_load_index(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    const InfraredBruteForceIndexHeader* db_stamp) {
+    string_t index_filename;
+    string_init(index_filename);
+    infrared_brute_force_get_index_filename(brute_force, index_filename);
+
+    File* file = storage_file_alloc(storage);
+    string_t name;
+    string_init(name);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(
+               file, string_get_cstr(index_filename), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        InfraredBruteForceIndexHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != db_stamp->magic || header.version != db_stamp->version ||
+           header.db_size != db_stamp->db_size || header.db_crc != db_stamp->db_crc) {
+            FURI_LOG_I(TAG, "Index is outdated");
+            break;
+        }
+
+        uint32_t i = 0;
+        for(; i < header.name_count; ++i) {
+            uint8_t name_size;
+            char name_buf[UINT8_MAX + 1];
+            uint32_t count;
+            if(storage_file_read(file, &name_size, sizeof(name_size)) != sizeof(name_size)) break;
+            if(storage_file_read(file, name_buf, name_size) != name_size) break;
+            if(storage_file_read(file, &count, sizeof(count)) != sizeof(count)) break;
+            name_buf[name_size] = '\0';
+            string_set_str(name, name_buf);
+
+            uint32_t index_offset = storage_file_tell(file);
+            InfraredBruteForceRecord* record =
+                InfraredBruteForceRecordDict_get(brute_force->records, name);
+            if(record) {
+                record->count = count;
+                record->index_offset = index_offset;
+            }
+            if(!storage_file_seek(file, index_offset + count * sizeof(uint32_t), true)) break;
+        }
+
+        success = (i == header.name_count);
+    } while(false);
+
+    string_clear(name);
+    storage_file_free(file);
+    string_clear(index_filename);
+    return success;
+}
+
+/* One pass over db file, collect offsets of all signals and save them */
+static bool infrared_brute_force_build_index(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    InfraredBruteForceIndexHeader* header) {
+    InfraredBruteForceOffsetDict_t offsets;
+    InfraredBruteForceOffsetDict_init(offsets);
+    string_t signal_name;
+    string_init(signal_name);
+    bool success = false;
+
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    if(flipper_format_buffered_file_open_existing(ff, brute_force->db_filename)) {
+        Stream* stream = flipper_format_get_raw_stream(ff);
+        while(flipper_format_read_string(ff, "name", signal_name)) {
+            if(string_size(signal_name) > UINT8_MAX) continue;
+            InfraredBruteForceOffsetArray_push_back(
+                *InfraredBruteForceOffsetDict_safe_get(offsets, signal_name), stream_tell(stream));
+        }
+        success = true;
+    }
+    flipper_format_free(ff);
+
+    string_t index_filename;
+    string_init(index_filename);
+    infrared_brute_force_get_index_filename(brute_force, index_filename);
+    File* file = storage_file_alloc(storage);
+
+    if(success) {
+        success = false;
+        do {
+            if(!storage_file_open(
+                   file, string_get_cstr(index_filename), FSAM_WRITE, FSOM_CREATE_ALWAYS))
+                break;
+
+            header->name_count = InfraredBruteForceOffsetDict_size(offsets);
+            if(storage_file_write(file, header, sizeof(*header)) != sizeof(*header)) break;
+
+            bool write_error = false;
+            InfraredBruteForceOffsetDict_it_t it;
+            for(InfraredBruteForceOffsetDict_it(it, offsets);
+                !InfraredBruteForceOffsetDict_end_p(it) && !write_error;
+                InfraredBruteForceOffsetDict_next(it)) {
+                const InfraredBruteForceOffsetDict_itref_t* entry =
+                    InfraredBruteForceOffsetDict_cref(it);
+                uint8_t name_size = string_size(entry->key);
+                uint32_t count = InfraredBruteForceOffsetArray_size(entry->value);
+                size_t offsets_size = count * sizeof(uint32_t);
+
+                write_error =
+                    (storage_file_write(file, &name_size, sizeof(name_size)) !=
+                     sizeof(name_size)) ||
+                    (storage_file_write(file, string_get_cstr(entry->key), name_size) !=
+                     name_size) ||
+                    (storage_file_write(file, &count, sizeof(count)) != sizeof(count)) ||
+                    (storage_file_write(
+                         file, InfraredBruteForceOffsetArray_cget(entry->value, 0), offsets_size) !=
+                     offsets_size);
+            }
+            success = !write_error;
+        } while(false);
+        if(storage_file_is_open(file)) storage_file_close(file);
+
+        if(!success) {
+            FURI_LOG_E(TAG, "Unable to write index %s", string_get_cstr(index_filename));
+            storage_common_remove(storage, string_get_cstr(index_filename));
+        }
+    }
+
+    storage_file_free(file);
+    string_clear(index_filename);
+    string_clear(signal_name);
+    InfraredBruteForceOffsetDict_clear(offsets);
+    return success;
+}
+
+static bool infrared_brute_force_calculate_messages_linear(InfraredBruteForce* brute_force) {
     bool success = false;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -72,12 +268,71 @@ bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
     return success;
 }
 
+bool infrared_brute_force_calculate_messages(InfraredBruteForce* brute_force) {
+    furi_assert(brute_force->db_filename);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    InfraredBruteForceIndexHeader header;
+
+    brute_force->is_indexed = infrared_brute_force_get_db_stamp(brute_force, storage, &header);
+    if(brute_force->is_indexed &&
+       !infrared_brute_force_load_index(brute_force, storage, &header)) {
+        brute_force->is_indexed =
+            infrared_brute_force_build_index(brute_force, storage, &header) &&
+            infrared_brute_force_load_index(brute_force, storage, &header);
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    if(brute_force->is_indexed) {
+        return true;
+    }
+
+    FURI_LOG_W(TAG, "Index unavailable, scanning %s", brute_force->db_filename);
+    InfraredBruteForceRecordDict_it_t it;
+    for(InfraredBruteForceRecordDict_it(it, brute_force->records);
+        !InfraredBruteForceRecordDict_end_p(it);
+        InfraredBruteForceRecordDict_next(it)) {
+        InfraredBruteForceRecordDict_ref(it)->value.count = 0;
+    }
+    return infrared_brute_force_calculate_messages_linear(brute_force);
+}
+
+static bool infrared_brute_force_load_offsets(
+    InfraredBruteForce* brute_force,
+    Storage* storage,
+    const InfraredBruteForceRecord* record) {
+    string_t index_filename;
+    string_init(index_filename);
+    infrared_brute_force_get_index_filename(brute_force, index_filename);
+
+    File* file = storage_file_alloc(storage);
+    size_t offsets_size = record->count * sizeof(uint32_t);
+    brute_force->offsets = malloc(offsets_size);
+    brute_force->offsets_count = record->count;
+    brute_force->offsets_sent = 0;
+
+    bool success =
+        storage_file_open(file, string_get_cstr(index_filename), FSAM_READ, FSOM_OPEN_EXISTING) &&
+        storage_file_seek(file, record->index_offset, true) &&
+        (storage_file_read(file, brute_force->offsets, offsets_size) == offsets_size);
+
+    if(!success) {
+        free(brute_force->offsets);
+        brute_force->offsets = NULL;
+    }
+
+    storage_file_free(file);
+    string_clear(index_filename);
+    return success;
+}
+
 bool infrared_brute_force_start(
     InfraredBruteForce* brute_force,
     uint32_t index,
     uint32_t* record_count) {
     bool success = false;
     *record_count = 0;
+    const InfraredBruteForceRecord* current_record = NULL;
 
     InfraredBruteForceRecordDict_it_t it;
     for(InfraredBruteForceRecordDict_it(it, brute_force->records);
@@ -88,6 +343,7 @@ bool infrared_brute_force_start(
             *record_count = record->value.count;
             if(*record_count) {
                 string_set(brute_force->current_record_name, record->key);
+                current_record = &record->value;
             }
             break;
         }
@@ -98,6 +354,9 @@ bool infrared_brute_force_start(
         brute_force->ff = flipper_format_buffered_file_alloc(storage);
         success =
             flipper_format_buffered_file_open_existing(brute_force->ff, brute_force->db_filename);
+        if(success && brute_force->is_indexed) {
+            success = infrared_brute_force_load_offsets(brute_force, storage, current_record);
+        }
         if(!success) {
             flipper_format_free(brute_force->ff);
             brute_force->ff = NULL;
@@ -119,6 +378,10 @@ void infrared_brute_force_stop(InfraredBruteForce* brute_force) {
     flipper_format_free(brute_force->ff);
     furi_record_close(RECORD_STORAGE);
     brute_force->ff = NULL;
+    if(brute_force->offsets) {
+        free(brute_force->offsets);
+        brute_force->offsets = NULL;
+    }
 }
 
 bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
@@ -130,9 +393,21 @@ bool infrared_brute_force_send_next(InfraredBruteForce* brute_force) {
     string_init(signal_name);
     InfraredSignal* signal = infrared_signal_alloc();
 
-    do {
-        success = infrared_signal_read(signal, brute_force->ff, signal_name);
-    } while(success && !string_equal_p(brute_force->current_record_name, signal_name));
+    if(brute_force->offsets) {
+        // Seek right to the signal body, no need to skip the others
+        if(brute_force->offsets_sent < brute_force->offsets_count) {
+            Stream* stream = flipper_format_get_raw_stream(brute_force->ff);
+            success = stream_seek(
+                          stream,
+                          brute_force->offsets[brute_force->offsets_sent++],
+                          StreamOffsetFromStart) &&
+                      infrared_signal_read_body(signal, brute_force->ff);
+        }
+    } else {
+        do {
+            success = infrared_signal_read(signal, brute_force->ff, signal_name);
+        } while(success && !string_equal_p(brute_force->current_record_name, signal_name));
+    }
 
     if(success) {
         infrared_signal_transmit(signal);
@@ -147,7 +422,7 @@ void infrared_brute_force_add_record(
     InfraredBruteForce* brute_force,
     uint32_t index,
     const char* name) {
-    InfraredBruteForceRecord value = {.index = index, .count = 0};
+    InfraredBruteForceRecord value = {.index = index, .count = 0, .index_offset = 0};
     string_t key;
     string_init_set_str(key, name);
     InfraredBruteForceRecordDict_set_at(brute_force->records, key, value);
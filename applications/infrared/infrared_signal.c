@@ -234,6 +234,19 @@ bool infrared_signal_read(InfraredSignal* signal, FlipperFormat* ff, string_t na
     do {
         if(!flipper_format_read_string(ff, "name", buf)) break;
         string_set(name, buf);
+        success = infrared_signal_read_body(signal, ff);
+    } while(0);
+
+    string_clear(buf);
+    return success;
+}
+
+bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff) {
+    string_t buf;
+    string_init(buf);
+    bool success = false;
+
+    do {
         if(!flipper_format_read_string(ff, "type", buf)) break;
         if(!string_cmp_str(buf, "raw")) {
             success = infrared_signal_read_raw(signal, ff);
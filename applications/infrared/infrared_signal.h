@@ -37,5 +37,6 @@ InfraredMessage* infrared_signal_get_message(InfraredSignal* signal);
 
 bool infrared_signal_save(InfraredSignal* signal, FlipperFormat* ff, const char* name);
 bool infrared_signal_read(InfraredSignal* signal, FlipperFormat* ff, string_t name);
+bool infrared_signal_read_body(InfraredSignal* signal, FlipperFormat* ff);
 
 void infrared_signal_transmit(InfraredSignal* signal);
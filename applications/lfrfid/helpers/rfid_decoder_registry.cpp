@@ -0,0 +1,67 @@
+#include "rfid_decoder_registry.h"
+#include "decoder_emmarin.h"
+#include "decoder_hid26.h"
+#include "decoder_indala.h"
+#include "decoder_ioprox.h"
+#include <furi.h>
+
+template <class T> static void* rfid_decoder_alloc() {
+    return new T();
+}
+
+template <class T> static void rfid_decoder_free(void* decoder) {
+    delete static_cast<T*>(decoder);
+}
+
+template <class T> static void rfid_decoder_feed(void* decoder, bool polarity, uint32_t time) {
+    static_cast<T*>(decoder)->process_front(polarity, time);
+}
+
+template <class T>
+static bool rfid_decoder_read(void* decoder, uint8_t* data, uint8_t data_size) {
+    return static_cast<T*>(decoder)->read(data, data_size);
+}
+
+template <class T>
+static constexpr RfidDecoderProtocol rfid_decoder_protocol(LfrfidKeyType type, uint8_t modes) {
+    return {
+        type,
+        modes,
+        rfid_decoder_alloc<T>,
+        rfid_decoder_free<T>,
+        rfid_decoder_feed<T>,
+        rfid_decoder_read<T>,
+    };
+}
+
+// Reader polls decoders in this order, the last one that decoded a key wins
+static const RfidDecoderProtocol rfid_decoder_registry[] = {
+    rfid_decoder_protocol<DecoderEMMarin>(
+        LfrfidKeyType::KeyEM4100, RfidDecoderModeNormal | RfidDecoderModeIndala),
+    rfid_decoder_protocol<DecoderHID26>(
+        LfrfidKeyType::KeyH10301, RfidDecoderModeNormal | RfidDecoderModeIndala),
+    rfid_decoder_protocol<DecoderIoProx>(
+        LfrfidKeyType::KeyIoProxXSF, RfidDecoderModeNormal | RfidDecoderModeIndala),
+    rfid_decoder_protocol<DecoderIndala>(LfrfidKeyType::KeyI40134, RfidDecoderModeIndala),
+};
+
+const RfidDecoderProtocol* rfid_decoder_registry_get_by_type(LfrfidKeyType type) {
+    for(size_t i = 0; i < rfid_decoder_registry_count(); i++) {
+        if(rfid_decoder_registry[i].type == type) {
+            return &rfid_decoder_registry[i];
+        }
+    }
+    return nullptr;
+}
+
+const RfidDecoderProtocol* rfid_decoder_registry_get_by_index(size_t index) {
+    if(index < rfid_decoder_registry_count()) {
+        return &rfid_decoder_registry[index];
+    } else {
+        return nullptr;
+    }
+}
+
+size_t rfid_decoder_registry_count() {
+    return COUNT_OF(rfid_decoder_registry);
+}
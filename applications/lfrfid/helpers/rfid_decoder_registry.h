@@ -0,0 +1,61 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "key_info.h"
+
+/** Reader carrier configurations, each decoder runs in a set of them */
+enum RfidDecoderMode : uint8_t {
+    RfidDecoderModeNormal = (1 << 0), /**< 125 kHz carrier, 50% duty */
+    RfidDecoderModeIndala = (1 << 1), /**< 62.5 kHz carrier, 25% duty */
+};
+
+typedef void* (*RfidDecoderAlloc)();
+typedef void (*RfidDecoderFree)(void* decoder);
+
+/**
+ * @brief Process comparator edge
+ *
+ * @param polarity edge polarity
+ * @param time time since previous edge, in 64 MHz clocks
+ */
+typedef void (*RfidDecoderFeed)(void* decoder, bool polarity, uint32_t time);
+
+/**
+ * @brief Get decoded key data, decoder continues to search for the next key
+ *
+ * @return true if key is decoded
+ */
+typedef bool (*RfidDecoderRead)(void* decoder, uint8_t* data, uint8_t data_size);
+
+struct RfidDecoderProtocol {
+    LfrfidKeyType type;
+    uint8_t modes;
+
+    RfidDecoderAlloc alloc;
+    RfidDecoderFree free;
+    RfidDecoderFeed feed;
+    RfidDecoderRead read;
+};
+
+/**
+ * @brief Get decoder protocol by key type
+ *
+ * @param type key type
+ * @return RfidDecoderProtocol* or nullptr if key type can't be read
+ */
+const RfidDecoderProtocol* rfid_decoder_registry_get_by_type(LfrfidKeyType type);
+
+/**
+ * @brief Get decoder protocol by index
+ *
+ * @param index protocol index
+ * @return RfidDecoderProtocol* or nullptr if index is out of range
+ */
+const RfidDecoderProtocol* rfid_decoder_registry_get_by_index(size_t index);
+
+/**
+ * @brief Get number of registered decoder protocols
+ *
+ * @return size_t protocol count
+ */
+size_t rfid_decoder_registry_count();
@@ -0,0 +1,54 @@
+#include "rfid_edge_buffer.h"
+
+static_assert((RfidEdgeBuffer::size & (RfidEdgeBuffer::size - 1)) == 0, "size is not power of 2");
+
+// head and tail run freely, only producer writes head and only consumer writes tail
+bool RfidEdgeBuffer::push(bool polarity, uint32_t time) {
+    size_t current_head = head.load(std::memory_order_relaxed);
+
+    if(current_head - tail.load(std::memory_order_acquire) >= size) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if(time >= polarity_bit) {
+        time = polarity_bit - 1;
+    }
+
+    edges[current_head & (size - 1)] = time | (polarity ? polarity_bit : 0);
+    head.store(current_head + 1, std::memory_order_release);
+    return true;
+}
+
+bool RfidEdgeBuffer::pop(bool* polarity, uint32_t* time) {
+    size_t current_tail = tail.load(std::memory_order_relaxed);
+
+    if(current_tail == head.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    uint32_t edge = edges[current_tail & (size - 1)];
+    tail.store(current_tail + 1, std::memory_order_release);
+
+    *polarity = edge & polarity_bit;
+    *time = edge & ~polarity_bit;
+    return true;
+}
+
+size_t RfidEdgeBuffer::get_count() {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+}
+
+uint32_t RfidEdgeBuffer::get_dropped() {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+void RfidEdgeBuffer::reset() {
+    head = 0;
+    tail = 0;
+    dropped = 0;
+}
+
+RfidEdgeBuffer::RfidEdgeBuffer() {
+    reset();
+}
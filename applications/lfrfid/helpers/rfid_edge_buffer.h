@@ -0,0 +1,57 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * Lock-free single producer, single consumer ring of comparator edges.
+ * Producer is the comparator interrupt, consumer is the decoding thread.
+ */
+class RfidEdgeBuffer {
+public:
+    /** Buffer capacity in edges, power of two */
+    static const size_t size = 512;
+
+    /**
+     * @brief Push edge, producer side
+     *
+     * @param polarity edge polarity
+     * @param time time since previous edge, in 64 MHz clocks, saturated to 31 bits
+     * @return false if buffer is full and edge is dropped
+     */
+    bool push(bool polarity, uint32_t time);
+
+    /**
+     * @brief Pop edge, consumer side
+     *
+     * @param polarity edge polarity
+     * @param time time since previous edge, in 64 MHz clocks
+     * @return false if buffer is empty
+     */
+    bool pop(bool* polarity, uint32_t* time);
+
+    /**
+     * @brief Get number of edges in buffer
+     */
+    size_t get_count();
+
+    /**
+     * @brief Get number of edges dropped because buffer was full since last reset
+     */
+    uint32_t get_dropped();
+
+    /**
+     * @brief Empty buffer, producer must be stopped
+     */
+    void reset();
+
+    RfidEdgeBuffer();
+
+private:
+    static const uint32_t polarity_bit = 1UL << 31;
+
+    uint32_t edges[size];
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic<uint32_t> dropped;
+};
@@ -3,16 +3,26 @@
 #include <furi_hal.h>
 #include <stm32wbxx_ll_cortex.h>
 
+#define TAG "RfidReader"
+
+// decoding thread also wakes up by itself to keep read latency low on slow edge rates
+constexpr uint32_t decode_period_ms = 10;
+
+enum RfidReaderFlag {
+    RfidReaderFlagEdges = (1 << 0),
+    RfidReaderFlagStop = (1 << 1),
+};
+
 /**
  * @brief private violation assistant for RfidReader
  */
 struct RfidReaderAccessor {
-    static void decode(RfidReader& rfid_reader, bool polarity) {
-        rfid_reader.decode(polarity);
+    static void capture(RfidReader& rfid_reader, bool polarity) {
+        rfid_reader.capture(polarity);
     }
 };
 
-void RfidReader::decode(bool polarity) {
+void RfidReader::capture(bool polarity) {
     uint32_t current_dwt_value = DWT->CYCCNT;
     uint32_t period = current_dwt_value - last_dwt_value;
     last_dwt_value = current_dwt_value;
@@ -21,21 +31,42 @@ void RfidReader::decode(bool polarity) {
     decoder_gpio_out.process_front(polarity, period);
 #endif
 
-    switch(type) {
-    case Type::Normal:
-        decoder_em.process_front(polarity, period);
-        decoder_hid26.process_front(polarity, period);
-        decoder_ioprox.process_front(polarity, period);
-        break;
-    case Type::Indala:
-        decoder_em.process_front(polarity, period);
-        decoder_hid26.process_front(polarity, period);
-        decoder_ioprox.process_front(polarity, period);
-        decoder_indala.process_front(polarity, period);
-        break;
+    // wake decoding thread once per half buffer
+    if(edges->push(polarity, period) && edges->get_count() == RfidEdgeBuffer::size / 2) {
+        furi_thread_flags_set(furi_thread_get_id(thread), RfidReaderFlagEdges);
     }
+}
+
+int32_t RfidReader::decode_thread(void* context) {
+    RfidReader* _this = static_cast<RfidReader*>(context);
 
-    detect_ticks++;
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            RfidReaderFlagEdges | RfidReaderFlagStop, FuriFlagWaitAny, decode_period_ms);
+        if(!(flags & FuriFlagError) && (flags & RfidReaderFlagStop)) break;
+
+        _this->decode();
+    }
+
+    return 0;
+}
+
+void RfidReader::decode() {
+    const uint8_t modes = (type == Type::Normal) ? RfidDecoderModeNormal :
+                                                   RfidDecoderModeIndala;
+    bool polarity;
+    uint32_t period;
+
+    while(edges->pop(&polarity, &period)) {
+        for(size_t i = 0; i < rfid_decoder_registry_count(); i++) {
+            const RfidDecoderProtocol* protocol = rfid_decoder_registry_get_by_index(i);
+            if(protocol->modes & modes) {
+                protocol->feed(decoders[i], polarity, period);
+            }
+        }
+
+        detect_ticks++;
+    }
 }
 
 bool RfidReader::switch_timer_elapsed() {
@@ -65,15 +96,44 @@ void RfidReader::switch_mode() {
 static void comparator_trigger_callback(bool level, void* comp_ctx) {
     RfidReader* _this = static_cast<RfidReader*>(comp_ctx);
 
-    RfidReaderAccessor::decode(*_this, !level);
+    RfidReaderAccessor::capture(*_this, !level);
 }
 
 RfidReader::RfidReader() {
+    decoders = new void*[rfid_decoder_registry_count()];
+    for(size_t i = 0; i < rfid_decoder_registry_count(); i++) {
+        decoders[i] = rfid_decoder_registry_get_by_index(i)->alloc();
+    }
+
+    edges = new RfidEdgeBuffer();
+    detect_ticks = 0;
+
+    thread = furi_thread_alloc();
+    furi_thread_set_name(thread, "RfidReaderWorker");
+    furi_thread_set_stack_size(thread, 1024);
+    furi_thread_set_context(thread, this);
+    furi_thread_set_callback(thread, RfidReader::decode_thread);
+}
+
+RfidReader::~RfidReader() {
+    stop();
+    furi_thread_free(thread);
+    delete edges;
+
+    for(size_t i = 0; i < rfid_decoder_registry_count(); i++) {
+        rfid_decoder_registry_get_by_index(i)->free(decoders[i]);
+    }
+    delete[] decoders;
 }
 
 void RfidReader::start() {
     type = Type::Normal;
 
+    if(furi_thread_get_state(thread) == FuriThreadStateStopped) {
+        edges->reset();
+        furi_thread_start(thread);
+    }
+
     furi_hal_rfid_pins_read();
     furi_hal_rfid_tim_read(125000, 0.5);
     furi_hal_rfid_tim_read_start();
@@ -95,6 +155,15 @@ void RfidReader::stop() {
     furi_hal_rfid_tim_read_stop();
     furi_hal_rfid_tim_reset();
     stop_comparator();
+
+    if(furi_thread_get_state(thread) != FuriThreadStateStopped) {
+        furi_thread_flags_set(furi_thread_get_id(thread), RfidReaderFlagStop);
+        furi_thread_join(thread);
+
+        if(edges->get_dropped() > 0) {
+            FURI_LOG_W(TAG, "%lu edges dropped", edges->get_dropped());
+        }
+    }
 }
 
 bool RfidReader::read(LfrfidKeyType* _type, uint8_t* data, uint8_t data_size, bool switch_enable) {
@@ -102,24 +171,12 @@ bool RfidReader::read(LfrfidKeyType* _type, uint8_t* data, uint8_t data_size, bo
     bool something_read = false;
 
     // reading
-    if(decoder_em.read(data, data_size)) {
-        *_type = LfrfidKeyType::KeyEM4100;
-        something_read = true;
-    }
-
-    if(decoder_hid26.read(data, data_size)) {
-        *_type = LfrfidKeyType::KeyH10301;
-        something_read = true;
-    }
-
-    if(decoder_ioprox.read(data, data_size)) {
-        *_type = LfrfidKeyType::KeyIoProxXSF;
-        something_read = true;
-    }
-
-    if(decoder_indala.read(data, data_size)) {
-        *_type = LfrfidKeyType::KeyI40134;
-        something_read = true;
+    for(size_t i = 0; i < rfid_decoder_registry_count(); i++) {
+        const RfidDecoderProtocol* protocol = rfid_decoder_registry_get_by_index(i);
+        if(protocol->read(decoders[i], data, data_size)) {
+            *_type = protocol->type;
+            something_read = true;
+        }
     }
 
     // validation
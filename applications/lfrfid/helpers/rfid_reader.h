@@ -1,10 +1,10 @@
 #pragma once
+#include <furi.h>
+#include <atomic>
 //#include "decoder_analyzer.h"
 #include "decoder_gpio_out.h"
-#include "decoder_emmarin.h"
-#include "decoder_hid26.h"
-#include "decoder_indala.h"
-#include "decoder_ioprox.h"
+#include "rfid_decoder_registry.h"
+#include "rfid_edge_buffer.h"
 #include "key_info.h"
 
 //#define RFID_GPIO_DEBUG 1
@@ -17,6 +17,7 @@ public:
     };
 
     RfidReader();
+    ~RfidReader();
     void start();
     void start_forced(RfidReader::Type type);
     void stop();
@@ -32,19 +33,23 @@ private:
 #ifdef RFID_GPIO_DEBUG
     DecoderGpioOut decoder_gpio_out;
 #endif
-    DecoderEMMarin decoder_em;
-    DecoderHID26 decoder_hid26;
-    DecoderIndala decoder_indala;
-    DecoderIoProx decoder_ioprox;
+    // decoder instances, in rfid_decoder_registry order
+    void** decoders;
+
+    // comparator interrupt captures edges, decoding thread runs decoders
+    RfidEdgeBuffer* edges;
+    FuriThread* thread;
 
     uint32_t last_dwt_value;
 
     void start_comparator(void);
     void stop_comparator(void);
 
-    void decode(bool polarity);
+    void capture(bool polarity);
+    static int32_t decode_thread(void* context);
+    void decode();
 
-    uint32_t detect_ticks;
+    std::atomic<uint32_t> detect_ticks;
 
     uint32_t switch_os_tick_last;
     bool switch_timer_elapsed();
@@ -55,5 +60,5 @@ private:
     uint8_t last_read_data[LFRFID_KEY_SIZE];
     uint8_t last_read_count;
 
-    Type type = Type::Normal;
+    std::atomic<Type> type{Type::Normal};
 };
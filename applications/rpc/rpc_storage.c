@@ -9,7 +9,6 @@
 #include "storage/filesystem_api_defines.h"
 #include "storage/storage.h"
 #include <stdint.h>
-#include <lib/toolbox/md5.h>
 #include <lib/toolbox/path.h>
 #include <update_util/lfs_backup.h>
 
@@ -18,6 +17,9 @@
 #define MAX_NAME_LENGTH 255
 
 static const size_t MAX_DATA_SIZE = 512;
+/* Storage is read and written by windows of several frames,
+ * each storage call costs a round trip to the storage thread */
+#define RPC_STORAGE_WINDOW_FRAMES 8
 
 typedef enum {
     RpcStorageStateIdle = 0,
@@ -30,8 +32,21 @@ typedef struct {
     File* file;
     RpcStorageState state;
     uint32_t current_command_id;
+    uint8_t* write_window;
+    size_t write_window_size;
 } RpcStorageSystem;
 
+static bool rpc_system_storage_write_flush(RpcStorageSystem* rpc_storage) {
+    bool success = true;
+    if(rpc_storage->write_window_size) {
+        uint16_t written_size = storage_file_write(
+            rpc_storage->file, rpc_storage->write_window, rpc_storage->write_window_size);
+        success = (written_size == rpc_storage->write_window_size);
+        rpc_storage->write_window_size = 0;
+    }
+    return success;
+}
+
 static void rpc_system_storage_reset_state(
     RpcStorageSystem* rpc_storage,
     RpcSession* session,
@@ -47,6 +62,9 @@ static void rpc_system_storage_reset_state(
         }
 
         if(rpc_storage->state == RpcStorageStateWriting) {
+            rpc_system_storage_write_flush(rpc_storage);
+            free(rpc_storage->write_window);
+            rpc_storage->write_window = NULL;
             storage_file_close(rpc_storage->file);
             storage_file_free(rpc_storage->file);
             furi_record_close(RECORD_STORAGE);
@@ -292,7 +310,7 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
-    /* use same message memory to send reponse */
+    /* use same message and data memory to send all responses */
     PB_Main* response = malloc(sizeof(PB_Main));
     const char* path = request->content.storage_read_request.path;
     Storage* fs_api = furi_record_open(RECORD_STORAGE);
@@ -301,37 +319,41 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
     if(fs_operation_success) {
         size_t size_left = storage_file_size(file);
+        uint8_t* window = malloc(MAX_DATA_SIZE * RPC_STORAGE_WINDOW_FRAMES);
+        size_t window_size = 0;
+        size_t window_offset = 0;
+
+        response->command_id = request->command_id;
+        response->which_content = PB_Main_storage_read_response_tag;
+        response->command_status = PB_CommandStatus_OK;
+        response->content.storage_read_response.has_file = true;
+        response->content.storage_read_response.file.data =
+            malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MAX_DATA_SIZE));
+        pb_bytes_array_t* data = response->content.storage_read_response.file.data;
+
         do {
-            response->command_id = request->command_id;
-            response->which_content = PB_Main_storage_read_response_tag;
-            response->command_status = PB_CommandStatus_OK;
-
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
-            if(read_size) {
-                response->content.storage_read_response.has_file = true;
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_size));
-                uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
-                uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-
-                *read_size_msg = storage_file_read(file, buffer, read_size);
-                size_left -= *read_size_msg;
-                fs_operation_success = (*read_size_msg == read_size);
-
-                response->has_next = fs_operation_success && (size_left > 0);
-            } else {
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(0));
-                response->content.storage_read_response.file.data->size = 0;
-                response->content.storage_read_response.has_file = true;
-                response->has_next = false;
-                fs_operation_success = true;
+            if(window_offset == window_size) {
+                // read several frames at once, then send them one by one
+                window_size = MIN(size_left, MAX_DATA_SIZE * RPC_STORAGE_WINDOW_FRAMES);
+                window_offset = 0;
+                if(window_size) {
+                    fs_operation_success =
+                        (storage_file_read(file, window, window_size) == window_size);
+                    if(!fs_operation_success) break;
+                }
             }
 
-            if(fs_operation_success) {
-                rpc_send_and_release(session, response);
-            }
-        } while((size_left != 0) && fs_operation_success);
+            data->size = MIN(window_size - window_offset, MAX_DATA_SIZE);
+            memcpy(data->bytes, &window[window_offset], data->size);
+            window_offset += data->size;
+            size_left -= data->size;
+
+            response->has_next = (size_left > 0);
+            rpc_send(session, response);
+        } while(size_left != 0);
+
+        free(window);
+        pb_release(&PB_Main_msg, response);
     }
 
     if(!fs_operation_success) {
@@ -377,6 +399,9 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
         rpc_storage->file = storage_file_alloc(rpc_storage->api);
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
+        // Only sessions that write files pay for the window
+        rpc_storage->write_window = malloc(MAX_DATA_SIZE * RPC_STORAGE_WINDOW_FRAMES);
+        rpc_storage->write_window_size = 0;
         const char* path = request->content.storage_write_request.path;
         fs_operation_success =
             storage_file_open(rpc_storage->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
@@ -391,8 +416,28 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
            request->content.storage_write_request.file.data->size) {
             uint8_t* buffer = request->content.storage_write_request.file.data->bytes;
             size_t buffer_size = request->content.storage_write_request.file.data->size;
-            uint16_t written_size = storage_file_write(file, buffer, buffer_size);
-            fs_operation_success = (written_size == buffer_size);
+            const size_t window_capacity = MAX_DATA_SIZE * RPC_STORAGE_WINDOW_FRAMES;
+
+            // collect frames and write them at once
+            if(rpc_storage->write_window_size + buffer_size > window_capacity) {
+                fs_operation_success = rpc_system_storage_write_flush(rpc_storage);
+            }
+            if(fs_operation_success) {
+                if(buffer_size > window_capacity) {
+                    uint16_t written_size = storage_file_write(file, buffer, buffer_size);
+                    fs_operation_success = (written_size == buffer_size);
+                } else {
+                    memcpy(
+                        &rpc_storage->write_window[rpc_storage->write_window_size],
+                        buffer,
+                        buffer_size);
+                    rpc_storage->write_window_size += buffer_size;
+                }
+            }
+        }
+
+        if(fs_operation_success && !request->has_next) {
+            fs_operation_success = rpc_system_storage_write_flush(rpc_storage);
         }
 
         send_response = !request->has_next;
@@ -525,24 +570,11 @@ static void rpc_system_storage_md5sum_process(const PB_Main* request, void* cont
     }
 
     Storage* fs_api = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(fs_api);
-
-    if(storage_file_open(file, filename, FSAM_READ, FSOM_OPEN_EXISTING)) {
-        const uint16_t size_to_read = 512;
-        const uint8_t hash_size = 16;
-        uint8_t* data = malloc(size_to_read);
-        uint8_t* hash = malloc(sizeof(uint8_t) * hash_size);
-        md5_context* md5_ctx = malloc(sizeof(md5_context));
-
-        md5_starts(md5_ctx);
-        while(true) {
-            uint16_t read_size = storage_file_read(file, data, size_to_read);
-            if(read_size == 0) break;
-            md5_update(md5_ctx, data, read_size);
-        }
-        md5_finish(md5_ctx, hash);
-        free(md5_ctx);
+    const size_t hash_size = storage_digest_get_size(StorageDigestTypeMd5);
+    uint8_t hash[STORAGE_DIGEST_MAX_SIZE];
 
+    FS_Error error = storage_common_digest(fs_api, filename, StorageDigestTypeMd5, hash);
+    if(error == FSE_OK) {
         PB_Main response = {
             .command_id = request->command_id,
             .command_status = PB_CommandStatus_OK,
@@ -554,21 +586,16 @@ static void rpc_system_storage_md5sum_process(const PB_Main* request, void* cont
         size_t md5sum_size = sizeof(response.content.storage_md5sum_response.md5sum);
         (void)md5sum_size;
         furi_assert(hash_size <= ((md5sum_size - 1) / 2));
-        for(uint8_t i = 0; i < hash_size; i++) {
+        for(size_t i = 0; i < hash_size; i++) {
             md5sum += snprintf(md5sum, md5sum_size, "%02x", hash[i]);
         }
 
-        free(hash);
-        free(data);
-        storage_file_close(file);
         rpc_send_and_release(session, &response);
     } else {
         rpc_send_and_release_empty(
-            session, request->command_id, rpc_system_storage_get_file_error(file));
+            session, request->command_id, rpc_system_storage_get_error(error));
     }
 
-    storage_file_free(file);
-
     furi_record_close(RECORD_STORAGE);
 }
 
@@ -651,6 +678,8 @@ void* rpc_system_storage_alloc(RpcSession* session) {
     rpc_storage->api = furi_record_open(RECORD_STORAGE);
     rpc_storage->session = session;
     rpc_storage->state = RpcStorageStateIdle;
+    rpc_storage->write_window = NULL;
+    rpc_storage->write_window_size = 0;
 
     RpcHandler rpc_handler = {
         .message_handler = NULL,
@@ -35,12 +35,23 @@ typedef enum {
     StorageEventTypeCardMountError,
     StorageEventTypeFileClose,
     StorageEventTypeDirClose,
+    StorageEventTypeRemove,
+    StorageEventTypeMkDir,
 } StorageEventType;
 
 typedef struct {
     StorageEventType type;
+    /** Real path (/ext or /int) for FileClose, Remove and MkDir, valid during the callback only */
+    const char* path;
 } StorageEvent;
 
+typedef enum {
+    StorageDigestTypeMd5,
+    StorageDigestTypeSha256,
+} StorageDigestType;
+
+#define STORAGE_DIGEST_MAX_SIZE 32
+
 /**
  * Get storage pubsub.
  * Storage will send StorageEvent messages.
@@ -228,6 +239,27 @@ FS_Error storage_common_fs_info(
     uint64_t* total_space,
     uint64_t* free_space);
 
+/** Calculates a digest of the file contents.
+ * The storage service caches digests of files that were not changed since the last call,
+ * the file is read again only after it was opened for writing, removed or changed in size.
+ * @param app pointer to the api
+ * @param path path to file
+ * @param type digest algorithm
+ * @param digest pointer to the digest, storage_digest_get_size(type) bytes, will be filled
+ * @return FS_Error operation result
+ */
+FS_Error storage_common_digest(
+    Storage* storage,
+    const char* path,
+    StorageDigestType type,
+    uint8_t* digest);
+
+/** Gets the digest size in bytes
+ * @param type digest algorithm
+ * @return size_t digest size
+ */
+size_t storage_digest_get_size(StorageDigestType type);
+
 /******************* Error Functions *******************/
 
 /** Retrieves the error text from the error id
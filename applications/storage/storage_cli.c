@@ -3,7 +3,6 @@
 
 #include <cli/cli.h>
 #include <lib/toolbox/args.h>
-#include <lib/toolbox/md5.h>
 #include <lib/toolbox/dir_walk.h>
 #include <storage/storage.h>
 #include <storage/storage_sd_api.h>
@@ -31,6 +30,7 @@ static void storage_cli_print_usage() {
     printf("\trename\t - move file to new file, <args> must contain new path\r\n");
     printf("\tmkdir\t - creates a new directory\r\n");
     printf("\tmd5\t - md5 hash of the file\r\n");
+    printf("\tsha256\t - sha256 hash of the file\r\n");
     printf("\tstat\t - info about file or dir\r\n");
 };
 
@@ -449,41 +449,21 @@ static void storage_cli_mkdir(Cli* cli, string_t path) {
     furi_record_close(RECORD_STORAGE);
 }
 
-static void storage_cli_md5(Cli* cli, string_t path) {
+static void storage_cli_digest(Cli* cli, string_t path, StorageDigestType type) {
     UNUSED(cli);
     Storage* api = furi_record_open(RECORD_STORAGE);
-    File* file = storage_file_alloc(api);
+    uint8_t hash[STORAGE_DIGEST_MAX_SIZE];
 
-    if(storage_file_open(file, string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
-        const uint16_t buffer_size = 512;
-        const uint8_t hash_size = 16;
-        uint8_t* data = malloc(buffer_size);
-        uint8_t* hash = malloc(sizeof(uint8_t) * hash_size);
-        md5_context* md5_ctx = malloc(sizeof(md5_context));
-
-        md5_starts(md5_ctx);
-        while(true) {
-            uint16_t read_size = storage_file_read(file, data, buffer_size);
-            if(read_size == 0) break;
-            md5_update(md5_ctx, data, read_size);
-        }
-        md5_finish(md5_ctx, hash);
-        free(md5_ctx);
-
-        for(uint8_t i = 0; i < hash_size; i++) {
+    FS_Error error = storage_common_digest(api, string_get_cstr(path), type, hash);
+    if(error == FSE_OK) {
+        for(size_t i = 0; i < storage_digest_get_size(type); i++) {
             printf("%02x", hash[i]);
         }
         printf("\r\n");
-
-        free(hash);
-        free(data);
     } else {
-        storage_cli_print_error(storage_file_get_error(file));
+        storage_cli_print_error(error);
     }
 
-    storage_file_close(file);
-    storage_file_free(file);
-
     furi_record_close(RECORD_STORAGE);
 }
 
@@ -566,7 +546,12 @@ void storage_cli(Cli* cli, string_t args, void* context) {
         }
 
         if(string_cmp_str(cmd, "md5") == 0) {
-            storage_cli_md5(cli, path);
+            storage_cli_digest(cli, path, StorageDigestTypeMd5);
+            break;
+        }
+
+        if(string_cmp_str(cmd, "sha256") == 0) {
+            storage_cli_digest(cli, path, StorageDigestTypeSha256);
             break;
         }
 
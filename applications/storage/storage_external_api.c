@@ -7,9 +7,12 @@
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/dir_walk.h>
 #include "toolbox/path.h"
+#include <lib/toolbox/md5.h>
+#include <lib/toolbox/sha256.h>
 
 #define MAX_NAME_LENGTH 256
 #define MAX_EXT_LEN 16
+#define STORAGE_DIGEST_BUFFER_SIZE 4096
 
 #define TAG "StorageAPI"
 
@@ -597,6 +600,112 @@ FS_Error storage_common_fs_info(
     return S_RETURN_ERROR;
 }
 
+size_t storage_digest_get_size(StorageDigestType type) {
+    switch(type) {
+    case StorageDigestTypeMd5:
+        return 16;
+    case StorageDigestTypeSha256:
+        return SHA256_DIGEST_SIZE;
+    }
+    furi_crash("Unknown digest type");
+}
+
+static FS_Error storage_common_digest_get(Storage* storage, SADataCDigest* digest_data) {
+    S_API_PROLOGUE;
+
+    SAData data = {.cdigest = *digest_data};
+
+    S_API_MESSAGE(StorageCommandCommonDigestGet);
+    S_API_EPILOGUE;
+    *digest_data = data.cdigest;
+    return S_RETURN_ERROR;
+}
+
+static bool storage_common_digest_set(Storage* storage, const SADataCDigest* digest_data) {
+    S_API_PROLOGUE;
+
+    SAData data = {.cdigest = *digest_data};
+
+    S_API_MESSAGE(StorageCommandCommonDigestSet);
+    S_API_EPILOGUE;
+    return S_RETURN_BOOL;
+}
+
+static FS_Error storage_common_digest_calculate(
+    Storage* storage,
+    const char* path,
+    StorageDigestType type,
+    uint8_t* digest) {
+    File* file = storage_file_alloc(storage);
+    FS_Error error = FSE_OK;
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        uint8_t* buffer = malloc(STORAGE_DIGEST_BUFFER_SIZE);
+        md5_context* md5_ctx = NULL;
+        sha256_context* sha256_ctx = NULL;
+
+        if(type == StorageDigestTypeMd5) {
+            md5_ctx = malloc(sizeof(md5_context));
+            md5_starts(md5_ctx);
+        } else {
+            sha256_ctx = malloc(sizeof(sha256_context));
+            sha256_start(sha256_ctx);
+        }
+
+        while(true) {
+            uint16_t read_size = storage_file_read(file, buffer, STORAGE_DIGEST_BUFFER_SIZE);
+            if(read_size == 0) break;
+            if(md5_ctx) {
+                md5_update(md5_ctx, buffer, read_size);
+            } else {
+                sha256_update(sha256_ctx, buffer, read_size);
+            }
+        }
+        error = storage_file_get_error(file);
+
+        if(md5_ctx) {
+            md5_finish(md5_ctx, digest);
+            free(md5_ctx);
+        } else {
+            sha256_finish(sha256_ctx, digest);
+            free(sha256_ctx);
+        }
+        free(buffer);
+    } else {
+        error = storage_file_get_error(file);
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    return error;
+}
+
+FS_Error storage_common_digest(
+    Storage* storage,
+    const char* path,
+    StorageDigestType type,
+    uint8_t* digest) {
+    furi_assert(path);
+    furi_assert(digest);
+
+    SADataCDigest data = {
+        .path = path,
+        .type = type,
+        .digest = digest,
+    };
+
+    FS_Error error = storage_common_digest_get(storage, &data);
+    if(error == FSE_OK && !data.cached) {
+        error = storage_common_digest_calculate(storage, path, type, digest);
+        if(error == FSE_OK) {
+            storage_common_digest_set(storage, &data);
+        }
+    }
+
+    return error;
+}
+
 /****************** ERROR ******************/
 
 const char* storage_error_get_desc(FS_Error error_id) {
@@ -158,6 +158,26 @@ void* storage_get_storage_file_data(const File* file, StorageData* storage) {
     return founded_file->file_data;
 }
 
+const char* storage_get_storage_file_path(const File* file, StorageData* storage) {
+    const StorageFile* founded_file = NULL;
+
+    StorageFileList_it_t it;
+
+    for(StorageFileList_it(it, storage->files); !StorageFileList_end_p(it);
+        StorageFileList_next(it)) {
+        const StorageFile* storage_file = StorageFileList_cref(it);
+
+        if(storage_file->file->file_id == file->file_id) {
+            founded_file = storage_file;
+            break;
+        }
+    }
+
+    furi_check(founded_file != NULL);
+
+    return string_get_cstr(founded_file->path);
+}
+
 void storage_push_storage_file(File* file, string_t path, StorageType type, StorageData* storage) {
     StorageFile* storage_file = StorageFileList_push_new(storage->files);
     furi_check(storage_file != NULL);
@@ -66,6 +66,7 @@ bool storage_path_already_open(string_t path, StorageFileList_t files);
 
 void storage_set_storage_file_data(const File* file, void* file_data, StorageData* storage);
 void* storage_get_storage_file_data(const File* file, StorageData* storage);
+const char* storage_get_storage_file_path(const File* file, StorageData* storage);
 
 void storage_push_storage_file(File* file, string_t path, StorageType type, StorageData* storage);
 bool storage_pop_storage_file(File* file, StorageData* storage);
@@ -1,15 +1,35 @@
 #pragma once
 #include <furi.h>
 #include <gui/gui.h>
+#include "storage.h"
 #include "storage_glue.h"
 #include "storage_sd_api.h"
 #include "filesystem_api_internal.h"
+#include <m-dict.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #define STORAGE_COUNT (ST_INT + 1)
+#define STORAGE_DIGEST_CACHE_SIZE 64
+
+typedef struct {
+    uint64_t size;
+    StorageDigestType type;
+    uint8_t digest[STORAGE_DIGEST_MAX_SIZE];
+} StorageDigest;
+
+DICT_DEF2(StorageDigestDict, string_t, STRING_OPLIST, StorageDigest, M_POD_OPLIST)
+
+/** Digests of files that were not changed since they were calculated.
+ * Generation is incremented on every change, so a digest calculated
+ * concurrently with the change is not stored.
+ */
+typedef struct {
+    StorageDigestDict_t digests;
+    uint32_t generation;
+} StorageDigestCache;
 
 typedef struct {
     ViewPort* view_port;
@@ -21,6 +41,7 @@ struct Storage {
     StorageData storage[STORAGE_COUNT];
     StorageSDGui sd_gui;
     FuriPubSub* pubsub;
+    StorageDigestCache digest_cache;
 };
 
 #ifdef __cplusplus
@@ -53,6 +53,15 @@ typedef struct {
     uint64_t* free_space;
 } SADataCFSInfo;
 
+typedef struct {
+    const char* path;
+    StorageDigestType type;
+    uint8_t* digest;
+    uint64_t size;
+    uint32_t generation;
+    bool cached;
+} SADataCDigest;
+
 typedef struct {
     uint32_t id;
 } SADataError;
@@ -80,6 +89,7 @@ typedef union {
 
     SADataCStat cstat;
     SADataCFSInfo cfsinfo;
+    SADataCDigest cdigest;
 
     SADataError error;
 
@@ -116,6 +126,8 @@ typedef enum {
     StorageCommandCommonRemove,
     StorageCommandCommonMkDir,
     StorageCommandCommonFSInfo,
+    StorageCommandCommonDigestGet,
+    StorageCommandCommonDigestSet,
     StorageCommandSDFormat,
     StorageCommandSDUnmount,
     StorageCommandSDInfo,
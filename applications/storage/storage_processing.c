@@ -2,6 +2,7 @@
 #include <m-list.h>
 #include <m-dict.h>
 #include <m-string.h>
+#include <ctype.h>
 
 #define FS_CALL(_storage, _fn)   \
     storage_data_lock(_storage); \
@@ -90,6 +91,31 @@ static void storage_path_change_to_real_storage(string_t path, StorageType real_
     }
 }
 
+/******************* Digest cache *******************/
+
+// FAT on the SD card is case insensitive, different spellings must refer to the same entry
+static void storage_digest_cache_path_to_key(string_t key, StorageType type) {
+    if(type == ST_EXT) {
+        for(size_t i = 0; i < string_size(key); i++) {
+            string_set_char(key, i, tolower((unsigned char)string_get_char(key, i)));
+        }
+    }
+}
+
+static void storage_digest_cache_invalidate(Storage* app, string_t real_path, StorageType type) {
+    string_t key;
+    string_init_set(key, real_path);
+    storage_digest_cache_path_to_key(key, type);
+    StorageDigestDict_erase(app->digest_cache.digests, key);
+    string_clear(key);
+    app->digest_cache.generation++;
+}
+
+void storage_digest_cache_reset(Storage* app) {
+    StorageDigestDict_reset(app->digest_cache.digests);
+    app->digest_cache.generation++;
+}
+
 /******************* File Functions *******************/
 
 bool storage_process_file_open(
@@ -114,6 +140,9 @@ bool storage_process_file_open(
         if(storage_path_already_open(real_path, storage->files)) {
             file->error_id = FSE_ALREADY_OPEN;
         } else {
+            if(access_mode & FSAM_WRITE) {
+                storage_digest_cache_invalidate(app, real_path, type);
+            }
             storage_push_storage_file(file, real_path, type, storage);
             FS_CALL(storage, file.open(storage, file, remove_vfs(path), access_mode, open_mode));
         }
@@ -131,11 +160,18 @@ bool storage_process_file_close(Storage* app, File* file) {
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
+        string_t real_path;
+        string_init_set_str(real_path, storage_get_storage_file_path(file, storage));
+
         FS_CALL(storage, file.close(storage, file));
         storage_pop_storage_file(file, storage);
 
-        StorageEvent event = {.type = StorageEventTypeFileClose};
+        StorageEvent event = {
+            .type = StorageEventTypeFileClose,
+            .path = string_get_cstr(real_path),
+        };
         furi_pubsub_publish(app->pubsub, &event);
+        string_clear(real_path);
     }
 
     return ret;
@@ -366,7 +402,16 @@ static FS_Error storage_process_common_remove(Storage* app, const char* path) {
             break;
         }
 
+        storage_digest_cache_invalidate(app, real_path, type);
         FS_CALL(storage, common.remove(storage, remove_vfs(path)));
+
+        if(ret == FSE_OK) {
+            StorageEvent event = {
+                .type = StorageEventTypeRemove,
+                .path = string_get_cstr(real_path),
+            };
+            furi_pubsub_publish(app->pubsub, &event);
+        }
     } while(false);
 
     string_clear(real_path);
@@ -383,6 +428,19 @@ static FS_Error storage_process_common_mkdir(Storage* app, const char* path) {
     } else {
         StorageData* storage = storage_get_storage_by_type(app, type);
         FS_CALL(storage, common.mkdir(storage, remove_vfs(path)));
+
+        if(ret == FSE_OK) {
+            string_t real_path;
+            string_init_set(real_path, path);
+            storage_path_change_to_real_storage(real_path, type);
+
+            StorageEvent event = {
+                .type = StorageEventTypeMkDir,
+                .path = string_get_cstr(real_path),
+            };
+            furi_pubsub_publish(app->pubsub, &event);
+            string_clear(real_path);
+        }
     }
 
     return ret;
@@ -406,6 +464,61 @@ static FS_Error storage_process_common_fs_info(
     return ret;
 }
 
+static FS_Error storage_process_common_digest_get(Storage* app, SADataCDigest* data) {
+    FileInfo fileinfo;
+    data->cached = false;
+    data->generation = app->digest_cache.generation;
+
+    FS_Error ret = storage_process_common_stat(app, data->path, &fileinfo);
+    if(ret == FSE_OK && !(fileinfo.flags & FSF_DIRECTORY)) {
+        string_t key;
+        string_init_set(key, data->path);
+        StorageType type = storage_get_type_by_path(app, data->path);
+        storage_path_change_to_real_storage(key, type);
+        storage_digest_cache_path_to_key(key, type);
+
+        const StorageDigest* digest = StorageDigestDict_get(app->digest_cache.digests, key);
+        if(digest && digest->size == fileinfo.size && digest->type == data->type) {
+            memcpy(data->digest, digest->digest, storage_digest_get_size(data->type));
+            data->cached = true;
+        }
+        data->size = fileinfo.size;
+
+        string_clear(key);
+    }
+
+    return ret;
+}
+
+static bool storage_process_common_digest_set(Storage* app, const SADataCDigest* data) {
+    // file was changed while the digest was calculated
+    if(data->generation != app->digest_cache.generation) return false;
+
+    string_t key;
+    string_init_set(key, data->path);
+    StorageType type = storage_get_type_by_path(app, data->path);
+    storage_path_change_to_real_storage(key, type);
+    storage_digest_cache_path_to_key(key, type);
+
+    if(StorageDigestDict_size(app->digest_cache.digests) >= STORAGE_DIGEST_CACHE_SIZE &&
+       StorageDigestDict_get(app->digest_cache.digests, key) == NULL) {
+        StorageDigestDict_it_t it;
+        StorageDigestDict_it(it, app->digest_cache.digests);
+        string_t evicted_key;
+        string_init_set(evicted_key, StorageDigestDict_cref(it)->key);
+        StorageDigestDict_erase(app->digest_cache.digests, evicted_key);
+        string_clear(evicted_key);
+    }
+
+    StorageDigest digest = {.size = data->size, .type = data->type};
+    memcpy(digest.digest, data->digest, storage_digest_get_size(data->type));
+    StorageDigestDict_set_at(app->digest_cache.digests, key, digest);
+
+    string_clear(key);
+
+    return true;
+}
+
 /****************** Raw SD API ******************/
 // TODO think about implementing a custom storage API to split that kind of api linkage
 #include "storages/storage_ext.h"
@@ -416,6 +529,7 @@ static FS_Error storage_process_sd_format(Storage* app) {
     if(storage_data_status(&app->storage[ST_EXT]) == StorageStatusNotReady) {
         ret = FSE_NOT_READY;
     } else {
+        storage_digest_cache_reset(app);
         ret = sd_format_card(&app->storage[ST_EXT]);
     }
 
@@ -428,6 +542,7 @@ static FS_Error storage_process_sd_unmount(Storage* app) {
     if(storage_data_status(&app->storage[ST_EXT]) == StorageStatusNotReady) {
         ret = FSE_NOT_READY;
     } else {
+        storage_digest_cache_reset(app);
         sd_unmount_card(&app->storage[ST_EXT]);
     }
 
@@ -560,6 +675,14 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
             message->data->cfsinfo.total_space,
             message->data->cfsinfo.free_space);
         break;
+    case StorageCommandCommonDigestGet:
+        message->return_data->error_value =
+            storage_process_common_digest_get(app, &message->data->cdigest);
+        break;
+    case StorageCommandCommonDigestSet:
+        message->return_data->bool_value =
+            storage_process_common_digest_set(app, &message->data->cdigest);
+        break;
     case StorageCommandSDFormat:
         message->return_data->error_value = storage_process_sd_format(app);
         break;
@@ -11,6 +11,8 @@ extern "C" {
 
 void storage_process_message(Storage* app, StorageMessage* message);
 
+void storage_digest_cache_reset(Storage* app);
+
 #ifdef __cplusplus
 }
 #endif
@@ -72,34 +72,32 @@ static void subghz_scene_add_to_history_callback(
     void* context) {
     furi_assert(context);
     SubGhz* subghz = context;
-    string_t str_buff;
-    string_init(str_buff);
 
     if(subghz_history_add_to_history(subghz->txrx->history, decoder_base, subghz->txrx->preset)) {
-        string_reset(str_buff);
-
         subghz->state_notifications = SubGhzNotificationStateRxDone;
 
-        subghz_history_get_text_item_menu(
-            subghz->txrx->history, str_buff, subghz_history_get_item(subghz->txrx->history) - 1);
-        subghz_view_receiver_add_item_to_menu(
-            subghz->subghz_receiver,
-            string_get_cstr(str_buff),
-            subghz_history_get_type_protocol(
-                subghz->txrx->history, subghz_history_get_item(subghz->txrx->history) - 1));
+        subghz_view_receiver_set_item_count(
+            subghz->subghz_receiver, subghz_history_get_item(subghz->txrx->history));
 
         subghz_scene_receiver_update_statusbar(subghz);
     }
     subghz_receiver_reset(receiver);
-    string_clear(str_buff);
     subghz->txrx->rx_key_state = SubGhzRxKeyStateAddKey;
 }
 
-void subghz_scene_receiver_on_enter(void* context) {
+static void subghz_scene_receiver_item_callback(
+    uint16_t idx,
+    string_t text,
+    uint8_t* type,
+    void* context) {
+    furi_assert(context);
     SubGhz* subghz = context;
+    subghz_history_get_text_item_menu(subghz->txrx->history, text, idx);
+    *type = subghz_history_get_type_protocol(subghz->txrx->history, idx);
+}
 
-    string_t str_buff;
-    string_init(str_buff);
+void subghz_scene_receiver_on_enter(void* context) {
+    SubGhz* subghz = context;
 
     if(subghz->txrx->rx_key_state == SubGhzRxKeyStateIDLE) {
         subghz_preset_init(
@@ -112,16 +110,13 @@ void subghz_scene_receiver_on_enter(void* context) {
 
     //Load history to receiver
     subghz_view_receiver_exit(subghz->subghz_receiver);
-    for(uint8_t i = 0; i < subghz_history_get_item(subghz->txrx->history); i++) {
-        string_reset(str_buff);
-        subghz_history_get_text_item_menu(subghz->txrx->history, str_buff, i);
-        subghz_view_receiver_add_item_to_menu(
-            subghz->subghz_receiver,
-            string_get_cstr(str_buff),
-            subghz_history_get_type_protocol(subghz->txrx->history, i));
+    subghz_view_receiver_set_item_callback(
+        subghz->subghz_receiver, subghz_scene_receiver_item_callback, subghz);
+    if(subghz_history_get_item(subghz->txrx->history)) {
+        subghz_view_receiver_set_item_count(
+            subghz->subghz_receiver, subghz_history_get_item(subghz->txrx->history));
         subghz->txrx->rx_key_state = SubGhzRxKeyStateAddKey;
     }
-    string_clear(str_buff);
     subghz_scene_receiver_update_statusbar(subghz);
     subghz_view_receiver_set_callback(
         subghz->subghz_receiver, subghz_scene_receiver_callback, subghz);
@@ -5,11 +5,14 @@
 #include <stream_buffer.h>
 
 #include <lib/toolbox/args.h>
+#include <lib/toolbox/dir_walk.h>
 #include <lib/subghz/subghz_keystore.h>
 
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_packed.h>
+#include <lib/subghz/protocols/registry.h>
 
 #include "helpers/subghz_chat.h"
 
@@ -418,6 +421,264 @@ void subghz_cli_command_decode_raw(Cli* cli, string_t args, void* context) {
     string_clear(file_name);
 }
 
+#define SUBGHZ_CLI_BENCH_CHUNK_SIZE 512
+
+typedef struct {
+    SubGhzProtocolDecoderBase* decoder;
+    uint64_t cycles;
+    uint32_t decoded;
+} SubGhzCliBenchProtocol;
+
+typedef struct {
+    SubGhzReceiver* receiver;
+    SubGhzCliBenchProtocol* protocols;
+    size_t protocol_count;
+
+    int32_t chunk[SUBGHZ_CLI_BENCH_CHUNK_SIZE];
+    size_t chunk_count;
+
+    uint64_t receiver_cycles;
+    uint32_t pulse_count;
+    uint32_t file_decoded;
+} SubGhzCliBench;
+
+static void subghz_cli_command_bench_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    SubGhzCliBench* instance = context;
+    for(size_t i = 0; i < instance->protocol_count; i++) {
+        if(instance->protocols[i].decoder->protocol == decoder_base->protocol) {
+            instance->protocols[i].decoded++;
+            break;
+        }
+    }
+    instance->file_decoded++;
+    subghz_receiver_reset(receiver);
+}
+
+static void subghz_cli_command_bench_flush(SubGhzCliBench* instance) {
+    // Whole receiver, as used on air
+    uint32_t start = DWT->CYCCNT;
+    for(size_t i = 0; i < instance->chunk_count; i++) {
+        int32_t duration = instance->chunk[i];
+        subghz_receiver_decode(instance->receiver, duration > 0, abs(duration));
+    }
+    instance->receiver_cycles += DWT->CYCCNT - start;
+
+    // Every decoder alone, on its own instance
+    for(size_t p = 0; p < instance->protocol_count; p++) {
+        SubGhzProtocolDecoderBase* decoder = instance->protocols[p].decoder;
+        start = DWT->CYCCNT;
+        for(size_t i = 0; i < instance->chunk_count; i++) {
+            int32_t duration = instance->chunk[i];
+            decoder->protocol->decoder->feed(decoder, duration > 0, abs(duration));
+        }
+        instance->protocols[p].cycles += DWT->CYCCNT - start;
+    }
+
+    instance->pulse_count += instance->chunk_count;
+    instance->chunk_count = 0;
+}
+
+static void subghz_cli_command_bench_add_duration(int32_t duration, void* context) {
+    SubGhzCliBench* instance = context;
+    if(duration == 0) return;
+    instance->chunk[instance->chunk_count++] = duration;
+    if(instance->chunk_count == SUBGHZ_CLI_BENCH_CHUNK_SIZE) {
+        subghz_cli_command_bench_flush(instance);
+    }
+}
+
+static bool subghz_cli_command_bench_file(
+    SubGhzCliBench* instance,
+    FlipperFormat* fff_data_file,
+    const char* file_name) {
+    string_t temp_str;
+    string_init(temp_str);
+    uint32_t temp_data32;
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(fff_data_file, file_name)) break;
+        if(!flipper_format_read_header(fff_data_file, temp_str, &temp_data32)) break;
+        if(strcmp(string_get_cstr(temp_str), SUBGHZ_RAW_FILE_TYPE) != 0 ||
+           temp_data32 != SUBGHZ_KEY_FILE_VERSION) {
+            break;
+        }
+        if(!flipper_format_read_string(fff_data_file, "Protocol", temp_str)) break;
+
+        Stream* stream = flipper_format_get_raw_stream(fff_data_file);
+        //skip the end of the previous line "\n"
+        stream_seek(stream, 1, StreamOffsetFromCurrent);
+
+        subghz_receiver_reset(instance->receiver);
+        for(size_t p = 0; p < instance->protocol_count; p++) {
+            SubGhzProtocolDecoderBase* decoder = instance->protocols[p].decoder;
+            decoder->protocol->decoder->reset(decoder);
+        }
+        instance->file_decoded = 0;
+
+        size_t data_start = stream_tell(stream);
+        if(stream_read_line(stream, temp_str) &&
+           subghz_raw_packed_check_line(string_get_cstr(temp_str))) {
+            while(subghz_raw_packed_read(stream, subghz_cli_command_bench_add_duration, instance)) {
+            }
+        } else {
+            stream_seek(stream, data_start, StreamOffsetFromStart);
+            while(stream_read_line(stream, temp_str)) {
+                string_strim(temp_str);
+                subghz_file_encoder_worker_parse_line(
+                    string_get_cstr(temp_str), subghz_cli_command_bench_add_duration, instance);
+            }
+        }
+        subghz_cli_command_bench_flush(instance);
+
+        printf("%s: decoded %lu\r\n", file_name, instance->file_decoded);
+        result = true;
+    } while(false);
+
+    flipper_format_file_close(fff_data_file);
+    string_clear(temp_str);
+    return result;
+}
+
+static void subghz_cli_command_decode_bench(Cli* cli, string_t args) {
+    string_t path;
+    string_init(path);
+
+    if(!args_read_string_and_trim(args, path)) {
+        cli_print_usage(
+            "subghz decode_bench", "<dir_name: path_RAW_corpus>", string_get_cstr(args));
+        string_clear(path);
+        return;
+    }
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_load_keystore(environment, EXT_PATH("subghz/assets/keeloq_mfcodes"));
+    subghz_environment_load_keystore(environment, EXT_PATH("subghz/assets/keeloq_mfcodes_user"));
+    subghz_environment_set_came_atomo_rainbow_table_file_name(
+        environment, EXT_PATH("subghz/assets/came_atomo"));
+    subghz_environment_set_nice_flor_s_rainbow_table_file_name(
+        environment, EXT_PATH("subghz/assets/nice_flor_s"));
+
+    SubGhzCliBench* instance = malloc(sizeof(SubGhzCliBench));
+    instance->protocols =
+        malloc(sizeof(SubGhzCliBenchProtocol) * subghz_protocol_registry_count());
+    for(size_t i = 0; i < subghz_protocol_registry_count(); i++) {
+        const SubGhzProtocol* protocol = subghz_protocol_registry_get_by_index(i);
+        if((protocol->flag & SubGhzProtocolFlag_Decodable) && protocol->decoder &&
+           protocol->decoder->alloc) {
+            SubGhzCliBenchProtocol* bench_protocol =
+                &instance->protocols[instance->protocol_count++];
+            bench_protocol->decoder = protocol->decoder->alloc(environment);
+        }
+    }
+
+    FuriThreadId thread_id = furi_thread_get_current_id();
+    memmgr_heap_enable_thread_trace(thread_id);
+    size_t heap_before = memmgr_heap_get_thread_memory(thread_id);
+    size_t free_heap_before = memmgr_get_free_heap();
+
+    instance->receiver = subghz_receiver_alloc_init(environment);
+    subghz_receiver_set_filter(instance->receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(
+        instance->receiver, subghz_cli_command_bench_rx_callback, instance);
+    size_t heap_receiver = memmgr_heap_get_thread_memory(thread_id);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    string_t name;
+    string_init(name);
+    size_t file_count = 0;
+
+    if(dir_walk_open(dir_walk, string_get_cstr(path))) {
+        FileInfo fileinfo;
+        while(dir_walk_read(dir_walk, name, &fileinfo) == DirWalkOK &&
+              !cli_cmd_interrupt_received(cli)) {
+            if(fileinfo.flags & FSF_DIRECTORY) continue;
+            if(!string_end_with_str_p(name, SUBGHZ_APP_EXTENSION)) continue;
+            if(subghz_cli_command_bench_file(instance, fff_data_file, string_get_cstr(name))) {
+                file_count++;
+            }
+        }
+    } else {
+        printf(
+            "subghz decode_bench \033[0;31mError open dir\033[0m %s\r\n",
+            string_get_cstr(path));
+    }
+    size_t heap_after = memmgr_heap_get_thread_memory(thread_id);
+
+    uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    uint32_t pulse_count = MAX(instance->pulse_count, 1UL);
+    printf(
+        "\r\nFiles %u, pulses %lu, receiver \033[0;33m%lu\033[0m ns/pulse\r\n",
+        file_count,
+        instance->pulse_count,
+        (uint32_t)(instance->receiver_cycles * 1000 / cycles_per_us / pulse_count));
+    printf(
+        "Heap: receiver %u bytes, decoding %d bytes, free before %u\r\n",
+        heap_receiver - heap_before,
+        (int)(heap_after - heap_receiver),
+        free_heap_before);
+    for(size_t i = 0; i < instance->protocol_count; i++) {
+        SubGhzCliBenchProtocol* bench_protocol = &instance->protocols[i];
+        printf(
+            "%-20s decoded %-5lu %lu ns/pulse\r\n",
+            bench_protocol->decoder->protocol->name,
+            bench_protocol->decoded,
+            (uint32_t)(bench_protocol->cycles * 1000 / cycles_per_us / pulse_count));
+    }
+    memmgr_heap_disable_thread_trace(thread_id);
+
+    string_clear(name);
+    dir_walk_free(dir_walk);
+    flipper_format_free(fff_data_file);
+    furi_record_close(RECORD_STORAGE);
+
+    subghz_receiver_free(instance->receiver);
+    for(size_t i = 0; i < instance->protocol_count; i++) {
+        SubGhzProtocolDecoderBase* decoder = instance->protocols[i].decoder;
+        decoder->protocol->decoder->free(decoder);
+    }
+    free(instance->protocols);
+    free(instance);
+    subghz_environment_free(environment);
+    string_clear(path);
+}
+
+static void subghz_cli_command_raw_convert(Cli* cli, string_t args) {
+    UNUSED(cli);
+    string_t src_path;
+    string_t dst_path;
+    string_init(src_path);
+    string_init(dst_path);
+
+    do {
+        if(!args_read_probably_quoted_string_and_trim(args, src_path) ||
+           !args_read_probably_quoted_string_and_trim(args, dst_path)) {
+            cli_print_usage(
+                "subghz raw_convert",
+                "<src_file: path_RAW_file> <dst_file: path_RAW_file>",
+                string_get_cstr(args));
+            break;
+        }
+
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        if(subghz_raw_packed_convert(
+               storage, string_get_cstr(src_path), string_get_cstr(dst_path))) {
+            printf("Converted to %s\r\n", string_get_cstr(dst_path));
+        } else {
+            printf("subghz raw_convert \033[0;31mError converting file\033[0m\r\n");
+        }
+        furi_record_close(RECORD_STORAGE);
+    } while(false);
+
+    string_clear(src_path);
+    string_clear(dst_path);
+}
+
 static void subghz_cli_command_print_usage() {
     printf("Usage:\r\n");
     printf("subghz <cmd> <args>\r\n");
@@ -428,6 +689,9 @@ static void subghz_cli_command_print_usage() {
         "\ttx <3 byte Key: in hex> <frequency: in Hz> <repeat: count>\t - Transmitting key\r\n");
     printf("\trx <frequency:in Hz>\t - Reception key\r\n");
     printf("\tdecode_raw <file_name: path_RAW_file>\t - Testing\r\n");
+    printf("\tdecode_bench <dir_name: path_RAW_corpus>\t - Decode speed for all RAW files\r\n");
+    printf(
+        "\traw_convert <src_file: path_RAW_file> <dst_file: path_RAW_file>\t - Convert RAW data between text and packed\r\n");
 
     if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
         printf("\r\n");
@@ -436,12 +700,14 @@ static void subghz_cli_command_print_usage() {
         printf("\trx_carrier <frequency:in Hz>\t - Receiv carrier\r\n");
         printf(
             "\tencrypt_keeloq <path_decrypted_file> <path_encrypted_file> <IV:16 bytes in hex>\t - Encrypt keeloq manufacture keys\r\n");
+        printf(
+            "\tencrypt_keeloq_bin <path_decrypted_file> <path_encrypted_file> <IV:16 bytes in hex>\t - Encrypt keeloq manufacture keys to binary keystore\r\n");
         printf(
             "\tencrypt_raw <path_decrypted_file> <path_encrypted_file> <IV:16 bytes in hex>\t - Encrypt RAW data\r\n");
     }
 }
 
-static void subghz_cli_command_encrypt_keeloq(Cli* cli, string_t args) {
+static void subghz_cli_command_encrypt_keeloq(Cli* cli, string_t args, bool binary) {
     UNUSED(cli);
     uint8_t iv[16];
 
@@ -473,7 +739,10 @@ static void subghz_cli_command_encrypt_keeloq(Cli* cli, string_t args) {
             break;
         }
 
-        if(!subghz_keystore_save(keystore, string_get_cstr(destination), iv)) {
+        bool saved = binary ?
+                         subghz_keystore_save_binary(keystore, string_get_cstr(destination), iv) :
+                         subghz_keystore_save(keystore, string_get_cstr(destination), iv);
+        if(!saved) {
             printf("Failed to save Keystore");
             break;
         }
@@ -733,9 +1002,24 @@ static void subghz_cli_command(Cli* cli, string_t args, void* context) {
             break;
         }
 
+        if(string_cmp_str(cmd, "decode_bench") == 0) {
+            subghz_cli_command_decode_bench(cli, args);
+            break;
+        }
+
+        if(string_cmp_str(cmd, "raw_convert") == 0) {
+            subghz_cli_command_raw_convert(cli, args);
+            break;
+        }
+
         if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
             if(string_cmp_str(cmd, "encrypt_keeloq") == 0) {
-                subghz_cli_command_encrypt_keeloq(cli, args);
+                subghz_cli_command_encrypt_keeloq(cli, args, false);
+                break;
+            }
+
+            if(string_cmp_str(cmd, "encrypt_keeloq_bin") == 0) {
+                subghz_cli_command_encrypt_keeloq(cli, args, true);
                 break;
             }
 
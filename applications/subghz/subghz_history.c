@@ -4,89 +4,341 @@
 
 #include <furi.h>
 #include <m-string.h>
+#include <m-array.h>
+#include <storage/storage.h>
+#include <toolbox/stream/file_stream.h>
+#include <flipper_format/flipper_format_i.h>
+#include <lib/fnv1a-hash/fnv1a-hash.h>
 
-#define SUBGHZ_HISTORY_MAX 50
+#define SUBGHZ_HISTORY_MAX 4000
+#define SUBGHZ_HISTORY_RAM_RECORDS 32
+// Two fixed size generations, the older one is dropped once the current one is 3/4 full.
+// Signals are deduplicated against at least the latest SUBGHZ_HISTORY_HASH_SET_LIMIT records.
+#define SUBGHZ_HISTORY_HASH_SET_SIZE 1024
+#define SUBGHZ_HISTORY_HASH_SET_LIMIT (SUBGHZ_HISTORY_HASH_SET_SIZE / 4 * 3)
+#define SUBGHZ_HISTORY_RECORDS_PATH SUBGHZ_RAW_FOLDER "/.history.rec"
+#define SUBGHZ_HISTORY_DATA_PATH SUBGHZ_RAW_FOLDER "/.history.dat"
 #define TAG "SubGhzHistory"
 
+/** Compact capture record, kept in RAM for the latest captures and spilled to SD for older ones */
 typedef struct {
-    string_t item_str;
+    uint64_t key;
+    const SubGhzProtocol* protocol; /**< Static protocol description, serves as protocol id */
+    uint32_t frequency;
+    uint32_t timestamp;
+    uint32_t data_offset; /**< Serialized data offset in the data file, valid once spilled */
+    uint16_t data_size;
+    uint8_t bits;
+    uint8_t preset_index;
+} SubGhzHistoryRecord;
+
+typedef struct {
+    SubGhzHistoryRecord record;
     FlipperFormat* flipper_string;
-    uint8_t type;
-    SubGhzPresetDefinition* preset;
-} SubGhzHistoryItem;
+} SubGhzHistorySlot;
 
-ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
+typedef struct {
+    string_t name;
+    uint8_t* data;
+    size_t data_size;
+} SubGhzHistoryPreset;
 
-#define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
+ARRAY_DEF(SubGhzHistoryPresetArray, SubGhzHistoryPreset, M_POD_OPLIST)
 
-typedef struct {
-    SubGhzHistoryItemArray_t data;
-} SubGhzHistoryStruct;
+#define M_OPL_SubGhzHistoryPresetArray_t() ARRAY_OPLIST(SubGhzHistoryPresetArray, M_POD_OPLIST)
 
 struct SubGhzHistory {
-    uint32_t last_update_timestamp;
+    FuriMutex* mutex;
     uint16_t last_index_write;
-    uint8_t code_last_hash_data;
+    uint16_t spilled;
+    SubGhzHistorySlot slots[SUBGHZ_HISTORY_RAM_RECORDS];
+
+    uint32_t* hash_set; /**< Two generations of SUBGHZ_HISTORY_HASH_SET_SIZE slots */
+    uint8_t hash_set_generation;
+    uint16_t hash_set_count; /**< Hashes in the current generation */
+
+    SubGhzHistoryPresetArray_t presets;
+    SubGhzPresetDefinition preset;
+
+    Storage* storage;
+    Stream* record_stream;
+    Stream* data_stream;
+    bool spill_failed;
+
+    SubGhzHistoryRecord record;
+    FlipperFormat* flipper_string;
+    int32_t flipper_string_idx;
+    FlipperFormat* text_string;
     string_t tmp_string;
-    SubGhzHistoryStruct* history;
 };
 
+static uint32_t subghz_history_hash(const SubGhzHistoryRecord* record) {
+    // FNV-1a over protocol name, bit count and key
+    const char* name = record->protocol->name;
+    uint8_t key[sizeof(uint64_t)];
+    for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
+        key[i] = record->key >> (i * 8);
+    }
+    uint32_t hash = fnv1a_buffer_hash((const uint8_t*)name, strlen(name), FNV_1A_INIT);
+    hash = fnv1a_buffer_hash(&record->bits, sizeof(record->bits), hash);
+    hash = fnv1a_buffer_hash(key, sizeof(key), hash);
+    // 0 marks an empty hash set slot
+    return hash ? hash : 1;
+}
+
+/** Find the slot holding hash, or the empty slot it goes to */
+static uint16_t subghz_history_hash_set_find(const uint32_t* set, uint32_t hash) {
+    const uint16_t mask = SUBGHZ_HISTORY_HASH_SET_SIZE - 1;
+    uint16_t i = hash & mask;
+    while(set[i] != 0 && set[i] != hash) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static bool subghz_history_hash_set_contains(SubGhzHistory* instance, uint32_t hash) {
+    if(!instance->hash_set) return false;
+    for(size_t generation = 0; generation < 2; generation++) {
+        const uint32_t* set = &instance->hash_set[generation * SUBGHZ_HISTORY_HASH_SET_SIZE];
+        if(set[subghz_history_hash_set_find(set, hash)] == hash) return true;
+    }
+    return false;
+}
+
+/** Add hash of a committed record to the current generation */
+static void subghz_history_hash_set_add(SubGhzHistory* instance, uint32_t hash) {
+    if(!instance->hash_set) {
+        instance->hash_set = malloc(2 * SUBGHZ_HISTORY_HASH_SET_SIZE * sizeof(uint32_t));
+        instance->hash_set_generation = 0;
+        instance->hash_set_count = 0;
+    }
+    if(instance->hash_set_count == SUBGHZ_HISTORY_HASH_SET_LIMIT) {
+        // Forget the older generation and fill it from scratch
+        instance->hash_set_generation ^= 1;
+        memset(
+            &instance->hash_set[instance->hash_set_generation * SUBGHZ_HISTORY_HASH_SET_SIZE],
+            0,
+            SUBGHZ_HISTORY_HASH_SET_SIZE * sizeof(uint32_t));
+        instance->hash_set_count = 0;
+        FURI_LOG_D(TAG, "Hash set generation dropped");
+    }
+
+    uint32_t* set =
+        &instance->hash_set[instance->hash_set_generation * SUBGHZ_HISTORY_HASH_SET_SIZE];
+    uint16_t i = subghz_history_hash_set_find(set, hash);
+    if(set[i] == 0) {
+        set[i] = hash;
+        instance->hash_set_count++;
+    }
+}
+
+static uint8_t
+    subghz_history_get_preset_index(SubGhzHistory* instance, SubGhzPresetDefinition* preset) {
+    size_t count = SubGhzHistoryPresetArray_size(instance->presets);
+    for(size_t i = 0; i < count; i++) {
+        SubGhzHistoryPreset* item = SubGhzHistoryPresetArray_get(instance->presets, i);
+        if(item->data == preset->data && item->data_size == preset->data_size &&
+           string_equal_p(item->name, preset->name)) {
+            return i;
+        }
+    }
+    furi_check(count <= UINT8_MAX);
+    SubGhzHistoryPreset* item = SubGhzHistoryPresetArray_push_raw(instance->presets);
+    string_init_set(item->name, preset->name);
+    item->data = preset->data;
+    item->data_size = preset->data_size;
+    return count;
+}
+
+static bool subghz_history_spill_open(SubGhzHistory* instance) {
+    if(instance->spill_failed) return false;
+    if(instance->record_stream) return true;
+
+    instance->record_stream = file_stream_alloc(instance->storage);
+    instance->data_stream = file_stream_alloc(instance->storage);
+    storage_common_mkdir(instance->storage, SUBGHZ_RAW_FOLDER);
+    if(!file_stream_open(
+           instance->record_stream,
+           SUBGHZ_HISTORY_RECORDS_PATH,
+           FSAM_READ_WRITE,
+           FSOM_CREATE_ALWAYS) ||
+       !file_stream_open(
+           instance->data_stream, SUBGHZ_HISTORY_DATA_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        FURI_LOG_W(TAG, "Spill files are not available, history is limited to RAM");
+        instance->spill_failed = true;
+    }
+    return !instance->spill_failed;
+}
+
+static void subghz_history_spill_close(SubGhzHistory* instance) {
+    if(instance->record_stream) {
+        stream_free(instance->record_stream);
+        stream_free(instance->data_stream);
+        instance->record_stream = NULL;
+        instance->data_stream = NULL;
+        storage_simply_remove(instance->storage, SUBGHZ_HISTORY_RECORDS_PATH);
+        storage_simply_remove(instance->storage, SUBGHZ_HISTORY_DATA_PATH);
+    }
+    instance->spill_failed = false;
+}
+
+/** Append the oldest RAM record and its serialized data to the spill files */
+static bool subghz_history_spill(SubGhzHistory* instance) {
+    if(!subghz_history_spill_open(instance)) return false;
+
+    SubGhzHistorySlot* slot = &instance->slots[instance->spilled % SUBGHZ_HISTORY_RAM_RECORDS];
+    Stream* slot_stream = flipper_format_get_raw_stream(slot->flipper_string);
+    size_t data_size = stream_size(slot_stream);
+
+    bool result = false;
+    do {
+        if(!stream_seek(instance->data_stream, 0, StreamOffsetFromEnd)) break;
+        slot->record.data_offset = stream_tell(instance->data_stream);
+        slot->record.data_size = data_size;
+        if(!stream_rewind(slot_stream)) break;
+        if(stream_copy(slot_stream, instance->data_stream, data_size) != data_size) break;
+        if(!stream_seek(instance->record_stream, 0, StreamOffsetFromEnd)) break;
+        if(stream_write(
+               instance->record_stream,
+               (uint8_t*)&slot->record,
+               sizeof(SubGhzHistoryRecord)) != sizeof(SubGhzHistoryRecord))
+            break;
+        result = true;
+    } while(false);
+
+    if(result) {
+        instance->spilled++;
+    } else {
+        FURI_LOG_E(TAG, "Spill error");
+        instance->spill_failed = true;
+    }
+    return result;
+}
+
+static const SubGhzHistoryRecord*
+    subghz_history_get_record(SubGhzHistory* instance, uint16_t idx) {
+    furi_check(idx < instance->last_index_write);
+    if(idx >= instance->spilled) {
+        return &instance->slots[idx % SUBGHZ_HISTORY_RAM_RECORDS].record;
+    }
+
+    memset(&instance->record, 0, sizeof(SubGhzHistoryRecord));
+    if(!stream_seek(
+           instance->record_stream, idx * sizeof(SubGhzHistoryRecord), StreamOffsetFromStart) ||
+       stream_read(
+           instance->record_stream, (uint8_t*)&instance->record, sizeof(SubGhzHistoryRecord)) !=
+           sizeof(SubGhzHistoryRecord)) {
+        FURI_LOG_E(TAG, "Record %u read error", idx);
+    }
+    return &instance->record;
+}
+
+/** Load serialized data of history[idx] into flipper_format */
+static bool subghz_history_load_data(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    FlipperFormat* flipper_format) {
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    stream_clean(stream);
+
+    bool result = false;
+    if(idx >= instance->spilled) {
+        SubGhzHistorySlot* slot = &instance->slots[idx % SUBGHZ_HISTORY_RAM_RECORDS];
+        Stream* slot_stream = flipper_format_get_raw_stream(slot->flipper_string);
+        size_t data_size = stream_size(slot_stream);
+        result = stream_rewind(slot_stream) &&
+                 (stream_copy(slot_stream, stream, data_size) == data_size);
+    } else {
+        const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+        result = stream_seek(instance->data_stream, record->data_offset, StreamOffsetFromStart) &&
+                 (stream_copy(instance->data_stream, stream, record->data_size) ==
+                  record->data_size);
+    }
+    flipper_format_rewind(flipper_format);
+
+    if(!result) FURI_LOG_E(TAG, "Data %u load error", idx);
+    return result;
+}
+
 SubGhzHistory* subghz_history_alloc(void) {
     SubGhzHistory* instance = malloc(sizeof(SubGhzHistory));
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    for(size_t i = 0; i < SUBGHZ_HISTORY_RAM_RECORDS; i++) {
+        instance->slots[i].flipper_string = flipper_format_string_alloc();
+    }
+    SubGhzHistoryPresetArray_init(instance->presets);
+    string_init(instance->preset.name);
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->flipper_string = flipper_format_string_alloc();
+    instance->flipper_string_idx = -1;
+    instance->text_string = flipper_format_string_alloc();
     string_init(instance->tmp_string);
-    instance->history = malloc(sizeof(SubGhzHistoryStruct));
-    SubGhzHistoryItemArray_init(instance->history->data);
     return instance;
 }
 
 void subghz_history_free(SubGhzHistory* instance) {
     furi_assert(instance);
+    subghz_history_reset(instance);
+    for(size_t i = 0; i < SUBGHZ_HISTORY_RAM_RECORDS; i++) {
+        flipper_format_free(instance->slots[i].flipper_string);
+    }
+    SubGhzHistoryPresetArray_clear(instance->presets);
+    string_clear(instance->preset.name);
+    furi_record_close(RECORD_STORAGE);
+    flipper_format_free(instance->flipper_string);
+    flipper_format_free(instance->text_string);
     string_clear(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            string_clear(item->item_str);
-            string_clear(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_clear(instance->history->data);
-    free(instance->history);
+    furi_mutex_free(instance->mutex);
     free(instance);
 }
 
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    uint32_t frequency = subghz_history_get_record(instance, idx)->frequency;
+    furi_mutex_release(instance->mutex);
+    return frequency;
 }
 
 SubGhzPresetDefinition* subghz_history_get_preset_def(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    SubGhzHistoryPreset* preset =
+        SubGhzHistoryPresetArray_get(instance->presets, record->preset_index);
+    string_set(instance->preset.name, preset->name);
+    instance->preset.frequency = record->frequency;
+    instance->preset.data = preset->data;
+    instance->preset.data_size = preset->data_size;
+    furi_mutex_release(instance->mutex);
+    return &instance->preset;
 }
 
 const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return string_get_cstr(item->preset->name);
+    return string_get_cstr(subghz_history_get_preset_def(instance, idx)->name);
 }
 
 void subghz_history_reset(SubGhzHistory* instance) {
     furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
     string_reset(instance->tmp_string);
+    for(size_t i = 0; i < SUBGHZ_HISTORY_RAM_RECORDS; i++) {
+        stream_clean(flipper_format_get_raw_stream(instance->slots[i].flipper_string));
+    }
     for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            string_clear(item->item_str);
-            string_clear(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
+        M_EACH(item, instance->presets, SubGhzHistoryPresetArray_t) {
+            string_clear(item->name);
         }
-    SubGhzHistoryItemArray_reset(instance->history->data);
+    SubGhzHistoryPresetArray_reset(instance->presets);
+    free(instance->hash_set);
+    instance->hash_set = NULL;
+    instance->hash_set_count = 0;
+    subghz_history_spill_close(instance);
+    instance->flipper_string_idx = -1;
     instance->last_index_write = 0;
-    instance->code_last_hash_data = 0;
+    instance->spilled = 0;
+    furi_mutex_release(instance->mutex);
 }
 
 uint16_t subghz_history_get_item(SubGhzHistory* instance) {
@@ -96,44 +348,95 @@ uint16_t subghz_history_get_item(SubGhzHistory* instance) {
 
 uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->type;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzProtocol* protocol = subghz_history_get_record(instance, idx)->protocol;
+    furi_mutex_release(instance->mutex);
+    return protocol ? protocol->type : SubGhzProtocolTypeUnknown;
 }
 
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzProtocol* protocol = subghz_history_get_record(instance, idx)->protocol;
+    furi_mutex_release(instance->mutex);
+    if(!protocol) {
         FURI_LOG_E(TAG, "Missing Protocol");
-        string_reset(instance->tmp_string);
+        return "";
     }
-    return string_get_cstr(instance->tmp_string);
+    return protocol->name;
 }
 
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    FlipperFormat* flipper_string = instance->flipper_string;
+    if(instance->flipper_string_idx == idx) {
+        flipper_format_rewind(flipper_string);
+    } else if(subghz_history_load_data(instance, idx, flipper_string)) {
+        instance->flipper_string_idx = idx;
     } else {
-        return NULL;
+        instance->flipper_string_idx = -1;
+        flipper_string = NULL;
     }
+    furi_mutex_release(instance->mutex);
+    return flipper_string;
 }
+
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, string_t output) {
     furi_assert(instance);
-    if(instance->last_index_write == SUBGHZ_HISTORY_MAX) {
+    uint16_t max = instance->spill_failed ? SUBGHZ_HISTORY_RAM_RECORDS : SUBGHZ_HISTORY_MAX;
+    if(instance->last_index_write >= max) {
         if(output != NULL) string_printf(output, "Memory is FULL");
         return true;
     }
-    if(output != NULL)
-        string_printf(output, "%02u/%02u", instance->last_index_write, SUBGHZ_HISTORY_MAX);
+    if(output != NULL) {
+        if(instance->spill_failed) {
+            string_printf(output, "%02u/%02u", instance->last_index_write, max);
+        } else {
+            string_printf(output, "%u", instance->last_index_write);
+        }
+    }
     return false;
 }
 
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, string_t output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    string_set(output, item->item_str);
+    furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    uint64_t data = record->key;
+    const char* name = record->protocol ? record->protocol->name : "";
+
+    // Manufacture is not a part of the compact record, take it from serialized data
+    string_set_str(instance->tmp_string, name);
+    const char* prefix = NULL;
+    if(!strcmp(name, "KeeLoq")) {
+        prefix = "KL ";
+    } else if(!strcmp(name, "Star Line")) {
+        prefix = "SL ";
+    }
+    if(prefix && subghz_history_load_data(instance, idx, instance->text_string)) {
+        if(flipper_format_read_string(instance->text_string, "Manufacture", output)) {
+            string_printf(instance->tmp_string, "%s%s", prefix, string_get_cstr(output));
+        } else {
+            FURI_LOG_E(TAG, "Missing Manufacture");
+        }
+    }
+
+    if(!(uint32_t)(data >> 32)) {
+        string_printf(
+            output,
+            "%s %lX",
+            string_get_cstr(instance->tmp_string),
+            (uint32_t)(data & 0xFFFFFFFF));
+    } else {
+        string_printf(
+            output,
+            "%s %lX%08lX",
+            string_get_cstr(instance->tmp_string),
+            (uint32_t)(data >> 32),
+            (uint32_t)(data & 0xFFFFFFFF));
+    }
+    furi_mutex_release(instance->mutex);
 }
 
 bool subghz_history_add_to_history(
@@ -143,88 +446,59 @@ bool subghz_history_add_to_history(
     furi_assert(instance);
     furi_assert(context);
 
-    if(instance->last_index_write >= SUBGHZ_HISTORY_MAX) return false;
+    if(subghz_history_get_text_space_left(instance, NULL)) return false;
 
     SubGhzProtocolDecoderBase* decoder_base = context;
-    if((instance->code_last_hash_data ==
-        subghz_protocol_decoder_base_get_hash_data(decoder_base)) &&
-       ((furi_get_tick() - instance->last_update_timestamp) < 500)) {
-        instance->last_update_timestamp = furi_get_tick();
-        return false;
-    }
-
-    instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
-    instance->last_update_timestamp = furi_get_tick();
-
-    string_t text;
-    string_init(text);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzPresetDefinition));
-    item->type = decoder_base->protocol->type;
-    item->preset->frequency = preset->frequency;
-    string_init(item->preset->name);
-    string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
-
-    string_init(item->item_str);
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    FlipperFormat* flipper_string = instance->text_string;
+    stream_clean(flipper_format_get_raw_stream(flipper_string));
+    subghz_protocol_decoder_base_serialize(decoder_base, flipper_string, preset);
+
+    SubGhzHistoryRecord record = {0};
+    record.protocol = decoder_base->protocol;
+    record.frequency = preset->frequency;
+    record.timestamp = furi_get_tick();
 
+    uint8_t key_data[sizeof(uint64_t)] = {0};
+    uint32_t bits = 0;
+    if(!flipper_format_rewind(flipper_string) ||
+       !flipper_format_read_uint32(flipper_string, "Bit", &bits, 1)) {
+        FURI_LOG_E(TAG, "Missing Bit");
+    }
+    if(!flipper_format_rewind(flipper_string) ||
+       !flipper_format_read_hex(flipper_string, "Key", key_data, sizeof(uint64_t))) {
+        FURI_LOG_E(TAG, "Missing Key");
+    }
+    for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
+        record.key = (record.key << 8) | key_data[i];
+    }
+    record.bits = bits;
+
+    uint32_t hash = subghz_history_hash(&record);
+    bool result = false;
     do {
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-            FURI_LOG_E(TAG, "Missing Protocol");
-            break;
-        }
-        if(!strcmp(string_get_cstr(instance->tmp_string), "KeeLoq")) {
-            string_set_str(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
-            }
-            string_cat(instance->tmp_string, text);
-        } else if(!strcmp(string_get_cstr(instance->tmp_string), "Star Line")) {
-            string_set_str(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
-            }
-            string_cat(instance->tmp_string, text);
-        }
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
-            FURI_LOG_E(TAG, "Missing Key");
+        if(subghz_history_hash_set_contains(instance, hash)) break;
+
+        // Make room in RAM by moving the oldest record to SD
+        if(instance->last_index_write - instance->spilled == SUBGHZ_HISTORY_RAM_RECORDS &&
+           !subghz_history_spill(instance)) {
             break;
         }
-        uint64_t data = 0;
-        for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
-            data = (data << 8) | key_data[i];
-        }
-        if(!(uint32_t)(data >> 32)) {
-            string_printf(
-                item->item_str,
-                "%s %lX",
-                string_get_cstr(instance->tmp_string),
-                (uint32_t)(data & 0xFFFFFFFF));
-        } else {
-            string_printf(
-                item->item_str,
-                "%s %lX%08lX",
-                string_get_cstr(instance->tmp_string),
-                (uint32_t)(data >> 32),
-                (uint32_t)(data & 0xFFFFFFFF));
-        }
+
+        record.preset_index = subghz_history_get_preset_index(instance, preset);
+        SubGhzHistorySlot* slot =
+            &instance->slots[instance->last_index_write % SUBGHZ_HISTORY_RAM_RECORDS];
+        slot->record = record;
+        Stream* slot_stream = flipper_format_get_raw_stream(slot->flipper_string);
+        Stream* stream = flipper_format_get_raw_stream(flipper_string);
+        stream_clean(slot_stream);
+        stream_copy_full(stream, slot_stream);
+
+        instance->last_index_write++;
+        subghz_history_hash_set_add(instance, hash);
+        result = true;
     } while(false);
+    furi_mutex_release(instance->mutex);
 
-    string_clear(text);
-    instance->last_index_write++;
-    return true;
+    return result;
 }
@@ -7,6 +7,12 @@
 #include <lib/flipper_format/flipper_format.h>
 #include "helpers/subghz_types.h"
 
+/** Receive history
+ *
+ * Every capture is stored as a compact record. The latest records and their serialized data
+ * are kept in RAM, older ones are appended to temporary files on SD card. Codes already
+ * present among at least the latest 768 records are dropped.
+ */
 typedef struct SubGhzHistory SubGhzHistory;
 
 /** Allocate SubGhzHistory
@@ -35,6 +41,12 @@ void subghz_history_reset(SubGhzHistory* instance);
  */
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx);
 
+/** Get preset definition to history[idx]
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @param idx       - record index  
+ * @return SubGhzPresetDefinition* - valid until the next call
+ */
 SubGhzPresetDefinition* subghz_history_get_preset_def(SubGhzHistory* instance, uint16_t idx);
 
 /** Get preset to history[idx]
@@ -96,10 +108,11 @@ bool subghz_history_add_to_history(
     void* context,
     SubGhzPresetDefinition* preset);
 
-/** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
+/** Get serialized data to load into the protocol decoder
+ * Data is loaded from RAM or SD card on demand into a single shared FlipperFormat
  * 
  * @param instance  - SubGhzHistory instance
  * @param idx       - record index
- * @return SubGhzProtocolCommonLoad*
+ * @return FlipperFormat* - valid until the next call, NULL on read error
  */
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx);
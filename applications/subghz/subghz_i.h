@@ -57,6 +57,7 @@ struct SubGhzTxRx {
     uint8_t hopper_timeout;
     uint8_t hopper_idx_frequency;
     SubGhzRxKeyState rx_key_state;
+    bool raw_packed;
 };
 
 typedef struct SubGhzTxRx SubGhzTxRx;
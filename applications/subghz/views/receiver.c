@@ -6,29 +6,12 @@
 #include <gui/elements.h>
 #include <assets_icons.h>
 #include <m-string.h>
-#include <m-array.h>
 
 #define FRAME_HEIGHT 12
 #define MAX_LEN_PX 100
 #define MENU_ITEMS 4u
 #define UNLOCK_CNT 3
 
-typedef struct {
-    string_t item_str;
-    uint8_t type;
-} SubGhzReceiverMenuItem;
-
-ARRAY_DEF(SubGhzReceiverMenuItemArray, SubGhzReceiverMenuItem, M_POD_OPLIST)
-
-#define M_OPL_SubGhzReceiverMenuItemArray_t() \
-    ARRAY_OPLIST(SubGhzReceiverMenuItemArray, M_POD_OPLIST)
-
-struct SubGhzReceiverHistory {
-    SubGhzReceiverMenuItemArray_t data;
-};
-
-typedef struct SubGhzReceiverHistory SubGhzReceiverHistory;
-
 static const Icon* ReceiverItemIcons[] = {
     [SubGhzProtocolTypeUnknown] = &I_Quest_7x8,
     [SubGhzProtocolTypeStatic] = &I_Unlock_7x8,
@@ -49,13 +32,18 @@ struct SubGhzViewReceiver {
     View* view;
     SubGhzViewReceiverCallback callback;
     void* context;
+    SubGhzViewReceiverItemCallback item_callback;
+    void* item_context;
 };
 
 typedef struct {
     string_t frequency_str;
     string_t preset_str;
     string_t history_stat_str;
-    SubGhzReceiverHistory* history;
+    string_t item_str[MENU_ITEMS];
+    uint8_t item_type[MENU_ITEMS];
+    uint16_t item_offset;
+    uint16_t item_count;
     uint16_t idx;
     uint16_t list_offset;
     uint16_t history_item;
@@ -92,6 +80,16 @@ void subghz_view_receiver_set_callback(
     subghz_receiver->context = context;
 }
 
+void subghz_view_receiver_set_item_callback(
+    SubGhzViewReceiver* subghz_receiver,
+    SubGhzViewReceiverItemCallback callback,
+    void* context) {
+    furi_assert(subghz_receiver);
+    furi_assert(callback);
+    subghz_receiver->item_callback = callback;
+    subghz_receiver->item_context = context;
+}
+
 static void subghz_view_receiver_update_offset(SubGhzViewReceiver* subghz_receiver) {
     furi_assert(subghz_receiver);
 
@@ -108,27 +106,36 @@ static void subghz_view_receiver_update_offset(SubGhzViewReceiver* subghz_receiv
             } else if(model->list_offset > model->idx - bounds) {
                 model->list_offset = CLAMP(model->idx - 1, (int16_t)(history_item - bounds), 0);
             }
+
+            // Fetch texts of the visible items only when the window has moved
+            uint16_t item_count = MIN(model->history_item, MENU_ITEMS);
+            if(subghz_receiver->item_callback &&
+               (model->item_offset != model->list_offset || model->item_count != item_count)) {
+                for(uint16_t i = 0; i < item_count; i++) {
+                    uint16_t idx =
+                        CLAMP((uint16_t)(i + model->list_offset), model->history_item - 1, 0);
+                    subghz_receiver->item_callback(
+                        idx,
+                        model->item_str[i],
+                        &model->item_type[i],
+                        subghz_receiver->item_context);
+                }
+                model->item_offset = model->list_offset;
+                model->item_count = item_count;
+            }
             return true;
         });
 }
 
-void subghz_view_receiver_add_item_to_menu(
-    SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    uint8_t type) {
+void subghz_view_receiver_set_item_count(SubGhzViewReceiver* subghz_receiver, uint16_t count) {
     furi_assert(subghz_receiver);
     with_view_model(
         subghz_receiver->view, (SubGhzViewReceiverModel * model) {
-            SubGhzReceiverMenuItem* item_menu =
-                SubGhzReceiverMenuItemArray_push_raw(model->history->data);
-            string_init_set_str(item_menu->item_str, name);
-            item_menu->type = type;
-            if((model->idx == model->history_item - 1)) {
-                model->history_item++;
-                model->idx++;
-            } else {
-                model->history_item++;
+            // Follow the new items if the last one was selected
+            if(model->history_item && (model->idx == model->history_item - 1)) {
+                model->idx = count - 1;
             }
+            model->history_item = count;
 
             return true;
         });
@@ -176,19 +183,16 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
     string_t str_buff;
     string_init(str_buff);
 
-    SubGhzReceiverMenuItem* item_menu;
-
-    for(size_t i = 0; i < MIN(model->history_item, MENU_ITEMS); ++i) {
-        size_t idx = CLAMP((uint16_t)(i + model->list_offset), model->history_item, 0);
-        item_menu = SubGhzReceiverMenuItemArray_get(model->history->data, idx);
-        string_set(str_buff, item_menu->item_str);
+    for(size_t i = 0; i < model->item_count; ++i) {
+        size_t idx = i + model->item_offset;
+        string_set(str_buff, model->item_str[i]);
         elements_string_fit_width(canvas, str_buff, scrollbar ? MAX_LEN_PX - 6 : MAX_LEN_PX);
         if(model->idx == idx) {
             subghz_view_receiver_draw_frame(canvas, i, scrollbar);
         } else {
             canvas_set_color(canvas, ColorBlack);
         }
-        canvas_draw_icon(canvas, 1, 2 + i * FRAME_HEIGHT, ReceiverItemIcons[item_menu->type]);
+        canvas_draw_icon(canvas, 1, 2 + i * FRAME_HEIGHT, ReceiverItemIcons[model->item_type[i]]);
         canvas_draw_str(canvas, 15, 9 + i * FRAME_HEIGHT, string_get_cstr(str_buff));
         string_reset(str_buff);
     }
@@ -334,16 +338,12 @@ void subghz_view_receiver_exit(void* context) {
             string_reset(model->frequency_str);
             string_reset(model->preset_str);
             string_reset(model->history_stat_str);
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        string_clear(item_menu->item_str);
-                        item_menu->type = 0;
-                    }
-                SubGhzReceiverMenuItemArray_reset(model->history->data);
-                model->idx = 0;
-                model->list_offset = 0;
-                model->history_item = 0;
-                return false;
+            model->item_offset = 0;
+            model->item_count = 0;
+            model->idx = 0;
+            model->list_offset = 0;
+            model->history_item = 0;
+            return false;
         });
     furi_timer_stop(subghz_receiver->timer);
 }
@@ -370,8 +370,9 @@ SubGhzViewReceiver* subghz_view_receiver_alloc() {
             string_init(model->preset_str);
             string_init(model->history_stat_str);
             model->bar_show = SubGhzViewReceiverBarShowDefault;
-            model->history = malloc(sizeof(SubGhzReceiverHistory));
-            SubGhzReceiverMenuItemArray_init(model->history->data);
+            for(size_t i = 0; i < MENU_ITEMS; i++) {
+                string_init(model->item_str[i]);
+            }
             return true;
         });
     subghz_receiver->timer =
@@ -387,14 +388,10 @@ void subghz_view_receiver_free(SubGhzViewReceiver* subghz_receiver) {
             string_clear(model->frequency_str);
             string_clear(model->preset_str);
             string_clear(model->history_stat_str);
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        string_clear(item_menu->item_str);
-                        item_menu->type = 0;
-                    }
-                SubGhzReceiverMenuItemArray_clear(model->history->data);
-                free(model->history);
-                return false;
+            for(size_t i = 0; i < MENU_ITEMS; i++) {
+                string_clear(model->item_str[i]);
+            }
+            return false;
         });
     furi_timer_free(subghz_receiver->timer);
     view_free(subghz_receiver->view);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <gui/view.h>
+#include <m-string.h>
 #include "../helpers/subghz_types.h"
 #include "../helpers/subghz_custom_event.h"
 
@@ -8,6 +9,15 @@ typedef struct SubGhzViewReceiver SubGhzViewReceiver;
 
 typedef void (*SubGhzViewReceiverCallback)(SubGhzCustomEvent event, void* context);
 
+/** Item callback, fills menu text and protocol type of item idx
+ * Called only for the visible items, so the view does not keep a copy of the whole list
+ */
+typedef void (*SubGhzViewReceiverItemCallback)(
+    uint16_t idx,
+    string_t text,
+    uint8_t* type,
+    void* context);
+
 void subghz_view_receiver_set_lock(SubGhzViewReceiver* subghz_receiver, SubGhzLock keyboard);
 
 void subghz_view_receiver_set_callback(
@@ -15,6 +25,11 @@ void subghz_view_receiver_set_callback(
     SubGhzViewReceiverCallback callback,
     void* context);
 
+void subghz_view_receiver_set_item_callback(
+    SubGhzViewReceiver* subghz_receiver,
+    SubGhzViewReceiverItemCallback callback,
+    void* context);
+
 SubGhzViewReceiver* subghz_view_receiver_alloc();
 
 void subghz_view_receiver_free(SubGhzViewReceiver* subghz_receiver);
@@ -27,10 +42,7 @@ void subghz_view_receiver_add_data_statusbar(
     const char* preset_str,
     const char* history_stat_str);
 
-void subghz_view_receiver_add_item_to_menu(
-    SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    uint8_t type);
+void subghz_view_receiver_set_item_count(SubGhzViewReceiver* subghz_receiver, uint16_t count);
 
 uint16_t subghz_view_receiver_get_idx_menu(SubGhzViewReceiver* subghz_receiver);
 
@@ -0,0 +1,229 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <toolbox/stream/string_stream.h>
+#include <applications/bad_usb/ducky_bytecode.h>
+#include "../minunit.h"
+
+#define TAG "BadUsbTest"
+
+#define BAD_USB_TEST_EVENTS_MAX 1024
+#define BAD_USB_TEST_DELAYS_MAX 64
+#define BAD_USB_TEST_BENCH_LINES 16
+// HID_INTERVAL of furi_hal_usb_hid, one keyboard report per interval
+#define BAD_USB_TEST_REPORT_INTERVAL_MS 2
+
+typedef struct {
+    uint8_t mods;
+    uint8_t keys[DUCKY_HID_KEYS_MAX];
+    uint8_t count;
+    size_t report_count;
+    // Key press events as host sees them: modifiers in high byte
+    uint16_t events[BAD_USB_TEST_EVENTS_MAX];
+    size_t event_count;
+    int32_t delays[BAD_USB_TEST_DELAYS_MAX];
+    size_t delay_count;
+} BadUsbTestHid;
+
+static const char bad_usb_test_script[] = {
+    "ID 1234:abcd Flipper:Test\n"
+    "REM comment\n"
+    "DEFAULT_DELAY 10\n"
+    "STRING Hello, World! aaa AAA 0123456789 ~!@#$%^&*()_+\n"
+    "ENTER\n"
+    "\n"
+    "DELAY 500\n"
+    "CTRL-ALT DELETE\n"
+    "GUI r\n"
+    "STRING The quick brown fox jumps over the lazy dog\r\n"
+    "REPEAT 3\n"
+    "ALTCHAR 65\n"
+    "ALTSTRING Zz\n"
+    "STRING no line end"};
+
+static const char bad_usb_test_rollover_line[] = {"STRING Hello, World! aaa AAA\n"};
+
+static const char bad_usb_test_bench_line[] = {
+    "STRING Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor\n"};
+
+static bool
+    bad_usb_test_kb_report(void* context, uint8_t mods, const uint8_t* keys, uint8_t count) {
+    BadUsbTestHid* hid = context;
+    furi_check(count <= DUCKY_HID_KEYS_MAX);
+
+    // Keys that were not pressed in the previous report are pressed in report order
+    for(uint8_t i = 0; i < count; i++) {
+        if(memchr(hid->keys, keys[i], hid->count) == NULL &&
+           hid->event_count < BAD_USB_TEST_EVENTS_MAX) {
+            hid->events[hid->event_count++] = (mods << 8) | keys[i];
+        }
+    }
+
+    hid->mods = mods;
+    if(count > 0) memcpy(hid->keys, keys, count);
+    hid->count = count;
+    hid->report_count++;
+    return true;
+}
+
+static uint8_t bad_usb_test_get_led_state(void* context) {
+    UNUSED(context);
+    return 0;
+}
+
+static const DuckyHidSink bad_usb_test_sink = {
+    .kb_report = bad_usb_test_kb_report,
+    .get_led_state = bad_usb_test_get_led_state,
+};
+
+static bool bad_usb_test_compile(DuckyBytecode* bytecode, const char* script) {
+    Stream* stream = string_stream_alloc();
+    stream_write_cstring(stream, script);
+    stream_rewind(stream);
+    bool result = ducky_bytecode_compile(bytecode, stream);
+    stream_free(stream);
+    return result;
+}
+
+static int32_t bad_usb_test_run(const char* script, BadUsbTestHid* hid, bool rollover) {
+    DuckyBytecode* bytecode = ducky_bytecode_alloc(&bad_usb_test_sink, hid);
+    ducky_bytecode_set_rollover(bytecode, rollover);
+    memset(hid, 0, sizeof(BadUsbTestHid));
+
+    int32_t delay_val = SCRIPT_STATE_ERROR;
+    if(bad_usb_test_compile(bytecode, script)) {
+        do {
+            delay_val = ducky_bytecode_execute_next(bytecode);
+            if(hid->delay_count < BAD_USB_TEST_DELAYS_MAX) {
+                hid->delays[hid->delay_count++] = delay_val;
+            }
+        } while(delay_val >= 0);
+    }
+
+    ducky_bytecode_free(bytecode);
+    return delay_val;
+}
+
+MU_TEST(bad_usb_compile_test) {
+    FuriHalUsbHidConfig hid_cfg;
+    BadUsbTestHid* hid = malloc(sizeof(BadUsbTestHid));
+    DuckyBytecode* bytecode = ducky_bytecode_alloc(&bad_usb_test_sink, hid);
+
+    mu_assert(bad_usb_test_compile(bytecode, bad_usb_test_script), "compile failed");
+    mu_assert_int_eq(13, ducky_bytecode_get_line_count(bytecode));
+    mu_assert(ducky_bytecode_get_usb_id(bytecode, &hid_cfg), "ID not found");
+    mu_assert(hid_cfg.vid == 0x1234 && hid_cfg.pid == 0xABCD, "wrong vid or pid");
+    mu_assert_string_eq("Flipper", hid_cfg.manuf);
+    mu_assert_string_eq("Test", hid_cfg.product);
+
+    mu_assert(!bad_usb_test_compile(bytecode, "\n\n"), "empty script compiled");
+
+    // Parse errors are reported when execution reaches them
+    mu_assert(bad_usb_test_compile(bytecode, "STRING a\nUNKNOWN\nSTRING b\n"), "compile failed");
+    mu_assert(ducky_bytecode_execute_next(bytecode) >= 0, "first line failed");
+    mu_assert_int_eq(SCRIPT_STATE_ERROR, ducky_bytecode_execute_next(bytecode));
+    mu_assert_int_eq(2, ducky_bytecode_get_error_line(bytecode));
+
+    mu_assert(bad_usb_test_compile(bytecode, "REPEAT 2\n"), "compile failed");
+    mu_assert_int_eq(SCRIPT_STATE_ERROR, ducky_bytecode_execute_next(bytecode));
+    mu_assert_int_eq(1, ducky_bytecode_get_error_line(bytecode));
+
+    ducky_bytecode_free(bytecode);
+    free(hid);
+}
+
+MU_TEST(bad_usb_rollover_test) {
+    BadUsbTestHid* hid_single = malloc(sizeof(BadUsbTestHid));
+    BadUsbTestHid* hid_rollover = malloc(sizeof(BadUsbTestHid));
+
+    mu_assert_int_eq(SCRIPT_STATE_END, bad_usb_test_run(bad_usb_test_script, hid_single, false));
+    mu_assert_int_eq(
+        SCRIPT_STATE_END, bad_usb_test_run(bad_usb_test_script, hid_rollover, true));
+
+    mu_assert_int_eq(hid_single->event_count, hid_rollover->event_count);
+    mu_assert(
+        memcmp(
+            hid_single->events,
+            hid_rollover->events,
+            hid_single->event_count * sizeof(uint16_t)) == 0,
+        "typed keys mismatch");
+    mu_assert_int_eq(hid_single->delay_count, hid_rollover->delay_count);
+    mu_assert(
+        memcmp(
+            hid_single->delays,
+            hid_rollover->delays,
+            hid_single->delay_count * sizeof(int32_t)) == 0,
+        "line delays mismatch");
+    mu_assert(hid_rollover->report_count < hid_single->report_count, "no reports saved");
+
+    free(hid_rollover);
+    free(hid_single);
+}
+
+MU_TEST(bad_usb_rollover_command_test) {
+    BadUsbTestHid* hid_command = malloc(sizeof(BadUsbTestHid));
+    BadUsbTestHid* hid_setting = malloc(sizeof(BadUsbTestHid));
+    string_t script;
+    string_init(script);
+
+    // Script command overrides the default set by the app
+    for(uint8_t enable = 0; enable < 2; enable++) {
+        string_printf(
+            script, "ROLLOVER %s\n%s", enable ? "ON" : "OFF", bad_usb_test_rollover_line);
+        mu_assert_int_eq(
+            SCRIPT_STATE_END, bad_usb_test_run(string_get_cstr(script), hid_command, !enable));
+        mu_assert_int_eq(
+            SCRIPT_STATE_END, bad_usb_test_run(bad_usb_test_rollover_line, hid_setting, enable));
+        mu_assert_int_eq(hid_setting->report_count, hid_command->report_count);
+        mu_assert_int_eq(hid_setting->event_count, hid_command->event_count);
+    }
+
+    mu_assert_int_eq(SCRIPT_STATE_ERROR, bad_usb_test_run("ROLLOVER MAYBE\n", hid_command, true));
+
+    string_clear(script);
+    free(hid_setting);
+    free(hid_command);
+}
+
+MU_TEST(bad_usb_benchmark_test) {
+    BadUsbTestHid* hid = malloc(sizeof(BadUsbTestHid));
+    size_t line_len = strlen(bad_usb_test_bench_line);
+    char* script = malloc(line_len * BAD_USB_TEST_BENCH_LINES + 1);
+    for(size_t i = 0; i < BAD_USB_TEST_BENCH_LINES; i++) {
+        memcpy(&script[i * line_len], bad_usb_test_bench_line, line_len);
+    }
+    script[line_len * BAD_USB_TEST_BENCH_LINES] = '\0';
+    size_t chars = (line_len - strlen("STRING \n")) * BAD_USB_TEST_BENCH_LINES;
+
+    mu_assert_int_eq(SCRIPT_STATE_END, bad_usb_test_run(script, hid, false));
+    size_t reports_single = hid->report_count;
+    mu_assert_int_eq(SCRIPT_STATE_END, bad_usb_test_run(script, hid, true));
+    size_t reports_rollover = hid->report_count;
+
+    uint32_t speed_single = chars * 1000 / (reports_single * BAD_USB_TEST_REPORT_INTERVAL_MS);
+    uint32_t speed_rollover =
+        chars * 1000 / (reports_rollover * BAD_USB_TEST_REPORT_INTERVAL_MS);
+    FURI_LOG_I(
+        TAG,
+        "%u chars: single key %u reports %lu chars/s, rollover %u reports %lu chars/s",
+        chars,
+        reports_single,
+        speed_single,
+        reports_rollover,
+        speed_rollover);
+    mu_assert(speed_rollover > speed_single * 2, "rollover is too slow");
+
+    free(script);
+    free(hid);
+}
+
+MU_TEST_SUITE(bad_usb) {
+    MU_RUN_TEST(bad_usb_compile_test);
+    MU_RUN_TEST(bad_usb_rollover_test);
+    MU_RUN_TEST(bad_usb_rollover_command_test);
+    MU_RUN_TEST(bad_usb_benchmark_test);
+}
+
+int run_minunit_test_bad_usb() {
+    MU_RUN_SUITE(bad_usb);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,141 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <micro-ecc/uECC.h>
+#include "../minunit.h"
+
+#define TAG "EccTest"
+
+#define ECC_TEST_KEYS 16
+#define ECC_TEST_BENCH_ROUNDS 8
+
+// secp256r1 generator, uncompressed point without 0x04 prefix
+static const uint8_t ecc_test_g[64] = {
+    0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63,
+    0xA4, 0x40, 0xF2, 0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1,
+    0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96, 0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F,
+    0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16, 0x2B, 0xCE, 0x33, 0x57,
+    0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5,
+};
+
+// secp256r1 group order minus one
+static const uint8_t ecc_test_n_minus_1[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x50,
+};
+
+// RFC 6979 A.2.5 key pair
+static const uint8_t ecc_test_private[32] = {
+    0xC9, 0xAF, 0xA9, 0xD8, 0x45, 0xBA, 0x75, 0x16, 0x6B, 0x5C, 0x21, 0x57, 0x67, 0xB1, 0xD6, 0x93,
+    0x4E, 0x50, 0xC3, 0xDB, 0x36, 0xE8, 0x9B, 0x12, 0x7B, 0x8A, 0x62, 0x2B, 0x12, 0x0F, 0x67, 0x21,
+};
+
+static const uint8_t ecc_test_public[64] = {
+    0x60, 0xFE, 0xD4, 0xBA, 0x25, 0x5A, 0x9D, 0x31, 0xC9, 0x61, 0xEB, 0x74, 0xC6,
+    0x35, 0x6D, 0x68, 0xC0, 0x49, 0xB8, 0x92, 0x3B, 0x61, 0xFA, 0x6C, 0xE6, 0x69,
+    0x62, 0x2E, 0x60, 0xF2, 0x9F, 0xB6, 0x79, 0x03, 0xFE, 0x10, 0x08, 0xB8, 0xBC,
+    0x99, 0xA4, 0x1A, 0xE9, 0xE9, 0x56, 0x28, 0xBC, 0x64, 0xF2, 0xF1, 0xB2, 0x0C,
+    0x2D, 0x7E, 0x9F, 0x51, 0x77, 0xA3, 0xC2, 0x94, 0xD4, 0x46, 0x22, 0x99,
+};
+
+static int ecc_test_random(uint8_t* dest, unsigned size) {
+    furi_hal_random_fill_buf(dest, size);
+    return 1;
+}
+
+MU_TEST(ecc_public_key_test) {
+    const struct uECC_Curve_t* curve = uECC_secp256r1();
+    uint8_t public_key[64];
+
+    mu_assert(uECC_compute_public_key(ecc_test_private, public_key, curve), "compute failed");
+    mu_assert(
+        memcmp(public_key, ecc_test_public, sizeof(public_key)) == 0,
+        "RFC 6979 public key mismatch");
+
+    // Edge scalars: 1 and n - 1
+    uint8_t private_key[32] = {0};
+    private_key[31] = 1;
+    mu_assert(uECC_compute_public_key(private_key, public_key, curve), "compute 1 failed");
+    mu_assert(memcmp(public_key, ecc_test_g, sizeof(public_key)) == 0, "1 * G mismatch");
+
+    mu_assert(
+        uECC_compute_public_key(ecc_test_n_minus_1, public_key, curve), "compute n - 1 failed");
+    mu_assert(memcmp(public_key, ecc_test_g, 32) == 0, "(n - 1) * G x mismatch");
+    mu_assert(memcmp(public_key + 32, ecc_test_g + 32, 32) != 0, "(n - 1) * G y mismatch");
+}
+
+MU_TEST(ecc_cross_check_test) {
+    const struct uECC_Curve_t* curve = uECC_secp256r1();
+    uint8_t private_key[32];
+    uint8_t public_key[64];
+    uint8_t secret[32];
+    uint8_t hash[32];
+    uint8_t signature[64];
+
+    for(size_t i = 0; i < ECC_TEST_KEYS; i++) {
+        furi_hal_random_fill_buf(private_key, sizeof(private_key));
+        furi_hal_random_fill_buf(hash, sizeof(hash));
+        private_key[0] &= 0x7F;
+
+        mu_assert(uECC_compute_public_key(private_key, public_key, curve), "compute failed");
+        mu_assert(uECC_valid_public_key(public_key, curve), "invalid public key");
+
+        // Variable base ladder gives the x coordinate of private_key * G
+        mu_assert(uECC_shared_secret(ecc_test_g, private_key, secret, curve), "ladder failed");
+        mu_assert(memcmp(public_key, secret, sizeof(secret)) == 0, "ladder mismatch");
+
+        mu_assert(uECC_sign(private_key, hash, sizeof(hash), signature, curve), "sign failed");
+        mu_assert(
+            uECC_verify(public_key, hash, sizeof(hash), signature, curve), "verify failed");
+    }
+}
+
+MU_TEST(ecc_benchmark_test) {
+    const struct uECC_Curve_t* curve = uECC_secp256r1();
+    uint8_t private_key[32];
+    uint8_t public_key[64];
+    uint8_t secret[32];
+    uint8_t hash[32] = {0};
+    uint8_t signature[64];
+
+    furi_hal_random_fill_buf(private_key, sizeof(private_key));
+    private_key[0] &= 0x7F;
+
+    uint32_t time = DWT->CYCCNT;
+    for(size_t i = 0; i < ECC_TEST_BENCH_ROUNDS; i++) {
+        uECC_compute_public_key(private_key, public_key, curve);
+    }
+    time = (DWT->CYCCNT - time) / furi_hal_cortex_instructions_per_microsecond();
+
+    uint32_t time_sign = DWT->CYCCNT;
+    for(size_t i = 0; i < ECC_TEST_BENCH_ROUNDS; i++) {
+        uECC_sign(private_key, hash, sizeof(hash), signature, curve);
+    }
+    time_sign = (DWT->CYCCNT - time_sign) / furi_hal_cortex_instructions_per_microsecond();
+
+    uint32_t time_ladder = DWT->CYCCNT;
+    for(size_t i = 0; i < ECC_TEST_BENCH_ROUNDS; i++) {
+        uECC_shared_secret(ecc_test_g, private_key, secret, curve);
+    }
+    time_ladder = (DWT->CYCCNT - time_ladder) / furi_hal_cortex_instructions_per_microsecond();
+
+    FURI_LOG_I(
+        TAG,
+        "k * G: public key %lu us, sign %lu us, variable base ladder %lu us",
+        time / ECC_TEST_BENCH_ROUNDS,
+        time_sign / ECC_TEST_BENCH_ROUNDS,
+        time_ladder / ECC_TEST_BENCH_ROUNDS);
+    mu_assert(time < time_ladder, "fixed base is slower than ladder");
+}
+
+MU_TEST_SUITE(ecc) {
+    uECC_set_rng(ecc_test_random);
+
+    MU_RUN_TEST(ecc_public_key_test);
+    MU_RUN_TEST(ecc_cross_check_test);
+    MU_RUN_TEST(ecc_benchmark_test);
+}
+
+int run_minunit_test_ecc() {
+    MU_RUN_SUITE(ecc);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,157 @@
+#include <string.h>
+#include <furi.h>
+#include <furi_hal.h>
+#include "../minunit.h"
+
+#define TAG "LogTest"
+#define FURI_LOG_TEST_TIMESTAMP 1234
+#define FURI_LOG_TEST_TIMEOUT_MS 1000
+// Enough records to go around the 4 KB ring several times
+#define FURI_LOG_TEST_WRAP_ROUNDS 64
+// Records logged without letting the log thread run, more than the ring holds
+#define FURI_LOG_TEST_FLOOD 256
+
+static FuriMutex* furi_log_test_mutex;
+static string_t furi_log_test_output;
+static volatile uint32_t furi_log_test_records;
+static volatile bool furi_log_test_dropped_reported;
+
+// 62 characters, longer than strings kept in deferred records
+static const char furi_log_test_long_str[] = {
+    "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"};
+
+static void furi_log_test_puts(const char* data) {
+    furi_check(furi_mutex_acquire(furi_log_test_mutex, FuriWaitForever) == FuriStatusOk);
+    string_cat_str(furi_log_test_output, data);
+    if(strstr(data, "[" TAG "]")) furi_log_test_records++;
+    if(strstr(data, "log records dropped")) furi_log_test_dropped_reported = true;
+    furi_check(furi_mutex_release(furi_log_test_mutex) == FuriStatusOk);
+}
+
+static uint32_t furi_log_test_timestamp(void) {
+    return FURI_LOG_TEST_TIMESTAMP;
+}
+
+static void furi_log_test_reset(void) {
+    furi_check(furi_mutex_acquire(furi_log_test_mutex, FuriWaitForever) == FuriStatusOk);
+    string_reset(furi_log_test_output);
+    furi_log_test_records = 0;
+    furi_log_test_dropped_reported = false;
+    furi_check(furi_mutex_release(furi_log_test_mutex) == FuriStatusOk);
+}
+
+static bool furi_log_test_wait(uint32_t records) {
+    uint32_t start = furi_get_tick();
+    while(furi_log_test_records < records) {
+        if(furi_get_tick() - start > FURI_LOG_TEST_TIMEOUT_MS) return false;
+        furi_delay_ms(1);
+    }
+    return true;
+}
+
+/* Take lines of this test out of the captured output, other threads may log meanwhile */
+static void furi_log_test_take_lines(string_t lines) {
+    string_t line;
+    string_init(line);
+    string_reset(lines);
+
+    furi_check(furi_mutex_acquire(furi_log_test_mutex, FuriWaitForever) == FuriStatusOk);
+    const char* p = string_get_cstr(furi_log_test_output);
+    while(*p) {
+        const char* end = strstr(p, "\r\n");
+        size_t len = end ? (size_t)(end - p + 2) : strlen(p);
+        string_set_strn(line, p, len);
+        if(strstr(string_get_cstr(line), "[" TAG "]")) string_cat(lines, line);
+        p += len;
+    }
+    string_reset(furi_log_test_output);
+    furi_check(furi_mutex_release(furi_log_test_mutex) == FuriStatusOk);
+
+    string_clear(line);
+}
+
+static uint32_t furi_log_test_print(bool deferred) {
+    FURI_LOG_I(TAG, "%s|", "string");
+    FURI_LOG_I(TAG, "%.*s|", 4, "precision");
+    FURI_LOG_I(TAG, "%*d|%-*d|", 6, -42, 5, 7);
+    FURI_LOG_I(TAG, "%lld|%llu|", -1234567890123LL, 0xFEDCBA9876543210ULL);
+    FURI_LOG_I(TAG, "%f|%.2e|", 3.25, -0.001);
+    FURI_LOG_I(TAG, "%-8lu|%08lX|", 42UL, 0xBEEFUL);
+    // Deferred records keep up to 48 string characters
+    if(deferred) {
+        FURI_LOG_I(TAG, "%s|", furi_log_test_long_str);
+    } else {
+        FURI_LOG_I(TAG, "%.48s|", furi_log_test_long_str);
+    }
+    return 7;
+}
+
+static void furi_log_test_formats(string_t lines_sync, string_t lines_deferred) {
+    furi_log_set_deferred(false);
+    furi_log_test_reset();
+    uint32_t records = furi_log_test_print(false);
+    furi_log_test_take_lines(lines_sync);
+
+    // Every round is drained before the next one, so the ring wraps without drops
+    furi_log_set_deferred(true);
+    uint32_t dropped = furi_log_get_dropped();
+    for(size_t i = 0; i < FURI_LOG_TEST_WRAP_ROUNDS; i++) {
+        furi_log_test_reset();
+        furi_log_test_print(true);
+        mu_assert(furi_log_test_wait(records), "deferred records not printed");
+        furi_log_test_take_lines(lines_deferred);
+        mu_assert_string_eq(string_get_cstr(lines_sync), string_get_cstr(lines_deferred));
+    }
+    mu_assert_int_eq(dropped, furi_log_get_dropped());
+}
+
+static void furi_log_test_flood(void) {
+    furi_log_set_deferred(true);
+    furi_log_test_reset();
+    uint32_t dropped = furi_log_get_dropped();
+
+    for(size_t i = 0; i < FURI_LOG_TEST_FLOOD; i++) {
+        FURI_LOG_I(TAG, "%u %s", i, furi_log_test_long_str);
+    }
+    uint32_t flood_dropped = furi_log_get_dropped() - dropped;
+    mu_assert(flood_dropped > 0, "full ring didn't drop records");
+    mu_assert(flood_dropped < FURI_LOG_TEST_FLOOD, "empty ring dropped records");
+
+    mu_assert(furi_log_test_wait(FURI_LOG_TEST_FLOOD - flood_dropped), "records not printed");
+    uint32_t start = furi_get_tick();
+    while(!furi_log_test_dropped_reported &&
+          furi_get_tick() - start < FURI_LOG_TEST_TIMEOUT_MS) {
+        furi_delay_ms(1);
+    }
+    mu_assert(furi_log_test_dropped_reported, "dropped records not reported");
+}
+
+void test_furi_log() {
+    FuriLogLevel level = furi_log_get_level();
+    bool deferred = furi_log_is_deferred();
+    string_t lines_sync;
+    string_t lines_deferred;
+    string_init(lines_sync);
+    string_init(lines_deferred);
+    string_init(furi_log_test_output);
+    furi_log_test_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+
+    furi_log_set_level(FuriLogLevelInfo);
+    furi_log_set_timestamp(furi_log_test_timestamp);
+    furi_log_set_puts(furi_log_test_puts);
+
+    furi_log_test_formats(lines_sync, lines_deferred);
+    if(!minunit_status) furi_log_test_flood();
+
+    furi_log_set_deferred(deferred);
+    furi_log_set_puts(furi_hal_console_puts);
+    furi_log_set_timestamp(furi_get_tick);
+    furi_log_set_level(level);
+    // Let calls that already took the capturing puts finish before it is freed
+    furi_delay_ms(10);
+
+    furi_mutex_free(furi_log_test_mutex);
+    string_clear(furi_log_test_output);
+    string_clear(lines_deferred);
+    string_clear(lines_sync);
+}
@@ -11,6 +11,8 @@ void test_furi_pubsub();
 
 void test_furi_memmgr();
 
+void test_furi_log();
+
 static int foo = 0;
 
 void test_setup(void) {
@@ -44,6 +46,10 @@ MU_TEST(mu_test_furi_memmgr) {
     test_furi_memmgr();
 }
 
+MU_TEST(mu_test_furi_log) {
+    test_furi_log();
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -54,6 +60,7 @@ MU_TEST_SUITE(test_suite) {
     MU_RUN_TEST(mu_test_furi_valuemutex);
     MU_RUN_TEST(mu_test_furi_pubsub);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_log);
 }
 
 int run_minunit_test_furi() {
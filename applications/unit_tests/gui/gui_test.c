@@ -0,0 +1,210 @@
+#include <furi.h>
+#include <gui/canvas_i.h>
+#include "../minunit.h"
+
+#define TAG "GuiTest"
+
+#define GUI_TEST_PAGES 8
+// ST7565 display RAM is 132 columns wide
+#define GUI_TEST_COLUMNS 132
+#define GUI_TEST_PAGE_SIZE 128
+// Page and column address commands in front of every page
+#define GUI_TEST_FULL_FRAME_BYTES (GUI_TEST_PAGES * (3 + GUI_TEST_PAGE_SIZE))
+
+/** Display controller model behind a mock SPI bus */
+typedef struct {
+    uint8_t ram[GUI_TEST_PAGES][GUI_TEST_COLUMNS];
+    uint8_t page;
+    uint8_t column;
+    bool data;
+    size_t bytes;
+    size_t transfers;
+} GuiTestDisplay;
+
+typedef struct {
+    const char* name;
+    uint8_t minute;
+    uint8_t selected;
+    uint8_t scroll;
+    bool fullscreen;
+} GuiTestFrame;
+
+static const char* const gui_test_menu[] = {
+    "Sub-GHz",
+    "125 kHz RFID",
+    "NFC",
+    "Infrared",
+    "GPIO",
+    "iButton",
+    "Bad USB",
+};
+
+// View sequence as GUI draws it: menu navigation, status bar clock ticks, then a new view
+static const GuiTestFrame gui_test_script[] = {
+    {"menu", 0, 0, 0, false},
+    {"idle", 0, 0, 0, false},
+    {"clock", 1, 0, 0, false},
+    {"down", 1, 1, 0, false},
+    {"down", 1, 2, 0, false},
+    {"scroll", 1, 3, 1, false},
+    {"clock", 2, 3, 1, false},
+    {"view", 2, 3, 1, true},
+};
+
+static GuiTestDisplay* gui_test_display;
+
+static void gui_test_display_cmd(GuiTestDisplay* display, uint8_t cmd) {
+    if((cmd & 0xF0) == 0x10) {
+        display->column = (display->column & 0x0F) | ((cmd & 0x0F) << 4);
+    } else if((cmd & 0xF0) == 0x00) {
+        display->column = (display->column & 0xF0) | (cmd & 0x0F);
+    } else if((cmd & 0xF0) == 0xB0) {
+        display->page = cmd & 0x0F;
+    }
+}
+
+static uint8_t gui_test_spi(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    UNUSED(u8x8);
+    GuiTestDisplay* display = gui_test_display;
+    uint8_t* bytes = arg_ptr;
+
+    switch(msg) {
+    case U8X8_MSG_BYTE_SEND:
+        for(uint8_t i = 0; i < arg_int; i++) {
+            if(!display->data) {
+                gui_test_display_cmd(display, bytes[i]);
+            } else if(display->page < GUI_TEST_PAGES && display->column < GUI_TEST_COLUMNS) {
+                display->ram[display->page][display->column++] = bytes[i];
+            }
+        }
+        display->bytes += arg_int;
+        break;
+    case U8X8_MSG_BYTE_SET_DC:
+        display->data = arg_int;
+        break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+        display->transfers++;
+        break;
+    case U8X8_MSG_BYTE_INIT:
+    case U8X8_MSG_BYTE_END_TRANSFER:
+        break;
+    default:
+        return 0;
+    }
+
+    return 1;
+}
+
+static uint8_t gui_test_gpio_and_delay(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    UNUSED(u8x8);
+    UNUSED(msg);
+    UNUSED(arg_int);
+    UNUSED(arg_ptr);
+    return 1;
+}
+
+static void gui_test_draw(Canvas* canvas, const GuiTestFrame* frame) {
+    char clock[8];
+    snprintf(clock, sizeof(clock), "12:%02u", frame->minute);
+
+    canvas_reset(canvas);
+    canvas_frame_set(canvas, 0, 0, GUI_TEST_PAGE_SIZE, GUI_TEST_PAGES * 8);
+
+    // Status bar
+    canvas_draw_line(canvas, 0, 11, 127, 11);
+    canvas_draw_str_aligned(canvas, 127, 1, AlignRight, AlignTop, clock);
+    canvas_draw_frame(canvas, 0, 1, 16, 8);
+
+    if(frame->fullscreen) {
+        canvas_set_font(canvas, FontBigNumbers);
+        canvas_draw_str_aligned(canvas, 64, 38, AlignCenter, AlignCenter, clock);
+        canvas_draw_frame(canvas, 0, 14, 128, 50);
+        return;
+    }
+
+    canvas_set_font(canvas, FontPrimary);
+    for(uint8_t i = 0; i < 4; i++) {
+        uint8_t item = frame->scroll + i;
+        uint8_t y = 14 + i * 12;
+        if(item == frame->selected) {
+            canvas_draw_box(canvas, 0, y, 124, 12);
+            canvas_set_color(canvas, ColorWhite);
+        }
+        canvas_draw_str(canvas, 4, y + 10, gui_test_menu[item]);
+        canvas_set_color(canvas, ColorBlack);
+    }
+    // Scroll bar
+    canvas_draw_box(canvas, 125, 14 + frame->scroll * 8, 3, 26);
+}
+
+static bool gui_test_display_match(Canvas* canvas, GuiTestDisplay* display) {
+    uint8_t* buffer = canvas_get_buffer(canvas);
+    for(size_t page = 0; page < GUI_TEST_PAGES; page++) {
+        if(memcmp(display->ram[page], &buffer[page * GUI_TEST_PAGE_SIZE], GUI_TEST_PAGE_SIZE) !=
+           0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+MU_TEST(gui_canvas_commit_test) {
+    GuiTestDisplay* display = malloc(sizeof(GuiTestDisplay));
+    memset(display, 0, sizeof(GuiTestDisplay));
+    gui_test_display = display;
+
+    Canvas* canvas = canvas_init_ex(gui_test_spi, gui_test_gpio_and_delay);
+    mu_assert_int_eq(GUI_TEST_PAGES * GUI_TEST_PAGE_SIZE, canvas_get_buffer_size(canvas));
+    mu_assert(gui_test_display_match(canvas, display), "display not cleared on init");
+
+    size_t total_bytes = 0;
+    for(size_t i = 0; i < COUNT_OF(gui_test_script); i++) {
+        const GuiTestFrame* frame = &gui_test_script[i];
+        display->bytes = 0;
+        display->transfers = 0;
+
+        gui_test_draw(canvas, frame);
+        canvas_commit(canvas);
+
+        FURI_LOG_I(
+            TAG,
+            "frame %u %s: %u bytes in %u transfers, full frame %u bytes",
+            i,
+            frame->name,
+            display->bytes,
+            display->transfers,
+            GUI_TEST_FULL_FRAME_BYTES);
+        total_bytes += display->bytes;
+
+        mu_assert(gui_test_display_match(canvas, display), "display RAM mismatch");
+        mu_assert(display->bytes <= GUI_TEST_FULL_FRAME_BYTES, "more than a full frame sent");
+        if(strcmp(frame->name, "idle") == 0) {
+            mu_assert_int_eq(0, display->bytes);
+        } else if(strcmp(frame->name, "clock") == 0) {
+            mu_assert(display->bytes < GUI_TEST_FULL_FRAME_BYTES / 8, "clock tick is too big");
+        }
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "%u frames: %u bytes sent, %u bytes with full frames",
+        COUNT_OF(gui_test_script),
+        total_bytes,
+        COUNT_OF(gui_test_script) * GUI_TEST_FULL_FRAME_BYTES);
+    mu_assert(
+        total_bytes * 2 < COUNT_OF(gui_test_script) * GUI_TEST_FULL_FRAME_BYTES,
+        "partial flush saves too little");
+
+    canvas_free(canvas);
+    gui_test_display = NULL;
+    free(display);
+}
+
+MU_TEST_SUITE(gui) {
+    MU_RUN_TEST(gui_canvas_commit_test);
+}
+
+int run_minunit_test_gui() {
+    MU_RUN_SUITE(gui);
+    return MU_EXIT_CODE;
+}
@@ -1,12 +1,16 @@
 #include <furi.h>
+#include <furi_hal.h>
 #include <flipper_format.h>
 #include <infrared.h>
 #include <common/infrared_common_i.h>
 #include "../minunit.h"
 
+#define TAG "InfraredTest"
+
 #define IR_TEST_FILES_DIR EXT_PATH("unit_tests/infrared/")
 #define IR_TEST_FILE_PREFIX "test_"
 #define IR_TEST_FILE_SUFFIX ".irtest"
+#define IR_TEST_BENCHMARK_ROUNDS 50
 
 typedef struct {
     InfraredDecoderHandler* decoder_handler;
@@ -396,6 +400,56 @@ static void infrared_test_run_decoder(InfraredProtocol protocol, uint32_t test_i
     mu_assert(message_counter == messages_count, "decoded less than expected");
 }
 
+static void infrared_test_run_decoder_benchmark(InfraredProtocol protocol, uint32_t test_index) {
+    uint32_t* timings;
+    uint32_t timings_count;
+
+    string_t buf;
+    string_init(buf);
+
+    mu_assert(
+        infrared_test_prepare_file(infrared_get_protocol_name(protocol)),
+        "Failed to prepare test file");
+
+    string_printf(buf, "decoder_input%d", test_index);
+    mu_assert(
+        infrared_test_load_raw_signal(test->ff, string_get_cstr(buf), &timings, &timings_count),
+        "Failed to load raw signal from file");
+
+    flipper_format_buffered_file_close(test->ff);
+    string_clear(buf);
+
+    uint32_t cycles = 0;
+    for(uint32_t round = 0; round < IR_TEST_BENCHMARK_ROUNDS; ++round) {
+        bool level = 0;
+        uint32_t start = DWT->CYCCNT;
+        for(uint32_t i = 0; i < timings_count; ++i) {
+            infrared_decode(test->decoder_handler, level, timings[i]);
+            level = !level;
+        }
+        cycles += DWT->CYCCNT - start;
+        infrared_reset_decoder(test->decoder_handler);
+    }
+
+    uint32_t samples = timings_count * IR_TEST_BENCHMARK_ROUNDS;
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu ns per sample",
+        infrared_get_protocol_name(protocol),
+        (uint32_t)((uint64_t)cycles * 1000 / furi_hal_cortex_instructions_per_microsecond() /
+                   samples));
+
+    free(timings);
+}
+
+MU_TEST(infrared_test_decoder_benchmark) {
+    infrared_test_run_decoder_benchmark(InfraredProtocolNEC, 1);
+    infrared_test_run_decoder_benchmark(InfraredProtocolRC5, 1);
+    infrared_test_run_decoder_benchmark(InfraredProtocolRC6, 1);
+    infrared_test_run_decoder_benchmark(InfraredProtocolSIRC, 1);
+    infrared_test_run_decoder_benchmark(InfraredProtocolSamsung32, 1);
+}
+
 MU_TEST(infrared_test_decoder_samsung32) {
     infrared_test_run_decoder(InfraredProtocolSamsung32, 1);
 }
@@ -513,6 +567,7 @@ MU_TEST_SUITE(infrared_test) {
     MU_RUN_TEST(infrared_test_decoder_necext1);
     MU_RUN_TEST(infrared_test_decoder_mixed);
     MU_RUN_TEST(infrared_test_encoder_decoder_all);
+    MU_RUN_TEST(infrared_test_decoder_benchmark);
 }
 
 int run_minunit_test_infrared() {
@@ -0,0 +1,299 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <stdlib.h>
+#include <applications/lfrfid/helpers/rfid_decoder_registry.h>
+#include <applications/lfrfid/helpers/rfid_edge_buffer.h>
+#include <applications/lfrfid/helpers/encoder_emmarin.h>
+#include <applications/lfrfid/helpers/encoder_hid_h10301.h>
+#include <applications/lfrfid/helpers/encoder_indala_40134.h>
+#include <applications/lfrfid/helpers/encoder_ioprox.h>
+#include <applications/lfrfid/helpers/pulse_joiner.h>
+#include "../minunit.h"
+
+#define TAG "LfRfidTest"
+
+constexpr uint32_t clocks_in_us = 64;
+// emulation timer click, one 125 kHz carrier period
+constexpr uint32_t us_per_click = 8;
+constexpr uint32_t replay_frames = 32;
+constexpr uint32_t replay_jitter_us = 2;
+
+struct LfRfidTestCard {
+    LfrfidKeyType type;
+    uint8_t data[LFRFID_KEY_SIZE];
+    uint8_t mode;
+    uint32_t frame_us;
+    // out of replay_frames, decoders that restart after a read skip frames
+    uint32_t min_decoded;
+};
+
+static const LfRfidTestCard lfrfid_test_cards[] = {
+    {
+        LfrfidKeyType::KeyEM4100,
+        {0x12, 0x34, 0x56, 0x78, 0x9A},
+        RfidDecoderModeNormal,
+        64 * 64 * us_per_click,
+        28,
+    },
+    {
+        LfrfidKeyType::KeyH10301,
+        {0x71, 0x12, 0x34},
+        RfidDecoderModeNormal,
+        96 * 50 * us_per_click,
+        28,
+    },
+    {
+        LfrfidKeyType::KeyIoProxXSF,
+        {0x1E, 0x01, 0x30, 0x39},
+        RfidDecoderModeNormal,
+        64 * 64 * us_per_click,
+        12,
+    },
+    {
+        LfrfidKeyType::KeyI40134,
+        {0x6E, 0x30, 0x39},
+        RfidDecoderModeIndala,
+        64 * 16 * 2 * us_per_click,
+        14,
+    },
+};
+
+/**
+ * Comparator signal of emulated card, as levels with durations.
+ * ASK and FSK cards are shaped by emulator pulse joiner, PSK card gives demodulated bit levels.
+ */
+class LfRfidTestSignal {
+public:
+    LfRfidTestSignal(LfrfidKeyType _type, const uint8_t* data) {
+        type = _type;
+        switch(type) {
+        case LfrfidKeyType::KeyEM4100:
+            encoder = new EncoderEM();
+            break;
+        case LfrfidKeyType::KeyH10301:
+            encoder = new EncoderHID_H10301();
+            break;
+        case LfrfidKeyType::KeyI40134:
+            encoder = new EncoderIndala_40134();
+            break;
+        case LfrfidKeyType::KeyIoProxXSF:
+            encoder = new EncoderIoProx();
+            break;
+        }
+        encoder->init(data, lfrfid_key_get_type_data_count(type));
+    }
+
+    ~LfRfidTestSignal() {
+        delete encoder;
+    }
+
+    void next(bool* level, uint32_t* time_us) {
+        if(type == LfrfidKeyType::KeyI40134) {
+            next_psk(level, time_us);
+        } else {
+            next_pulse(level, time_us);
+        }
+    }
+
+private:
+    LfrfidKeyType type;
+    EncoderGeneric* encoder;
+    PulseJoiner pulse_joiner;
+    uint16_t low_clicks = 0;
+    bool psk_level = false;
+    uint16_t psk_clicks = 0;
+
+    void next_pulse(bool* level, uint32_t* time_us) {
+        if(low_clicks > 0) {
+            *level = false;
+            *time_us = low_clicks * us_per_click;
+            low_clicks = 0;
+            return;
+        }
+
+        bool polarity;
+        uint16_t period;
+        uint16_t pulse;
+
+        do {
+            encoder->get_next(&polarity, &period, &pulse);
+        } while(!pulse_joiner.push_pulse(polarity, period, pulse));
+        pulse_joiner.pop_pulse(&period, &pulse);
+
+        *level = true;
+        *time_us = pulse * us_per_click;
+        low_clicks = period - pulse;
+    }
+
+    void next_psk(bool* level, uint32_t* time_us) {
+        bool polarity;
+        uint16_t period;
+        uint16_t pulse;
+
+        while(true) {
+            encoder->get_next(&polarity, &period, &pulse);
+            if(psk_clicks > 0 && polarity != psk_level) break;
+            psk_level = polarity;
+            psk_clicks += period;
+        }
+
+        *level = psk_level;
+        *time_us = psk_clicks * us_per_click;
+        psk_level = polarity;
+        psk_clicks = period;
+    }
+};
+
+struct LfRfidTestReplay {
+    uint32_t frames;
+    uint32_t edges;
+    uint32_t decoded;
+    uint32_t misdecoded;
+    uint32_t cycles;
+};
+
+static void lfrfid_test_replay(const LfRfidTestCard* card, LfRfidTestReplay* replay) {
+    void** decoders = new void*[rfid_decoder_registry_count()];
+    for(size_t i = 0; i < rfid_decoder_registry_count(); i++) {
+        decoders[i] = rfid_decoder_registry_get_by_index(i)->alloc();
+    }
+
+    RfidEdgeBuffer* edges = new RfidEdgeBuffer();
+    LfRfidTestSignal* signal = new LfRfidTestSignal(card->type, card->data);
+    uint8_t data[LFRFID_KEY_SIZE];
+    uint8_t data_count = lfrfid_key_get_type_data_count(card->type);
+    const uint32_t replay_us = card->frame_us * replay_frames;
+    uint32_t time_us = 0;
+
+    memset(replay, 0, sizeof(LfRfidTestReplay));
+    replay->frames = replay_frames;
+    srand(0);
+
+    while(time_us < replay_us) {
+        // capture half a buffer, as comparator interrupt does before waking decoding thread
+        while(edges->get_count() < RfidEdgeBuffer::size / 2 && time_us < replay_us) {
+            bool level;
+            uint32_t level_us;
+            signal->next(&level, &level_us);
+            level_us += rand() % (replay_jitter_us * 2 + 1);
+            level_us -= replay_jitter_us;
+
+            // reader comparator output is inverted to card modulation
+            edges->push(!level, level_us * clocks_in_us);
+            time_us += level_us;
+            replay->edges++;
+        }
+
+        // decode, reading keys out after every edge not to miss any of them
+        bool polarity;
+        uint32_t time;
+        uint32_t start = DWT->CYCCNT;
+        while(edges->pop(&polarity, &time)) {
+            for(size_t i = 0; i < rfid_decoder_registry_count(); i++) {
+                const RfidDecoderProtocol* protocol = rfid_decoder_registry_get_by_index(i);
+                if(!(protocol->modes & card->mode)) continue;
+
+                protocol->feed(decoders[i], polarity, time);
+                if(protocol->read(decoders[i], data, sizeof(data))) {
+                    if(protocol->type == card->type && memcmp(data, card->data, data_count) == 0) {
+                        replay->decoded++;
+                    } else {
+                        replay->misdecoded++;
+                    }
+                }
+            }
+        }
+        replay->cycles += DWT->CYCCNT - start;
+    }
+
+    delete signal;
+    delete edges;
+    for(size_t i = 0; i < rfid_decoder_registry_count(); i++) {
+        rfid_decoder_registry_get_by_index(i)->free(decoders[i]);
+    }
+    delete[] decoders;
+}
+
+MU_TEST(lfrfid_edge_buffer_test) {
+    RfidEdgeBuffer* edges = new RfidEdgeBuffer();
+    bool polarity;
+    uint32_t time;
+
+    mu_assert(!edges->pop(&polarity, &time), "empty buffer popped");
+    for(size_t i = 0; i < RfidEdgeBuffer::size; i++) {
+        mu_assert(edges->push(i & 1, i), "push failed");
+    }
+    mu_assert(!edges->push(true, 0), "full buffer pushed");
+    mu_assert_int_eq(1, edges->get_dropped());
+    mu_assert_int_eq(RfidEdgeBuffer::size, edges->get_count());
+
+    for(size_t i = 0; i < RfidEdgeBuffer::size; i++) {
+        mu_assert(edges->pop(&polarity, &time), "pop failed");
+        mu_assert(polarity == (i & 1) && time == i, "edge mismatch");
+    }
+    mu_assert(!edges->pop(&polarity, &time), "empty buffer popped");
+
+    // Time since previous edge saturates instead of spilling into polarity
+    mu_assert(edges->push(false, UINT32_MAX), "push failed");
+    mu_assert(edges->pop(&polarity, &time), "pop failed");
+    mu_assert(!polarity && time == INT32_MAX, "saturated edge mismatch");
+
+    edges->reset();
+    mu_assert_int_eq(0, edges->get_dropped());
+    mu_assert_int_eq(0, edges->get_count());
+    delete edges;
+}
+
+MU_TEST(lfrfid_registry_test) {
+    uint8_t modes = 0;
+    for(size_t i = 0; i < rfid_decoder_registry_count(); i++) {
+        const RfidDecoderProtocol* protocol = rfid_decoder_registry_get_by_index(i);
+        mu_assert(protocol->modes != 0, "decoder runs in no mode");
+        mu_assert(rfid_decoder_registry_get_by_type(protocol->type) == protocol, "wrong type");
+        modes |= protocol->modes;
+    }
+    mu_assert_int_eq(RfidDecoderModeNormal | RfidDecoderModeIndala, modes);
+    mu_assert(
+        rfid_decoder_registry_get_by_index(rfid_decoder_registry_count()) == nullptr,
+        "index out of range");
+
+    for(size_t i = 0; i < COUNT_OF(lfrfid_test_cards); i++) {
+        const RfidDecoderProtocol* protocol =
+            rfid_decoder_registry_get_by_type(lfrfid_test_cards[i].type);
+        mu_assert(protocol, "no decoder for key type");
+        mu_assert(protocol->modes & lfrfid_test_cards[i].mode, "decoder not in reader mode");
+    }
+}
+
+MU_TEST(lfrfid_replay_test) {
+    LfRfidTestReplay replay;
+    const uint64_t clocks_per_second = furi_hal_cortex_instructions_per_microsecond() * 1000000;
+
+    for(size_t i = 0; i < COUNT_OF(lfrfid_test_cards); i++) {
+        const LfRfidTestCard* card = &lfrfid_test_cards[i];
+        lfrfid_test_replay(card, &replay);
+
+        FURI_LOG_I(
+            TAG,
+            "%s: %lu/%lu frames decoded, %lu edges, %lu edges/s",
+            lfrfid_key_get_type_string(card->type),
+            replay.decoded,
+            replay.frames,
+            replay.edges,
+            (uint32_t)(replay.edges * clocks_per_second / replay.cycles));
+
+        mu_assert_int_eq(0, replay.misdecoded);
+        mu_assert(replay.decoded >= card->min_decoded, "frames lost");
+    }
+}
+
+MU_TEST_SUITE(lfrfid) {
+    MU_RUN_TEST(lfrfid_edge_buffer_test);
+    MU_RUN_TEST(lfrfid_registry_test);
+    MU_RUN_TEST(lfrfid_replay_test);
+}
+
+extern "C" int run_minunit_test_lfrfid() {
+    MU_RUN_SUITE(lfrfid);
+    return MU_EXIT_CODE;
+}
@@ -4,6 +4,8 @@
 #include <lib/flipper_format/flipper_format.h>
 #include <lib/nfc/protocols/nfca.h>
 #include <lib/digital_signal/digital_signal.h>
+#include <lib/nfc/helpers/mf_classic_dict.h>
+#include <lib/nfc/protocols/crypto1.h>
 
 #include <lib/flipper_format/flipper_format_i.h>
 #include <lib/toolbox/stream/file_stream.h>
@@ -21,6 +23,9 @@ static const uint32_t nfc_test_file_version = 1;
 
 #define NFC_TEST_DATA_MAX_LEN 18
 #define NFC_TETS_TIMINGS_MAX_LEN 1350
+#define NFC_TEST_DICT_PASSES 10
+#define NFC_TEST_CRYPTO1_KEYS 64
+#define NFC_TEST_CRYPTO1_BYTES 1024
 
 typedef struct {
     Storage* storage;
@@ -170,10 +175,116 @@ MU_TEST(nfc_digital_signal_test) {
         "NFC long digital signal test failed\r\n");
 }
 
+MU_TEST(mf_classic_dict_test) {
+    mu_assert(
+        mf_classic_dict_check_presence(MfClassicDictTypeFlipper),
+        "Flipper dictionary not found\r\n");
+    MfClassicDict* dict = mf_classic_dict_alloc(MfClassicDictTypeFlipper);
+    mu_assert(dict != NULL, "mf_classic_dict_alloc() failed\r\n");
+    uint32_t total_keys = mf_classic_dict_get_total_keys(dict);
+    mu_assert(total_keys > 0, "Flipper dictionary is empty\r\n");
+
+    uint64_t key = 0;
+    uint64_t last_key = 0;
+    uint32_t keys_read = 0;
+    uint32_t tick = furi_get_tick();
+    for(size_t i = 0; i < NFC_TEST_DICT_PASSES; i++) {
+        mf_classic_dict_rewind(dict);
+        while(mf_classic_dict_get_next_key(dict, &key)) {
+            last_key = key;
+            keys_read++;
+        }
+    }
+    uint32_t time = furi_get_tick() - tick;
+    mu_assert_int_eq(total_keys * NFC_TEST_DICT_PASSES, keys_read);
+    FURI_LOG_I(
+        TAG,
+        "Dictionary iteration: %lu keys in %lu ms, %lu keys/s",
+        keys_read,
+        time,
+        keys_read * 1000 / MAX(time, 1UL));
+
+    // Found key goes first and is not repeated
+    mf_classic_dict_set_key_found(dict, last_key);
+    mf_classic_dict_rewind(dict);
+    mu_assert(mf_classic_dict_get_next_key(dict, &key), "Found key not returned\r\n");
+    mu_check(key == last_key);
+    keys_read = 1;
+    while(mf_classic_dict_get_next_key(dict, &key)) {
+        mu_check(key != last_key);
+        keys_read++;
+    }
+    mu_assert_int_eq(total_keys, keys_read);
+
+    mf_classic_dict_free(dict);
+}
+
+static uint8_t nfc_test_crypto1_byte_bit_serial(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+    }
+    return out;
+}
+
+MU_TEST(nfc_crypto1_test) {
+    Crypto1 crypto1;
+    Crypto1 reference;
+
+    // Conformance with bit serial crypto1_bit()
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_KEYS; i++) {
+        uint64_t key = ((uint64_t)furi_hal_random_get() << 16) ^ furi_hal_random_get();
+        key &= 0xFFFFFFFFFFFF;
+        crypto1_init(&crypto1, key);
+        crypto1_init(&reference, key);
+        for(size_t j = 0; j < 16; j++) {
+            uint32_t in = furi_hal_random_get();
+            int is_encrypted = j & 1;
+            uint32_t word = crypto1_word(&crypto1, in, is_encrypted);
+            uint32_t word_ref = 0;
+            for(uint8_t k = 0; k < 32; k++) {
+                word_ref |= (uint32_t)crypto1_bit(&reference, FURI_BIT(in, k ^ 24), is_encrypted)
+                            << (k ^ 24);
+            }
+            mu_assert_int_eq(word_ref, word);
+
+            uint8_t parity = 0;
+            uint8_t byte = crypto1_byte_parity(&crypto1, in, is_encrypted, &parity);
+            mu_assert_int_eq(nfc_test_crypto1_byte_bit_serial(&reference, in, is_encrypted), byte);
+            mu_assert_int_eq(crypto1_filter(reference.odd), parity);
+            mu_check(crypto1.odd == reference.odd && crypto1.even == reference.even);
+        }
+    }
+
+    // Throughput
+    uint8_t out = 0;
+    crypto1_init(&crypto1, 0xFFFFFFFFFFFF);
+    uint32_t time = DWT->CYCCNT;
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_BYTES; i++) {
+        out ^= crypto1_byte(&crypto1, i, 0);
+    }
+    time = (DWT->CYCCNT - time) / furi_hal_cortex_instructions_per_microsecond();
+    crypto1_init(&reference, 0xFFFFFFFFFFFF);
+    uint32_t time_ref = DWT->CYCCNT;
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_BYTES; i++) {
+        out ^= nfc_test_crypto1_byte_bit_serial(&reference, i, 0);
+    }
+    time_ref = (DWT->CYCCNT - time_ref) / furi_hal_cortex_instructions_per_microsecond();
+    mu_assert_int_eq(0, out);
+    FURI_LOG_I(
+        TAG,
+        "Crypto1 %d bytes: crypto1_byte %lu us, bit serial %lu us",
+        NFC_TEST_CRYPTO1_BYTES,
+        time,
+        time_ref);
+}
+
 MU_TEST_SUITE(nfc) {
     nfc_test_alloc();
 
     MU_RUN_TEST(nfc_digital_signal_test);
+    MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(nfc_crypto1_test);
 
     nfc_test_free();
 }
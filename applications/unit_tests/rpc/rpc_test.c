@@ -49,6 +49,7 @@ static RpcSessionContext rpc_session[TEST_RPC_SESSIONS];
 #define TEST_DIR TEST_DIR_NAME "/"
 #define TEST_DIR_NAME EXT_PATH("unit_tests_tmp")
 #define MD5SUM_SIZE 16
+#define SPEED_TEST_FRAMES 64
 
 #define PING_REQUEST 0
 #define PING_RESPONSE 1
@@ -779,6 +780,16 @@ static void test_storage_read_run(const char* path, uint32_t command_id) {
     test_rpc_free_msg_list(expected_msg_list);
 }
 
+static void test_storage_speed_log(const char* name, size_t size, uint32_t ticks) {
+    FURI_LOG_I(
+        TAG,
+        "%s %u bytes: %lu ms, %lu KiB/s",
+        name,
+        size,
+        ticks,
+        ticks ? (uint32_t)((uint64_t)size * 1000 / 1024 / ticks) : 0);
+}
+
 static bool test_is_exists(const char* path) {
     Storage* fs_api = furi_record_open(RECORD_STORAGE);
     FileInfo fileinfo;
@@ -953,6 +964,31 @@ static void test_storage_write_run(
     free(buf);
 }
 
+MU_TEST(test_storage_speed) {
+    const char* path = TEST_DIR "speed.bin";
+    const size_t size = MAX_DATA_SIZE * SPEED_TEST_FRAMES;
+
+    // loopback through the session callbacks, includes encoding and decoding on the test side
+    uint32_t start = furi_get_tick();
+    test_storage_write_run(
+        path, MAX_DATA_SIZE, SPEED_TEST_FRAMES, ++command_id, PB_CommandStatus_OK);
+    test_storage_speed_log("Write", size, furi_get_tick() - start);
+
+    MsgList_t expected_msg_list;
+    MsgList_init(expected_msg_list);
+    PB_Main request;
+    test_rpc_add_read_to_list_by_reading_real_file(expected_msg_list, path, ++command_id);
+    test_rpc_create_simple_message(&request, PB_Main_storage_read_request_tag, path, command_id);
+
+    start = furi_get_tick();
+    test_rpc_encode_and_feed_one(&request, 0);
+    test_rpc_decode_and_compare(expected_msg_list, 0);
+    test_storage_speed_log("Read", size, furi_get_tick() - start);
+
+    pb_release(&PB_Main_msg, &request);
+    test_rpc_free_msg_list(expected_msg_list);
+}
+
 static void test_storage_write_read_run(
     const char* path,
     const uint8_t* pattern,
@@ -1437,6 +1473,7 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_read);
     MU_RUN_TEST(test_storage_write_read);
     MU_RUN_TEST(test_storage_write);
+    MU_RUN_TEST(test_storage_speed);
     MU_RUN_TEST(test_storage_delete);
     MU_RUN_TEST(test_storage_delete_recursive);
     MU_RUN_TEST(test_storage_mkdir);
@@ -1,9 +1,22 @@
 #include "../minunit.h"
 #include <furi.h>
+#include <furi_hal.h>
 #include <storage/storage.h>
+#include <lib/toolbox/md5.h>
+#include <lib/toolbox/sha256.h>
+#include <lib/toolbox/crc32_calc.h>
+#include <littlefs/lfs_util.h>
 
 #define STORAGE_LOCKED_FILE EXT_PATH("locked_file.test")
 #define STORAGE_LOCKED_DIR STORAGE_INT_PATH_PREFIX
+#define STORAGE_DIGEST_FILE EXT_PATH("digest.test")
+#define STORAGE_DIGEST_FILE_RENAMED EXT_PATH("digest_renamed.test")
+#define STORAGE_DIGEST_BENCH_SIZE (32 * 1024)
+#define STORAGE_CRC32_FILE EXT_PATH("crc32.test")
+#define STORAGE_CRC32_BENCH_SIZE (32 * 1024)
+#define STORAGE_CRC32_BENCH_PASSES 8
+
+#define TAG "StorageTest"
 
 static void storage_file_open_lock_setup() {
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -309,9 +322,196 @@ MU_TEST_SUITE(storage_rename) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static bool storage_digest_write(Storage* storage, const char* path, const char* data) {
+    File* file = storage_file_alloc(storage);
+    bool result = false;
+    if(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        result = storage_file_write(file, data, strlen(data)) == strlen(data);
+    }
+    storage_file_close(file);
+    storage_file_free(file);
+
+    return result;
+}
+
+static void storage_digest_check(Storage* storage, const char* path, const char* data) {
+    uint8_t expected[STORAGE_DIGEST_MAX_SIZE];
+    uint8_t digest[STORAGE_DIGEST_MAX_SIZE];
+
+    md5((const unsigned char*)data, strlen(data), expected);
+    mu_assert_int_eq(FSE_OK, storage_common_digest(storage, path, StorageDigestTypeMd5, digest));
+    mu_check(memcmp(expected, digest, storage_digest_get_size(StorageDigestTypeMd5)) == 0);
+
+    sha256((const unsigned char*)data, strlen(data), expected);
+    mu_assert_int_eq(
+        FSE_OK, storage_common_digest(storage, path, StorageDigestTypeSha256, digest));
+    mu_check(memcmp(expected, digest, storage_digest_get_size(StorageDigestTypeSha256)) == 0);
+}
+
+MU_TEST(storage_digest_invalidate) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    uint8_t digest[STORAGE_DIGEST_MAX_SIZE];
+
+    mu_assert_int_eq(
+        FSE_NOT_EXIST,
+        storage_common_digest(storage, STORAGE_DIGEST_FILE, StorageDigestTypeMd5, digest));
+
+    mu_check(storage_digest_write(storage, STORAGE_DIGEST_FILE, "13DA"));
+    storage_digest_check(storage, STORAGE_DIGEST_FILE, "13DA");
+    storage_digest_check(storage, STORAGE_DIGEST_FILE, "13DA");
+
+    // same size, cached digest must not be used
+    mu_check(storage_digest_write(storage, STORAGE_DIGEST_FILE, "DA13"));
+    storage_digest_check(storage, STORAGE_DIGEST_FILE, "DA13");
+
+    mu_assert_int_eq(
+        FSE_OK, storage_common_rename(storage, STORAGE_DIGEST_FILE, STORAGE_DIGEST_FILE_RENAMED));
+    mu_assert_int_eq(
+        FSE_NOT_EXIST,
+        storage_common_digest(storage, STORAGE_DIGEST_FILE, StorageDigestTypeMd5, digest));
+    storage_digest_check(storage, STORAGE_DIGEST_FILE_RENAMED, "DA13");
+
+    mu_check(storage_digest_write(storage, STORAGE_DIGEST_FILE, "13DA"));
+    storage_digest_check(storage, STORAGE_DIGEST_FILE, "13DA");
+
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, STORAGE_DIGEST_FILE));
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, STORAGE_DIGEST_FILE_RENAMED));
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_digest_benchmark) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = malloc(STORAGE_DIGEST_BENCH_SIZE);
+    uint8_t digest[STORAGE_DIGEST_MAX_SIZE];
+    uint8_t cached_digest[STORAGE_DIGEST_MAX_SIZE];
+
+    for(size_t i = 0; i < STORAGE_DIGEST_BENCH_SIZE; i++) {
+        data[i] = i;
+    }
+    mu_check(storage_file_open(file, STORAGE_DIGEST_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    mu_check(
+        storage_file_write(file, data, STORAGE_DIGEST_BENCH_SIZE) == STORAGE_DIGEST_BENCH_SIZE);
+    storage_file_close(file);
+
+    uint32_t tick = furi_get_tick();
+    mu_assert_int_eq(
+        FSE_OK,
+        storage_common_digest(storage, STORAGE_DIGEST_FILE, StorageDigestTypeMd5, digest));
+    uint32_t calculate_time = furi_get_tick() - tick;
+
+    tick = furi_get_tick();
+    mu_assert_int_eq(
+        FSE_OK,
+        storage_common_digest(storage, STORAGE_DIGEST_FILE, StorageDigestTypeMd5, cached_digest));
+    uint32_t cached_time = furi_get_tick() - tick;
+
+    mu_check(memcmp(digest, cached_digest, storage_digest_get_size(StorageDigestTypeMd5)) == 0);
+    FURI_LOG_I(
+        TAG,
+        "md5 of %d bytes: %lums, cached: %lums",
+        STORAGE_DIGEST_BENCH_SIZE,
+        calculate_time,
+        cached_time);
+
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, STORAGE_DIGEST_FILE));
+    free(data);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(storage_digest) {
+    MU_RUN_TEST(storage_digest_invalidate);
+    MU_RUN_TEST(storage_digest_benchmark);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, STORAGE_DIGEST_FILE);
+    storage_simply_remove(storage, STORAGE_DIGEST_FILE_RENAMED);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static uint32_t storage_crc32_speed(uint32_t bytes, uint32_t cycles) {
+    // KB/s
+    uint32_t us = MAX(cycles / furi_hal_cortex_instructions_per_microsecond(), 1UL);
+    return (uint64_t)bytes * 1000000 / 1024 / us;
+}
+
+MU_TEST(storage_crc32) {
+    uint8_t* data = malloc(STORAGE_CRC32_BENCH_SIZE);
+    furi_hal_random_fill_buf(data, STORAGE_CRC32_BENCH_SIZE);
+
+    mu_assert_int_eq(0xCBF43926, crc32_calc_buffer(0, "123456789", 9));
+
+    // Chained, streaming software and hardware results are the same as the previous implementation
+    uint32_t expected = ~lfs_crc(~0UL, data, STORAGE_CRC32_BENCH_SIZE);
+    uint32_t crc = crc32_calc_buffer(0, data, 1001);
+    mu_assert_int_eq(
+        expected, crc32_calc_buffer(crc, data + 1001, STORAGE_CRC32_BENCH_SIZE - 1001));
+    for(uint8_t hardware = 0; hardware < 2; hardware++) {
+        Crc32Calc calc;
+        crc32_calc_start(&calc, 0, hardware);
+        mu_assert_int_eq(hardware, calc.hardware);
+        crc32_calc_feed(&calc, data, 3);
+        crc32_calc_feed(&calc, data + 3, 1001 - 3);
+        crc = crc32_calc_finish(&calc);
+        crc32_calc_start(&calc, crc, hardware);
+        crc32_calc_feed(&calc, data + 1001, STORAGE_CRC32_BENCH_SIZE - 1001);
+        mu_assert_int_eq(expected, crc32_calc_finish(&calc));
+    }
+
+    uint32_t bytes = STORAGE_CRC32_BENCH_SIZE * STORAGE_CRC32_BENCH_PASSES;
+    uint32_t cycles = DWT->CYCCNT;
+    for(size_t i = 0; i < STORAGE_CRC32_BENCH_PASSES; i++) {
+        crc = ~lfs_crc(~crc, data, STORAGE_CRC32_BENCH_SIZE);
+    }
+    uint32_t lfs_speed = storage_crc32_speed(bytes, DWT->CYCCNT - cycles);
+    cycles = DWT->CYCCNT;
+    for(size_t i = 0; i < STORAGE_CRC32_BENCH_PASSES; i++) {
+        crc = crc32_calc_buffer(crc, data, STORAGE_CRC32_BENCH_SIZE);
+    }
+    uint32_t software_speed = storage_crc32_speed(bytes, DWT->CYCCNT - cycles);
+    Crc32Calc calc;
+    cycles = DWT->CYCCNT;
+    crc32_calc_start(&calc, crc, true);
+    for(size_t i = 0; i < STORAGE_CRC32_BENCH_PASSES; i++) {
+        crc32_calc_feed(&calc, data, STORAGE_CRC32_BENCH_SIZE);
+    }
+    crc32_calc_finish(&calc);
+    uint32_t hardware_speed = storage_crc32_speed(bytes, DWT->CYCCNT - cycles);
+    FURI_LOG_I(
+        TAG,
+        "crc32 KB/s: nibble table %lu, slicing-by-8 %lu, hardware %lu",
+        lfs_speed,
+        software_speed,
+        hardware_speed);
+
+    // File
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    mu_check(storage_file_open(file, STORAGE_CRC32_FILE, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    mu_check(storage_file_write(file, data, STORAGE_CRC32_BENCH_SIZE) == STORAGE_CRC32_BENCH_SIZE);
+    uint32_t tick = furi_get_tick();
+    mu_assert_int_eq(expected, crc32_calc_file(file, NULL, NULL));
+    FURI_LOG_I(
+        TAG, "crc32 of %d bytes file: %lums", STORAGE_CRC32_BENCH_SIZE, furi_get_tick() - tick);
+    storage_file_close(file);
+    mu_assert_int_eq(FSE_OK, storage_common_remove(storage, STORAGE_CRC32_FILE));
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    free(data);
+}
+
+MU_TEST_SUITE(storage_crc32_calc) {
+    MU_RUN_TEST(storage_crc32);
+}
+
 int run_minunit_test_storage() {
     MU_RUN_SUITE(storage_file);
     MU_RUN_SUITE(storage_dir);
     MU_RUN_SUITE(storage_rename);
+    MU_RUN_SUITE(storage_digest);
+    MU_RUN_SUITE(storage_crc32_calc);
     return MU_EXIT_CODE;
 }
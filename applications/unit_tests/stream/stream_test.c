@@ -1,4 +1,5 @@
 #include <furi.h>
+#include <furi_hal.h>
 #include <toolbox/stream/stream.h>
 #include <toolbox/stream/string_stream.h>
 #include <toolbox/stream/file_stream.h>
@@ -6,6 +7,9 @@
 #include <storage/storage.h>
 #include "../minunit.h"
 
+#define TAG "StreamTest"
+#define STREAM_TEST_BENCHMARK_LINES 512
+
 static const char* stream_test_data = "I write differently from what I speak, "
                                       "I speak differently from what I think, "
                                       "I think differently from the way I ought to think, "
@@ -494,12 +498,208 @@ MU_TEST(stream_buffered_large_file_test) {
     string_clear(output_data);
 }
 
+MU_TEST_1(stream_read_line_view_subtest, Stream* stream) {
+    string_t buffer;
+    string_t line;
+    string_t expected;
+    string_init(buffer);
+    string_init(line);
+    string_init(expected);
+
+    // lines of different length, both LF and CRLF, to cross the cache boundary at every offset
+    stream_clean(stream);
+    for(uint32_t i = 0; i < 64; i++) {
+        stream_write_format(
+            stream, "%lu:%.*s%s", i, (int)(i * 7 % 61), stream_test_data, i % 3 ? "\n" : "\r\n");
+    }
+    // last line without EOL
+    stream_write_cstring(stream, stream_test_left_data);
+    mu_check(stream_rewind(stream));
+
+    const char* view;
+    size_t view_size;
+    for(uint32_t i = 0; i < 64; i++) {
+        string_printf(
+            expected, "%lu:%.*s%s", i, (int)(i * 7 % 61), stream_test_data, i % 3 ? "\n" : "\r\n");
+        mu_check(stream_read_line_view(stream, buffer, &view, &view_size));
+        mu_assert_int_eq(string_size(expected), view_size);
+        mu_check(memcmp(string_get_cstr(expected), view, view_size) == 0);
+    }
+    mu_check(stream_read_line_view(stream, buffer, &view, &view_size));
+    mu_assert_int_eq(strlen(stream_test_left_data), view_size);
+    mu_check(memcmp(stream_test_left_data, view, view_size) == 0);
+    mu_check(!stream_read_line_view(stream, buffer, &view, &view_size));
+    mu_check(stream_eof(stream));
+
+    // stream_read_line drops CR
+    mu_check(stream_rewind(stream));
+    mu_check(stream_read_line(stream, line));
+    mu_assert_string_eq("0:\n", string_get_cstr(line));
+
+    string_clear(buffer);
+    string_clear(line);
+    string_clear(expected);
+}
+
+MU_TEST(stream_read_line_view_test) {
+    Stream* stream;
+    stream = string_stream_alloc();
+    MU_RUN_TEST_1(stream_read_line_view_subtest, stream);
+    stream_free(stream);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    stream = file_stream_alloc(storage);
+    mu_check(
+        file_stream_open(stream, EXT_PATH("filestream.str"), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    MU_RUN_TEST_1(stream_read_line_view_subtest, stream);
+    stream_free(stream);
+
+    stream = buffered_file_stream_alloc(storage);
+    mu_check(buffered_file_stream_open(
+        stream, EXT_PATH("filestream.str"), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    MU_RUN_TEST_1(stream_read_line_view_subtest, stream);
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static bool stream_test_equal(Stream* stream_a, Stream* stream_b) {
+    bool result = stream_size(stream_a) == stream_size(stream_b);
+    const size_t block_size = 64;
+    uint8_t block_a[block_size];
+    uint8_t block_b[block_size];
+
+    if(result && stream_rewind(stream_a) && stream_rewind(stream_b)) {
+        size_t was_read;
+        do {
+            was_read = stream_read(stream_a, block_a, block_size);
+            if(stream_read(stream_b, block_b, block_size) != was_read ||
+               memcmp(block_a, block_b, was_read) != 0) {
+                result = false;
+                break;
+            }
+        } while(was_read);
+    }
+
+    return result;
+}
+
+MU_TEST(stream_file_delete_and_insert_test) {
+    const struct {
+        size_t position;
+        size_t delete_size;
+        const char* insert;
+    } updates[] = {
+        {10, 3, "abc"},
+        {10, 3, "longer than deleted"},
+        {100, 40, "shorter"},
+        {4000, 0, "insert only"},
+        {2000, 1000, ""},
+        {5, 20000, stream_test_left_data},
+    };
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = file_stream_alloc(storage);
+    Stream* expected = string_stream_alloc();
+    mu_check(
+        file_stream_open(stream, EXT_PATH("filestream.str"), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+
+    // 8 KiB file
+    for(size_t i = 0; i < 8192 / strlen(stream_test_data); i++) {
+        stream_write_format(stream, "%s\n", stream_test_data);
+        stream_write_format(expected, "%s\n", stream_test_data);
+    }
+
+    for(size_t i = 0; i < COUNT_OF(updates); i++) {
+        const size_t file_size = stream_size(stream);
+        const size_t tail_start = updates[i].position + updates[i].delete_size;
+        // only the data after the deleted part should be moved
+        const size_t tail_size = file_size > tail_start ? file_size - tail_start : 0;
+        mu_check(stream_seek(stream, updates[i].position, StreamOffsetFromStart));
+        mu_check(stream_seek(expected, updates[i].position, StreamOffsetFromStart));
+
+        uint32_t start = furi_get_tick();
+        mu_check(
+            stream_delete_and_insert_cstring(stream, updates[i].delete_size, updates[i].insert));
+        uint32_t ticks = furi_get_tick() - start;
+        mu_check(
+            stream_delete_and_insert_cstring(expected, updates[i].delete_size, updates[i].insert));
+
+        mu_assert_int_eq(stream_tell(expected), stream_tell(stream));
+        mu_check(stream_test_equal(stream, expected));
+        FURI_LOG_I(
+            TAG,
+            "Update at %u of %u bytes, %u bytes tail: %lu ms",
+            updates[i].position,
+            file_size,
+            tail_size,
+            ticks);
+    }
+
+    stream_free(expected);
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void stream_test_run_read_line_benchmark(Stream* stream, const char* name) {
+    stream_clean(stream);
+    for(uint32_t i = 0; i < STREAM_TEST_BENCHMARK_LINES; i++) {
+        stream_write_format(stream, "Key%lu: %s\n", i, stream_test_right_data);
+    }
+
+    string_t buffer;
+    string_init(buffer);
+    const char* view;
+    size_t view_size;
+
+    mu_check(stream_rewind(stream));
+    uint32_t start = DWT->CYCCNT;
+    while(stream_read_line(stream, buffer))
+        ;
+    uint32_t read_line_cycles = DWT->CYCCNT - start;
+
+    mu_check(stream_rewind(stream));
+    start = DWT->CYCCNT;
+    while(stream_read_line_view(stream, buffer, &view, &view_size))
+        ;
+    uint32_t read_line_view_cycles = DWT->CYCCNT - start;
+
+    string_clear(buffer);
+
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    FURI_LOG_I(
+        TAG,
+        "%s: read_line %lu ns, read_line_view %lu ns per line",
+        name,
+        (uint32_t)((uint64_t)read_line_cycles * 1000 / cycles_per_us /
+                   STREAM_TEST_BENCHMARK_LINES),
+        (uint32_t)((uint64_t)read_line_view_cycles * 1000 / cycles_per_us /
+                   STREAM_TEST_BENCHMARK_LINES));
+}
+
+MU_TEST(stream_read_line_benchmark) {
+    Stream* stream;
+    stream = string_stream_alloc();
+    stream_test_run_read_line_benchmark(stream, "String stream");
+    stream_free(stream);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    stream = buffered_file_stream_alloc(storage);
+    mu_check(buffered_file_stream_open(
+        stream, EXT_PATH("filestream.str"), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS));
+    stream_test_run_read_line_benchmark(stream, "Buffered file stream");
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(stream_suite) {
     MU_RUN_TEST(stream_write_read_save_load_test);
     MU_RUN_TEST(stream_composite_test);
     MU_RUN_TEST(stream_split_test);
     MU_RUN_TEST(stream_buffered_write_after_read_test);
     MU_RUN_TEST(stream_buffered_large_file_test);
+    MU_RUN_TEST(stream_file_delete_and_insert_test);
+    MU_RUN_TEST(stream_read_line_view_test);
+    MU_RUN_TEST(stream_read_line_benchmark);
 }
 
 int run_minunit_test_stream() {
@@ -5,16 +5,26 @@
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_packed.h>
 #include <lib/subghz/protocols/registry.h>
+#include <lib/subghz/protocols/keeloq_common.h>
+#include <lib/subghz/protocols/keeloq_batch.h>
 #include <flipper_format/flipper_format_i.h>
+#include <applications/subghz/subghz_history.h>
 
 #define TAG "SubGhz TEST"
 #define KEYSTORE_DIR_NAME EXT_PATH("subghz/assets/keeloq_mfcodes")
 #define CAME_ATOMO_DIR_NAME EXT_PATH("subghz/assets/came_atomo")
 #define NICE_FLOR_S_DIR_NAME EXT_PATH("subghz/assets/nice_flor_s")
 #define TEST_RANDOM_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw.sub")
+#define TEST_RANDOM_PACKED_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw_packed.tmp")
+#define TEST_KEYSTORE_BINARY_NAME EXT_PATH("unit_tests/subghz/keeloq_mfcodes_bin.tmp")
 #define TEST_RANDOM_COUNT_PARSE 188
 #define TEST_TIMEOUT 10000
+#define TEST_KEELOQ_BATCH_ROUNDS 16
+#define TEST_NICE_FLOR_S_TABLE_BLOCKS 2 // 32 bytes
+#define TEST_CAME_ATOMO_TABLE_BLOCKS 16 // 32 * uint64_t
+#define TEST_HISTORY_RECORDS 2000 // Past two hash set generations
 
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
@@ -97,10 +107,13 @@ static bool subghz_decoder_test(const char* path, const char* name_decoder) {
     }
 }
 
-static bool subghz_decode_random_test(const char* path) {
+static bool subghz_decode_random_test(const char* path, bool dispatch) {
     subghz_test_decoder_count = 0;
     subghz_receiver_reset(receiver_handler);
+    subghz_receiver_set_dispatch(receiver_handler, dispatch);
     uint32_t test_start = furi_get_tick();
+    uint32_t pulse_count = 0;
+    uint64_t decode_cycles = 0;
 
     file_worker_encoder_handler = subghz_file_encoder_worker_alloc();
     if(subghz_file_encoder_worker_start(file_worker_encoder_handler, path)) {
@@ -116,7 +129,10 @@ static bool subghz_decode_random_test(const char* path) {
                 uint32_t duration = level_duration_get_duration(level_duration);
                 // Yield, to load data inside the worker
                 furi_thread_yield();
+                uint32_t decode_start = DWT->CYCCNT;
                 subghz_receiver_decode(receiver_handler, level, duration);
+                decode_cycles += DWT->CYCCNT - decode_start;
+                pulse_count++;
             } else {
                 break;
             }
@@ -127,7 +143,16 @@ static bool subghz_decode_random_test(const char* path) {
         }
         subghz_file_encoder_worker_free(file_worker_encoder_handler);
     }
+    subghz_receiver_set_dispatch(receiver_handler, true);
     FURI_LOG_T(TAG, "\r\n Decoder count parse \033[0;33m%d\033[0m ", subghz_test_decoder_count);
+    if(decode_cycles) {
+        FURI_LOG_I(
+            TAG,
+            "Dispatch %s: %lu pulses, %lu pulses/sec",
+            dispatch ? "on" : "off",
+            pulse_count,
+            (uint32_t)((uint64_t)pulse_count * SystemCoreClock / decode_cycles));
+    }
     if(furi_get_tick() - test_start > TEST_TIMEOUT * 10) {
         printf("\033[0;31mRandom test ERROR TimeOut\033[0m\r\n");
         return false;
@@ -206,6 +231,256 @@ MU_TEST(subghz_keystore_test) {
         "Test keystore error");
 }
 
+static SubGhzKeystore* subghz_keystore_load_measured(
+    const char* file_name,
+    uint32_t* time,
+    size_t* heap) {
+    SubGhzKeystore* keystore = subghz_keystore_alloc();
+    size_t free_heap = memmgr_get_free_heap();
+    *time = DWT->CYCCNT;
+    bool loaded = subghz_keystore_load(keystore, file_name);
+    *time = (DWT->CYCCNT - *time) / furi_hal_cortex_instructions_per_microsecond();
+    *heap = free_heap - memmgr_get_free_heap();
+    if(!loaded) {
+        subghz_keystore_free(keystore);
+        keystore = NULL;
+    }
+    return keystore;
+}
+
+MU_TEST(subghz_keystore_binary_test) {
+    uint8_t iv[16] = {0};
+    uint32_t time_text, time_binary;
+    size_t heap_text, heap_binary;
+
+    SubGhzKeystore* keystore_text =
+        subghz_keystore_load_measured(KEYSTORE_DIR_NAME, &time_text, &heap_text);
+    mu_assert(keystore_text, "Unable to load text keystore\r\n");
+    mu_assert(
+        subghz_keystore_save_binary(keystore_text, TEST_KEYSTORE_BINARY_NAME, iv),
+        "Unable to save binary keystore\r\n");
+
+    SubGhzKeystore* keystore_binary =
+        subghz_keystore_load_measured(TEST_KEYSTORE_BINARY_NAME, &time_binary, &heap_binary);
+    mu_assert(keystore_binary, "Unable to load binary keystore\r\n");
+
+    SubGhzKeyArray_t* keys_text = subghz_keystore_get_data(keystore_text);
+    SubGhzKeyArray_t* keys_binary = subghz_keystore_get_data(keystore_binary);
+    mu_assert(
+        SubGhzKeyArray_size(*keys_text) == SubGhzKeyArray_size(*keys_binary),
+        "Binary keystore key count mismatch\r\n");
+    for(size_t i = 0; i < SubGhzKeyArray_size(*keys_text); i++) {
+        const SubGhzKey* key_text = SubGhzKeyArray_cget(*keys_text, i);
+        const SubGhzKey* key_binary = SubGhzKeyArray_cget(*keys_binary, i);
+        mu_assert(
+            key_text->key == key_binary->key && key_text->type == key_binary->type &&
+                strcmp(key_text->name, key_binary->name) == 0,
+            "Binary keystore key mismatch\r\n");
+    }
+
+    FURI_LOG_I(
+        TAG,
+        "Keystore load: text %lu us %u bytes, binary %lu us %u bytes",
+        time_text,
+        heap_text,
+        time_binary,
+        heap_binary);
+    mu_assert(time_binary < time_text, "Binary keystore load is slower than text\r\n");
+    mu_assert(heap_binary <= heap_text, "Binary keystore uses more heap than text\r\n");
+
+    subghz_keystore_free(keystore_binary);
+    subghz_keystore_free(keystore_text);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, TEST_KEYSTORE_BINARY_NAME);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(subghz_keeloq_batch_test) {
+    uint64_t keys[KEELOQ_BATCH_LANES];
+    uint32_t schedule[KEELOQ_BATCH_SCHEDULE_SIZE];
+    uint32_t man[KEELOQ_BATCH_SCHEDULE_SIZE];
+    uint32_t state[KEELOQ_BATCH_STATE_SIZE];
+
+    for(size_t round = 0; round < TEST_KEELOQ_BATCH_ROUNDS; round++) {
+        furi_hal_random_fill_buf((uint8_t*)keys, sizeof(keys));
+        uint32_t hop = furi_hal_random_get();
+        uint32_t fix = furi_hal_random_get();
+        size_t count = round % KEELOQ_BATCH_LANES + 1;
+        subghz_protocol_keeloq_batch_load_keys(schedule, keys, count);
+
+        subghz_protocol_keeloq_batch_decrypt(state, hop, schedule);
+        for(uint8_t lane = 0; lane < count; lane++) {
+            mu_assert(
+                subghz_protocol_keeloq_batch_get_lane(state, lane) ==
+                    subghz_protocol_keeloq_common_decrypt(hop, keys[lane]),
+                "Simple learning mismatch");
+        }
+
+        subghz_protocol_keeloq_batch_normal_learning(man, fix, schedule);
+        subghz_protocol_keeloq_batch_decrypt(state, hop, man);
+        for(uint8_t lane = 0; lane < count; lane++) {
+            uint64_t key = subghz_protocol_keeloq_common_normal_learning(fix, keys[lane]);
+            mu_assert(
+                subghz_protocol_keeloq_batch_get_lane(state, lane) ==
+                    subghz_protocol_keeloq_common_decrypt(hop, key),
+                "Normal learning mismatch");
+        }
+
+        subghz_protocol_keeloq_batch_secure_learning(man, fix, hop, schedule);
+        subghz_protocol_keeloq_batch_decrypt(state, hop, man);
+        for(uint8_t lane = 0; lane < count; lane++) {
+            uint64_t key = subghz_protocol_keeloq_common_secure_learning(fix, hop, keys[lane]);
+            mu_assert(
+                subghz_protocol_keeloq_batch_get_lane(state, lane) ==
+                    subghz_protocol_keeloq_common_decrypt(hop, key),
+                "Secure learning mismatch");
+        }
+
+        subghz_protocol_keeloq_batch_magic_xor_type1_learning(man, fix, schedule);
+        subghz_protocol_keeloq_batch_decrypt(state, hop, man);
+        for(uint8_t lane = 0; lane < count; lane++) {
+            uint64_t key =
+                subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, keys[lane]);
+            mu_assert(
+                subghz_protocol_keeloq_batch_get_lane(state, lane) ==
+                    subghz_protocol_keeloq_common_decrypt(hop, key),
+                "Magic xor type1 learning mismatch");
+        }
+    }
+
+    uint32_t test_start = furi_get_tick();
+    for(size_t round = 0; round < TEST_KEELOQ_BATCH_ROUNDS; round++) {
+        for(uint8_t lane = 0; lane < KEELOQ_BATCH_LANES; lane++) {
+            state[lane] = subghz_protocol_keeloq_common_decrypt(round, keys[lane]);
+        }
+    }
+    uint32_t scalar_time = furi_get_tick() - test_start;
+
+    test_start = furi_get_tick();
+    for(size_t round = 0; round < TEST_KEELOQ_BATCH_ROUNDS; round++) {
+        subghz_protocol_keeloq_batch_decrypt(state, round, schedule);
+    }
+    uint32_t batch_time = furi_get_tick() - test_start;
+
+    FURI_LOG_I(
+        TAG,
+        "Keeloq %d keys: scalar %lums, batch %lums",
+        TEST_KEELOQ_BATCH_ROUNDS * KEELOQ_BATCH_LANES,
+        scalar_time,
+        batch_time);
+}
+
+static bool subghz_keystore_raw_decoder_test(
+    const char* path,
+    const char* name_decoder,
+    uint32_t table_blocks) {
+    SubGhzKeystoreRawStats stats;
+    subghz_keystore_raw_reset_stats();
+    bool result = subghz_decoder_test(path, name_decoder);
+    subghz_keystore_raw_get_stats(&stats);
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %u packets, %lu file opens, %lu AES blocks, %lu cache hits",
+        name_decoder,
+        subghz_test_decoder_count,
+        stats.file_opens,
+        stats.block_decrypts,
+        stats.cache_hits);
+
+    // Table is opened once per decoder lifetime and every block is decrypted once
+    return result && (stats.file_opens <= 1) && (stats.block_decrypts <= table_blocks);
+}
+
+MU_TEST(subghz_keystore_raw_test) {
+    uint8_t table[TEST_NICE_FLOR_S_TABLE_BLOCKS * 16];
+    SubGhzKeystoreRaw* keystore_raw = subghz_keystore_raw_open(NICE_FLOR_S_DIR_NAME);
+    mu_assert(keystore_raw, "Unable to open RAW keystore\r\n");
+    mu_assert(
+        subghz_keystore_raw_read(keystore_raw, 0, table, sizeof(table)),
+        "Unable to read RAW keystore\r\n");
+    for(size_t i = 0; i < sizeof(table); i++) {
+        uint8_t byte = 0;
+        mu_assert(
+            subghz_keystore_raw_read(keystore_raw, i, &byte, 1) && byte == table[i],
+            "Cached RAW keystore data mismatch\r\n");
+        mu_assert(
+            subghz_keystore_raw_get_data(NICE_FLOR_S_DIR_NAME, i, &byte, 1) && byte == table[i],
+            "RAW keystore data mismatch\r\n");
+    }
+    mu_assert(
+        !subghz_keystore_raw_read(keystore_raw, sizeof(table), table, 1),
+        "Read past RAW keystore end\r\n");
+    subghz_keystore_raw_close(keystore_raw);
+
+    mu_assert(
+        subghz_keystore_raw_decoder_test(
+            EXT_PATH("unit_tests/subghz/nice_flor_s_raw.sub"),
+            SUBGHZ_PROTOCOL_NICE_FLOR_S_NAME,
+            TEST_NICE_FLOR_S_TABLE_BLOCKS),
+        "RAW keystore " SUBGHZ_PROTOCOL_NICE_FLOR_S_NAME " access error\r\n");
+    mu_assert(
+        subghz_keystore_raw_decoder_test(
+            EXT_PATH("unit_tests/subghz/came_atomo_raw.sub"),
+            SUBGHZ_PROTOCOL_CAME_ATOMO_NAME,
+            TEST_CAME_ATOMO_TABLE_BLOCKS),
+        "RAW keystore " SUBGHZ_PROTOCOL_CAME_ATOMO_NAME " access error\r\n");
+}
+
+static bool subghz_history_test_set_key(
+    SubGhzProtocolDecoderBase* decoder,
+    FlipperFormat* flipper_format,
+    uint32_t key) {
+    uint32_t bits = 24;
+    uint8_t key_data[sizeof(uint64_t)] = {0};
+    for(size_t i = 0; i < sizeof(uint32_t); i++) {
+        key_data[sizeof(uint64_t) - 1 - i] = key >> (i * 8);
+    }
+    stream_clean(flipper_format_get_raw_stream(flipper_format));
+    return flipper_format_write_uint32(flipper_format, "Bit", &bits, 1) &&
+           flipper_format_write_hex(flipper_format, "Key", key_data, sizeof(key_data)) &&
+           subghz_protocol_decoder_base_deserialize(decoder, flipper_format);
+}
+
+MU_TEST(subghz_history_dedup_test) {
+    SubGhzProtocolDecoderBase* decoder =
+        subghz_receiver_search_decoder_base_by_name(receiver_handler, SUBGHZ_PROTOCOL_CAME_NAME);
+    mu_assert(decoder, "Decoder " SUBGHZ_PROTOCOL_CAME_NAME " not found\r\n");
+
+    SubGhzHistory* history = subghz_history_alloc();
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    SubGhzPresetDefinition preset = {.frequency = 433920000, .data = NULL, .data_size = 0};
+    string_init_set_str(preset.name, "AM650");
+
+    // Repeated frames are dropped all the way, not only until the hash set fills up
+    for(uint32_t key = 1; key <= TEST_HISTORY_RECORDS; key++) {
+        mu_assert(
+            subghz_history_test_set_key(decoder, flipper_format, key),
+            "Unable to set history test key\r\n");
+        mu_assert(
+            subghz_history_add_to_history(history, decoder, &preset),
+            "New signal not added to history\r\n");
+        mu_assert(
+            !subghz_history_add_to_history(history, decoder, &preset),
+            "Repeated signal added to history\r\n");
+    }
+    mu_assert_int_eq(TEST_HISTORY_RECORDS, subghz_history_get_item(history));
+
+    // Recent signals are remembered across generations
+    mu_assert(
+        subghz_history_test_set_key(decoder, flipper_format, TEST_HISTORY_RECORDS - 500),
+        "Unable to set history test key\r\n");
+    mu_assert(
+        !subghz_history_add_to_history(history, decoder, &preset),
+        "Recent signal added to history again\r\n");
+    mu_assert_int_eq(TEST_HISTORY_RECORDS, subghz_history_get_item(history));
+
+    string_clear(preset.name);
+    flipper_format_free(flipper_format);
+    subghz_history_free(history);
+}
+
 //test decoders
 MU_TEST(subghz_decoder_came_atomo_test) {
     mu_assert(
@@ -516,12 +791,45 @@ MU_TEST(subghz_encoder_honeywell_wdb_test) {
 }
 
 MU_TEST(subghz_random_test) {
-    mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
+    mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME, true), "Random test error\r\n");
+}
+
+MU_TEST(subghz_random_no_dispatch_test) {
+    mu_assert(
+        subghz_decode_random_test(TEST_RANDOM_DIR_NAME, false),
+        "Random test without dispatch error\r\n");
+}
+
+MU_TEST(subghz_random_packed_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(
+        subghz_raw_packed_convert(storage, TEST_RANDOM_DIR_NAME, TEST_RANDOM_PACKED_DIR_NAME),
+        "Unable to pack RAW file\r\n");
+
+    FileInfo text_info;
+    FileInfo packed_info;
+    if(storage_common_stat(storage, TEST_RANDOM_DIR_NAME, &text_info) == FSE_OK &&
+       storage_common_stat(storage, TEST_RANDOM_PACKED_DIR_NAME, &packed_info) == FSE_OK) {
+        FURI_LOG_I(
+            TAG,
+            "RAW text %lu bytes, packed %lu bytes",
+            (uint32_t)text_info.size,
+            (uint32_t)packed_info.size);
+    }
+
+    bool result = subghz_decode_random_test(TEST_RANDOM_PACKED_DIR_NAME, true);
+    storage_simply_remove(storage, TEST_RANDOM_PACKED_DIR_NAME);
+    furi_record_close(RECORD_STORAGE);
+    mu_assert(result, "Random packed test error\r\n");
 }
 
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keystore_binary_test);
+    MU_RUN_TEST(subghz_keeloq_batch_test);
+    MU_RUN_TEST(subghz_keystore_raw_test);
+    MU_RUN_TEST(subghz_history_dedup_test);
 
     MU_RUN_TEST(subghz_decoder_came_atomo_test);
     MU_RUN_TEST(subghz_decoder_came_test);
@@ -572,6 +880,8 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_honeywell_wdb_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_random_no_dispatch_test);
+    MU_RUN_TEST(subghz_random_packed_test);
     subghz_test_deinit();
 }
 
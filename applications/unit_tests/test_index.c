@@ -20,6 +20,10 @@ int run_minunit_test_storage();
 int run_minunit_test_subghz();
 int run_minunit_test_dirwalk();
 int run_minunit_test_nfc();
+int run_minunit_test_ecc();
+int run_minunit_test_bad_usb();
+int run_minunit_test_lfrfid();
+int run_minunit_test_gui();
 
 typedef int (*UnitTestEntry)();
 
@@ -39,6 +43,10 @@ const UnitTest unit_tests[] = {
     {.name = "subghz", .entry = run_minunit_test_subghz},
     {.name = "infrared", .entry = run_minunit_test_infrared},
     {.name = "nfc", .entry = run_minunit_test_nfc},
+    {.name = "ecc", .entry = run_minunit_test_ecc},
+    {.name = "bad_usb", .entry = run_minunit_test_bad_usb},
+    {.name = "lfrfid", .entry = run_minunit_test_lfrfid},
+    {.name = "gui", .entry = run_minunit_test_gui},
 };
 
 void minunit_print_progress() {
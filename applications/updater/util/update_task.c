@@ -78,7 +78,7 @@ static UpdateTaskStageGroup update_task_get_task_groups(UpdateTask* update_task)
     if(!string_empty_p(manifest->firmware_dfu_image)) {
         ret |= UpdateTaskStageGroupFirmware;
     }
-    if(!string_empty_p(manifest->resource_bundle)) {
+    if(!string_empty_p(manifest->resource_bundle) || !string_empty_p(manifest->resource_delta)) {
         ret |= UpdateTaskStageGroupResources;
     }
     if(!string_empty_p(manifest->splash_file)) {
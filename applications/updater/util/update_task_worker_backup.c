@@ -9,11 +9,17 @@
 #include <update_util/dfu_file.h>
 #include <update_util/lfs_backup.h>
 #include <update_util/update_operation.h>
+#include <update_util/resources/manifest.h>
+#include <update_util/resources/delta.h>
 #include <toolbox/tar/tar_archive.h>
 #include <toolbox/crc32_calc.h>
+#include <m-dict.h>
 
 #define TAG "UpdWorkerBackup"
 
+/* Resources are large and written once, use bigger chunks than tar block size */
+#define UPDATE_TASK_RESOURCE_BUFFER_SIZE (16 * 1024)
+
 #define CHECK_RESULT(x) \
     if(!(x)) {          \
         break;          \
@@ -37,30 +43,186 @@ static bool update_task_pre_update(UpdateTask* update_task) {
     return success;
 }
 
+typedef struct {
+    uint32_t size;
+    uint8_t hash[16];
+} ResourceFileInfo;
+
+DICT_DEF2(ResourceFileDict, string_t, STRING_OPLIST, ResourceFileInfo, M_POD_OPLIST)
+
 typedef struct {
     UpdateTask* update_task;
-    int32_t total_files, processed_files;
+    int32_t total_files, processed_files, skipped_files;
+    ResourceFileDict_t files;
+    string_t path;
 } TarUnpackProgress;
 
+/* Loads file entries from the bundled resource manifest.
+ * Without it every entry is unpacked */
+static bool update_task_load_resource_manifest(
+    UpdateTask* update_task,
+    TarArchive* archive,
+    TarUnpackProgress* unpack_progress) {
+    bool loaded = false;
+    string_t manifest_path;
+    string_init(manifest_path);
+    path_concat(
+        string_get_cstr(update_task->update_path), RESOURCE_MANIFEST_FILENAME, manifest_path);
+
+    ResourceManifestReader* manifest_reader = resource_manifest_reader_alloc(update_task->storage);
+    do {
+        if(!tar_archive_unpack_file(
+               archive, RESOURCE_MANIFEST_FILENAME, string_get_cstr(manifest_path))) {
+            FURI_LOG_W(TAG, "No resource manifest, unpacking everything");
+            break;
+        }
+
+        if(!resource_manifest_reader_open(manifest_reader, string_get_cstr(manifest_path))) {
+            break;
+        }
+
+        ResourceManifestEntry* entry;
+        while((entry = resource_manifest_reader_next(manifest_reader))) {
+            if(entry->type != ResourceManifestEntryTypeFile) {
+                continue;
+            }
+            ResourceFileInfo info = {.size = entry->size};
+            memcpy(info.hash, entry->hash, sizeof(info.hash));
+            ResourceFileDict_set_at(unpack_progress->files, entry->name, info);
+        }
+        loaded = true;
+    } while(false);
+
+    resource_manifest_reader_free(manifest_reader);
+    storage_simply_remove(update_task->storage, string_get_cstr(manifest_path));
+    string_clear(manifest_path);
+
+    FURI_LOG_I(TAG, "Manifest: %u files", ResourceFileDict_size(unpack_progress->files));
+    return loaded;
+}
+
+/* Checks if the file on SD card matches manifest entry by size and MD5 */
+static bool
+    update_task_resource_is_unchanged(TarUnpackProgress* unpack_progress, const char* name) {
+    string_t key;
+    string_init_set_str(key, name);
+    const ResourceFileInfo* info = ResourceFileDict_cget(unpack_progress->files, key);
+    string_clear(key);
+    if(!info) {
+        return false;
+    }
+
+    Storage* storage = unpack_progress->update_task->storage;
+    path_concat(STORAGE_EXT_PATH_PREFIX, name, unpack_progress->path);
+    const char* path = string_get_cstr(unpack_progress->path);
+
+    FileInfo file_info;
+    if(storage_common_stat(storage, path, &file_info) != FSE_OK ||
+       (file_info.flags & FSF_DIRECTORY) || file_info.size != info->size) {
+        return false;
+    }
+
+    uint8_t hash[16];
+    return (storage_common_digest(storage, path, StorageDigestTypeMd5, hash) == FSE_OK) &&
+           (memcmp(hash, info->hash, sizeof(hash)) == 0);
+}
+
 static bool update_task_resource_unpack_cb(const char* name, bool is_directory, void* context) {
-    UNUSED(name);
-    UNUSED(is_directory);
     TarUnpackProgress* unpack_progress = context;
     unpack_progress->processed_files++;
     update_task_set_progress(
         unpack_progress->update_task,
         UpdateTaskStageProgress,
         unpack_progress->processed_files * 100 / (unpack_progress->total_files + 1));
+
+    if(!is_directory && update_task_resource_is_unchanged(unpack_progress, name)) {
+        unpack_progress->skipped_files++;
+        return false;
+    }
     return true;
 }
 
+static bool update_task_unpack_resource_bundle(UpdateTask* update_task) {
+    TarUnpackProgress progress = {
+        .update_task = update_task,
+        .total_files = 0,
+        .processed_files = 0,
+        .skipped_files = 0,
+    };
+    ResourceFileDict_init(progress.files);
+    string_init(progress.path);
+
+    string_t file_path;
+    string_init(file_path);
+    path_concat(
+        string_get_cstr(update_task->update_path),
+        string_get_cstr(update_task->manifest->resource_bundle),
+        file_path);
+
+    bool unpacked = false;
+    TarArchive* archive = tar_archive_alloc(update_task->storage);
+    if(tar_archive_open(archive, string_get_cstr(file_path), TAR_OPEN_MODE_READ)) {
+        tar_archive_set_unpack_buffer_size(archive, UPDATE_TASK_RESOURCE_BUFFER_SIZE);
+        update_task_load_resource_manifest(update_task, archive, &progress);
+        tar_archive_set_file_callback(archive, update_task_resource_unpack_cb, &progress);
+
+        unpacked = true;
+        progress.total_files = tar_archive_get_entries_count(archive);
+        if(progress.total_files > 0) {
+            unpacked = tar_archive_unpack_to(archive, STORAGE_EXT_PATH_PREFIX, NULL);
+        }
+        FURI_LOG_I(
+            TAG,
+            "Resources: %ld entries, %ld unchanged",
+            progress.total_files,
+            progress.skipped_files);
+    }
+
+    tar_archive_free(archive);
+    string_clear(file_path);
+    string_clear(progress.path);
+    ResourceFileDict_clear(progress.files);
+    return unpacked;
+}
+
+static void update_task_resource_delta_cb(uint32_t processed, uint32_t total, void* context) {
+    UpdateTask* update_task = context;
+    update_task_set_progress(update_task, UpdateTaskStageProgress, processed * 100 / (total + 1));
+}
+
+static ResourceDeltaResult update_task_apply_resource_delta(UpdateTask* update_task) {
+    ResourceDeltaResult result = ResourceDeltaResultError;
+    string_t file_path;
+    string_init(file_path);
+    path_concat(
+        string_get_cstr(update_task->update_path),
+        string_get_cstr(update_task->manifest->resource_delta),
+        file_path);
+
+    TarArchive* archive = tar_archive_alloc(update_task->storage);
+    if(tar_archive_open(archive, string_get_cstr(file_path), TAR_OPEN_MODE_READ)) {
+        tar_archive_set_unpack_buffer_size(archive, UPDATE_TASK_RESOURCE_BUFFER_SIZE);
+        result = resource_delta_apply(
+            update_task->storage,
+            archive,
+            string_get_cstr(update_task->update_path),
+            STORAGE_EXT_PATH_PREFIX,
+            update_task_resource_delta_cb,
+            update_task);
+    }
+    FURI_LOG_I(TAG, "Resource delta: %d", result);
+
+    tar_archive_free(archive);
+    string_clear(file_path);
+    return result;
+}
+
 static bool update_task_post_update(UpdateTask* update_task) {
     bool success = false;
 
     string_t file_path;
     string_init(file_path);
 
-    TarArchive* archive = tar_archive_alloc(update_task->storage);
     do {
         path_concat(
             string_get_cstr(update_task->update_path), LFS_BACKUP_DEFAULT_FILENAME, file_path);
@@ -70,25 +232,17 @@ static bool update_task_post_update(UpdateTask* update_task) {
         CHECK_RESULT(lfs_backup_unpack(update_task->storage, string_get_cstr(file_path)));
 
         if(update_task->state.groups & UpdateTaskStageGroupResources) {
-            TarUnpackProgress progress = {
-                .update_task = update_task,
-                .total_files = 0,
-                .processed_files = 0,
-            };
             update_task_set_progress(update_task, UpdateTaskStageResourcesUpdate, 0);
 
-            path_concat(
-                string_get_cstr(update_task->update_path),
-                string_get_cstr(update_task->manifest->resource_bundle),
-                file_path);
-
-            tar_archive_set_file_callback(archive, update_task_resource_unpack_cb, &progress);
-            CHECK_RESULT(
-                tar_archive_open(archive, string_get_cstr(file_path), TAR_OPEN_MODE_READ));
+            ResourceDeltaResult delta_result = ResourceDeltaResultBaseMismatch;
+            if(!string_empty_p(update_task->manifest->resource_delta)) {
+                delta_result = update_task_apply_resource_delta(update_task);
+            }
 
-            progress.total_files = tar_archive_get_entries_count(archive);
-            if(progress.total_files > 0) {
-                CHECK_RESULT(tar_archive_unpack_to(archive, STORAGE_EXT_PATH_PREFIX, NULL));
+            /* Full bundle also repairs resources after a failed delta */
+            if(delta_result != ResourceDeltaResultOk) {
+                CHECK_RESULT(!string_empty_p(update_task->manifest->resource_bundle));
+                CHECK_RESULT(update_task_unpack_resource_bundle(update_task));
             }
         }
 
@@ -109,7 +263,6 @@ static bool update_task_post_update(UpdateTask* update_task) {
         success = true;
     } while(false);
 
-    tar_archive_free(archive);
     string_clear(file_path);
     return success;
 }
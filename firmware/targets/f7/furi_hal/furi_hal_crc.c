@@ -0,0 +1,56 @@
+#include <furi_hal_crc.h>
+#include <furi.h>
+
+#include <stm32wbxx_ll_bus.h>
+#include <stm32wbxx_ll_crc.h>
+
+#define TAG "FuriHalCrc"
+
+static FuriMutex* furi_hal_crc_mutex = NULL;
+
+void furi_hal_crc_init() {
+    furi_hal_crc_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    FURI_LOG_I(TAG, "Init OK");
+}
+
+bool furi_hal_crc_acquire(uint32_t timeout) {
+    furi_assert(furi_hal_crc_mutex);
+    if(furi_mutex_acquire(furi_hal_crc_mutex, timeout) != FuriStatusOk) {
+        return false;
+    }
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_CRC);
+    return true;
+}
+
+void furi_hal_crc_release() {
+    furi_assert(furi_hal_crc_mutex);
+    LL_AHB1_GRP1_DisableClock(LL_AHB1_GRP1_PERIPH_CRC);
+    furi_check(furi_mutex_release(furi_hal_crc_mutex) == FuriStatusOk);
+}
+
+void furi_hal_crc_reset(uint32_t crc) {
+    LL_CRC_SetPolynomialSize(CRC, LL_CRC_POLYLENGTH_32B);
+    LL_CRC_SetPolynomialCoef(CRC, LL_CRC_DEFAULT_CRC32_POLY);
+    // Reflected input and output, byte order is handled in furi_hal_crc_feed
+    LL_CRC_SetInputDataReverseMode(CRC, LL_CRC_INDATA_REVERSE_BYTE);
+    LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_BIT);
+    // Unit keeps the register before output reversal and final xor
+    LL_CRC_SetInitialData(CRC, __RBIT(~crc));
+    LL_CRC_ResetCRCCalculationUnit(CRC);
+}
+
+uint32_t furi_hal_crc_feed(const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    while(size >= 4) {
+        uint32_t word;
+        memcpy(&word, bytes, sizeof(word));
+        // Unit consumes words MSB first
+        LL_CRC_FeedData32(CRC, __REV(word));
+        bytes += 4;
+        size -= 4;
+    }
+    while(size--) {
+        LL_CRC_FeedData8(CRC, *bytes++);
+    }
+    return ~LL_CRC_ReadData32(CRC);
+}
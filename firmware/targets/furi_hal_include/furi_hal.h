@@ -12,6 +12,7 @@ template <unsigned int N> struct STOP_EXTERNING_ME {};
 #include "furi_hal_cortex.h"
 #include "furi_hal_clock.h"
 #include "furi_hal_crypto.h"
+#include "furi_hal_crc.h"
 #include "furi_hal_console.h"
 #include "furi_hal_debug.h"
 #include "furi_hal_os.h"
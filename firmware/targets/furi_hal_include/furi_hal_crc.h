@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Initialize CRC HAL */
+void furi_hal_crc_init();
+
+/** Acquire CRC unit
+ *
+ * @param      timeout  timeout in ticks
+ *
+ * @return     true if unit is acquired
+ */
+bool furi_hal_crc_acquire(uint32_t timeout);
+
+/** Release CRC unit */
+void furi_hal_crc_release();
+
+/** Start CRC32 (IEEE 802.3) calculation, unit must be acquired
+ *
+ * @param      crc   previous result to continue from, 0 to start over
+ */
+void furi_hal_crc_reset(uint32_t crc);
+
+/** Feed data to CRC unit
+ *
+ * @param      data  data
+ * @param      size  data size
+ *
+ * @return     CRC32 of all data fed since reset
+ */
+uint32_t furi_hal_crc_feed(const void* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -215,6 +215,14 @@ bool furi_hal_hid_kb_release(uint16_t button);
  */
 bool furi_hal_hid_kb_release_all();
 
+/** Replace keyboard state with given modifiers and keys and send one HID report
+ *
+ * @param      mods   modifier keys, KEY_MOD_* shifted right by 8
+ * @param      keys   key codes, pressed in the given order
+ * @param      count  number of keys, up to 6
+ */
+bool furi_hal_hid_kb_set_report(uint8_t mods, const uint8_t* keys, uint8_t count);
+
 /** Set mouse movement and send HID report
  *
  * @param      dx  x coordinate delta
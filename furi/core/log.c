@@ -1,15 +1,48 @@
 #include "log.h"
 #include "check.h"
 #include "mutex.h"
+#include "thread.h"
 #include <furi_hal.h>
+#include <m-string.h>
 
 #define FURI_LOG_LEVEL_DEFAULT FuriLogLevelInfo
 
+#define FURI_LOG_RING_SIZE (4096)
+#define FURI_LOG_RECORD_ARGS_MAX (24)
+#define FURI_LOG_STRING_MAX (48)
+#define FURI_LOG_SPEC_MAX (24)
+#define FURI_LOG_THREAD_STACK_SIZE (2048)
+#define FURI_LOG_THREAD_FLAG_RECORD (1UL << 0)
+
+/* Deferred record, args are raw words: 32-bit values take one word, 64-bit values
+ * and doubles take two, strings are copied as length word followed by zero terminated data */
+typedef struct {
+    uint16_t size; /**< Record size in bytes, written last, 0 if not committed yet */
+    uint8_t level; /**< FuriLogLevelDefault marks padding at the end of the ring */
+    uint8_t args_count; /**< Args size in words */
+    uint32_t timestamp;
+    const char* tag;
+    const char* format;
+    uint32_t args[];
+} FuriLogRecord;
+
+/* Multi-producer single-consumer ring, head and tail are free running byte counters.
+ * Layout is shared with scripts/logring.py */
+typedef struct {
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped;
+    uint8_t buffer[FURI_LOG_RING_SIZE] __attribute__((aligned(4)));
+} FuriLogRing;
+
 typedef struct {
     FuriLogLevel log_level;
     FuriLogPuts puts;
     FuriLogTimestamp timetamp;
     FuriMutex* mutex;
+    FuriLogRing* ring;
+    FuriThread* thread;
+    volatile bool deferred;
 } FuriLogParams;
 
 static FuriLogParams furi_log;
@@ -22,61 +55,365 @@ void furi_log_init() {
     furi_log.mutex = furi_mutex_alloc(FuriMutexTypeNormal);
 }
 
-void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
-    if(level <= furi_log.log_level &&
-       furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+static void furi_log_print_prefix(
+    string_t string,
+    FuriLogLevel level,
+    uint32_t timestamp,
+    const char* tag) {
+    const char* color = FURI_LOG_CLR_RESET;
+    const char* log_letter = " ";
+    switch(level) {
+    case FuriLogLevelError:
+        color = FURI_LOG_CLR_E;
+        log_letter = "E";
+        break;
+    case FuriLogLevelWarn:
+        color = FURI_LOG_CLR_W;
+        log_letter = "W";
+        break;
+    case FuriLogLevelInfo:
+        color = FURI_LOG_CLR_I;
+        log_letter = "I";
+        break;
+    case FuriLogLevelDebug:
+        color = FURI_LOG_CLR_D;
+        log_letter = "D";
+        break;
+    case FuriLogLevelTrace:
+        color = FURI_LOG_CLR_T;
+        log_letter = "T";
+        break;
+    default:
+        break;
+    }
+
+    // Timestamp
+    string_printf(
+        string, "%lu %s[%s][%s] " FURI_LOG_CLR_RESET, timestamp, color, log_letter, tag);
+}
+
+static void
+    furi_log_print_sync(FuriLogLevel level, const char* tag, const char* format, va_list args) {
+    if(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
         string_t string;
         string_init(string);
 
-        const char* color = FURI_LOG_CLR_RESET;
-        const char* log_letter = " ";
-        switch(level) {
-        case FuriLogLevelError:
-            color = FURI_LOG_CLR_E;
-            log_letter = "E";
-            break;
-        case FuriLogLevelWarn:
-            color = FURI_LOG_CLR_W;
-            log_letter = "W";
+        furi_log_print_prefix(string, level, furi_log.timetamp(), tag);
+        furi_log.puts(string_get_cstr(string));
+        string_reset(string);
+
+        string_vprintf(string, format, args);
+
+        furi_log.puts(string_get_cstr(string));
+        string_clear(string);
+
+        furi_log.puts("\r\n");
+
+        furi_mutex_release(furi_log.mutex);
+    }
+}
+
+static bool furi_log_is_static(const void* ptr) {
+    return (size_t)ptr >= furi_hal_flash_get_base() &&
+           (size_t)ptr < (size_t)furi_hal_flash_get_free_start_address();
+}
+
+static bool furi_log_is_spec_char(char c) {
+    return c && strchr("-+ #0123456789.*hlzjtL", c);
+}
+
+/* Copy args described by format into words, returns number of words or -1 if not supported */
+static int32_t furi_log_args_pack(uint32_t* args, const char* format, va_list va) {
+    size_t count = 0;
+    const char* p = format;
+    while((p = strchr(p, '%')) != NULL) {
+        p++;
+        if(*p == '%') {
+            p++;
+            continue;
+        }
+
+        // Two star args and a 64-bit value at most
+        if(count + 4 > FURI_LOG_RECORD_ARGS_MAX) return -1;
+        int32_t precision = -1;
+        uint8_t longs = 0;
+        bool is_precision = false;
+        for(; furi_log_is_spec_char(*p); p++) {
+            if(*p == '*') {
+                int32_t value = va_arg(va, int);
+                args[count++] = value;
+                if(is_precision) precision = value;
+            } else if(*p == '.') {
+                is_precision = true;
+                precision = 0;
+            } else if(is_precision && *p >= '0' && *p <= '9') {
+                precision = precision * 10 + (*p - '0');
+            } else if(*p == 'l') {
+                longs++;
+            } else if(*p == 'j') {
+                longs = 2;
+            }
+        }
+
+        switch(*p) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        case 'c':
+            if(longs >= 2) {
+                uint64_t value = va_arg(va, unsigned long long);
+                memcpy(&args[count], &value, sizeof(value));
+                count += 2;
+            } else if(longs == 1) {
+                args[count++] = va_arg(va, unsigned long);
+            } else {
+                args[count++] = va_arg(va, unsigned int);
+            }
             break;
-        case FuriLogLevelInfo:
-            color = FURI_LOG_CLR_I;
-            log_letter = "I";
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A': {
+            double value = va_arg(va, double);
+            memcpy(&args[count], &value, sizeof(value));
+            count += 2;
             break;
-        case FuriLogLevelDebug:
-            color = FURI_LOG_CLR_D;
-            log_letter = "D";
+        }
+        case 'p':
+            args[count++] = (uintptr_t)va_arg(va, void*);
             break;
-        case FuriLogLevelTrace:
-            color = FURI_LOG_CLR_T;
-            log_letter = "T";
+        case 's': {
+            const char* str = va_arg(va, const char*);
+            if(!str) str = "(null)";
+            size_t max_len = FURI_LOG_STRING_MAX;
+            if(precision >= 0 && (size_t)precision < max_len) max_len = precision;
+            size_t len = strnlen(str, max_len);
+            size_t words = (len + 4) / 4;
+            if(count + 1 + words > FURI_LOG_RECORD_ARGS_MAX) return -1;
+            args[count++] = len;
+            args[count + words - 1] = 0;
+            memcpy(&args[count], str, len);
+            count += words;
             break;
+        }
         default:
+            return -1;
+        }
+        p++;
+    }
+    return count;
+}
+
+static FuriLogRecord* furi_log_ring_reserve(FuriLogRing* ring, size_t size) {
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint32_t pad;
+    do {
+        // Records are never split, the rest of the ring is skipped with padding
+        uint32_t offset = head % FURI_LOG_RING_SIZE;
+        pad = (offset + size > FURI_LOG_RING_SIZE) ? FURI_LOG_RING_SIZE - offset : 0;
+        uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if(head + pad + size - tail > FURI_LOG_RING_SIZE) {
+            __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+    } while(!__atomic_compare_exchange_n(
+        &ring->head, &head, head + pad + size, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+
+    if(pad) {
+        FuriLogRecord* padding = (FuriLogRecord*)&ring->buffer[head % FURI_LOG_RING_SIZE];
+        padding->level = FuriLogLevelDefault;
+        __atomic_store_n(&padding->size, pad, __ATOMIC_RELEASE);
+    }
+    return (FuriLogRecord*)&ring->buffer[(head + pad) % FURI_LOG_RING_SIZE];
+}
+
+static bool
+    furi_log_print_deferred(FuriLogLevel level, const char* tag, const char* format, va_list va) {
+    // Only pointers that outlive the record can be stored as is
+    if(!furi_log_is_static(tag) || !furi_log_is_static(format)) return false;
+
+    uint32_t args[FURI_LOG_RECORD_ARGS_MAX];
+    va_list va_pack;
+    va_copy(va_pack, va);
+    int32_t args_count = furi_log_args_pack(args, format, va_pack);
+    va_end(va_pack);
+    if(args_count < 0) return false;
+
+    size_t size = sizeof(FuriLogRecord) + args_count * sizeof(uint32_t);
+    FuriLogRecord* record = furi_log_ring_reserve(furi_log.ring, size);
+    if(record) {
+        record->level = level;
+        record->args_count = args_count;
+        record->timestamp = furi_log.timetamp();
+        record->tag = tag;
+        record->format = format;
+        memcpy(record->args, args, args_count * sizeof(uint32_t));
+        __atomic_store_n(&record->size, size, __ATOMIC_RELEASE);
+    }
+    furi_thread_flags_set(furi_thread_get_id(furi_log.thread), FURI_LOG_THREAD_FLAG_RECORD);
+    return true;
+}
+
+static void furi_log_record_print(const FuriLogRecord* record, string_t string) {
+    furi_log_print_prefix(string, record->level, record->timestamp, record->tag);
+
+    const uint32_t* args = record->args;
+    const char* p = record->format;
+    char spec[FURI_LOG_SPEC_MAX];
+    while(*p) {
+        const char* next = strchr(p, '%');
+        if(next != p) {
+            size_t len = next ? (size_t)(next - p) : strlen(p);
+            string_cat_printf(string, "%.*s", (int)len, p);
+            p += len;
+            continue;
+        }
+        p++;
+        if(*p == '%') {
+            string_push_back(string, '%');
+            p++;
+            continue;
+        }
+
+        // Rebuild single conversion spec with star args substituted
+        size_t len = 0;
+        uint8_t longs = 0;
+        spec[len++] = '%';
+        for(; furi_log_is_spec_char(*p); p++) {
+            // Overlong spec loses flags and width, but star args and length are always consumed
+            if(*p == '*') {
+                int32_t value = *args++;
+                if(len < FURI_LOG_SPEC_MAX - 12) {
+                    len += snprintf(&spec[len], FURI_LOG_SPEC_MAX - len, "%ld", value);
+                }
+            } else if(strchr("hlzjtL", *p)) {
+                if(*p == 'l') longs++;
+                if(*p == 'j') longs = 2;
+                if(len < FURI_LOG_SPEC_MAX - 2) spec[len++] = *p;
+            } else if(len < FURI_LOG_SPEC_MAX - 12) {
+                spec[len++] = *p;
+            }
+        }
+        spec[len++] = *p;
+        spec[len] = '\0';
+
+        switch(*p) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        case 'c':
+            if(longs >= 2) {
+                uint64_t value;
+                memcpy(&value, args, sizeof(value));
+                string_cat_printf(string, spec, value);
+                args += 2;
+            } else if(longs == 1) {
+                string_cat_printf(string, spec, (unsigned long)*args++);
+            } else {
+                string_cat_printf(string, spec, (unsigned int)*args++);
+            }
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A': {
+            double value;
+            memcpy(&value, args, sizeof(value));
+            string_cat_printf(string, spec, value);
+            args += 2;
+            break;
+        }
+        case 'p':
+            string_cat_printf(string, spec, (void*)(uintptr_t)*args++);
+            break;
+        case 's': {
+            size_t str_len = *args++;
+            string_cat_printf(string, spec, (const char*)args);
+            args += (str_len + 4) / 4;
             break;
         }
+        default:
+            // Checked by furi_log_args_pack
+            furi_crash(NULL);
+        }
+        p++;
+    }
+    string_cat_str(string, "\r\n");
+}
 
-        // Timestamp
-        string_printf(
-            string,
-            "%lu %s[%s][%s] " FURI_LOG_CLR_RESET,
-            furi_log.timetamp(),
-            color,
-            log_letter,
-            tag);
-        furi_log.puts(string_get_cstr(string));
-        string_reset(string);
+static void furi_log_ring_drain(FuriLogRing* ring, string_t string) {
+    uint32_t tail = ring->tail;
+    while(tail != __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)) {
+        FuriLogRecord* record = (FuriLogRecord*)&ring->buffer[tail % FURI_LOG_RING_SIZE];
+        uint16_t size = __atomic_load_n(&record->size, __ATOMIC_ACQUIRE);
+        // Not committed yet, producer will wake us up again
+        if(!size) break;
 
-        va_list args;
-        va_start(args, format);
-        string_vprintf(string, format, args);
-        va_end(args);
+        if(record->level != FuriLogLevelDefault) {
+            furi_log_record_print(record, string);
+            if(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+                furi_log.puts(string_get_cstr(string));
+                furi_mutex_release(furi_log.mutex);
+            }
+        }
 
-        furi_log.puts(string_get_cstr(string));
-        string_clear(string);
+        // Stale data must not look like a committed record
+        memset(record, 0, size);
+        tail += size;
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+    }
+}
 
-        furi_log.puts("\r\n");
+static int32_t furi_log_thread(void* context) {
+    FuriLogRing* ring = context;
+    uint32_t dropped_reported = 0;
+    string_t string;
+    string_init(string);
 
-        furi_mutex_release(furi_log.mutex);
+    while(true) {
+        furi_thread_flags_wait(FURI_LOG_THREAD_FLAG_RECORD, FuriFlagWaitAny, FuriWaitForever);
+        furi_log_ring_drain(ring, string);
+
+        uint32_t dropped = __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+        if(dropped != dropped_reported) {
+            string_printf(
+                string,
+                FURI_LOG_CLR_W "%lu log records dropped" FURI_LOG_CLR_RESET "\r\n",
+                dropped - dropped_reported);
+            if(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+                furi_log.puts(string_get_cstr(string));
+                furi_mutex_release(furi_log.mutex);
+            }
+            dropped_reported = dropped;
+        }
+    }
+
+    string_clear(string);
+    return 0;
+}
+
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
+    if(level <= furi_log.log_level) {
+        va_list args;
+        va_start(args, format);
+        if(!furi_log.deferred || !furi_log_print_deferred(level, tag, format, args)) {
+            furi_log_print_sync(level, tag, format, args);
+        }
+        va_end(args);
     }
 }
 
@@ -100,3 +437,26 @@ void furi_log_set_timestamp(FuriLogTimestamp timestamp) {
     furi_assert(timestamp);
     furi_log.timetamp = timestamp;
 }
+
+void furi_log_set_deferred(bool deferred) {
+    furi_assert(!furi_is_irq_context());
+    if(deferred && !furi_log.thread) {
+        furi_log.ring = malloc(sizeof(FuriLogRing));
+        furi_log.thread = furi_thread_alloc();
+        furi_thread_set_name(furi_log.thread, "LogSrv");
+        furi_thread_set_stack_size(furi_log.thread, FURI_LOG_THREAD_STACK_SIZE);
+        furi_thread_set_priority(furi_log.thread, FuriThreadPriorityLowest);
+        furi_thread_set_context(furi_log.thread, furi_log.ring);
+        furi_thread_set_callback(furi_log.thread, furi_log_thread);
+        furi_thread_start(furi_log.thread);
+    }
+    furi_log.deferred = deferred;
+}
+
+bool furi_log_is_deferred() {
+    return furi_log.deferred;
+}
+
+uint32_t furi_log_get_dropped() {
+    return furi_log.ring ? __atomic_load_n(&furi_log.ring->dropped, __ATOMIC_RELAXED) : 0;
+}
@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdarg.h>
 
 #ifdef __cplusplus
@@ -77,6 +78,31 @@ void furi_log_set_puts(FuriLogPuts puts);
  */
 void furi_log_set_timestamp(FuriLogTimestamp timestamp);
 
+/** Enable or disable deferred logging
+ *
+ * In deferred mode log calls only copy timestamp, tag and format pointers and raw args
+ * into a lock-free ring, records are formatted and printed by a low priority thread.
+ * Records with tag or format outside of flash or with unsupported conversions
+ * are printed immediately. Records that don't fit into the ring are dropped and counted.
+ * String args of deferred records are cut to 48 characters.
+ * Ring can be dumped with a debugger and decoded with scripts/logring.py.
+ *
+ * @param[in]  deferred  true to enable deferred mode
+ */
+void furi_log_set_deferred(bool deferred);
+
+/** Check if deferred logging is enabled
+ *
+ * @return     true if deferred mode is enabled
+ */
+bool furi_log_is_deferred();
+
+/** Get count of records dropped in deferred mode
+ *
+ * @return     dropped records count
+ */
+uint32_t furi_log_get_dropped();
+
 /** Log methods
  *
  * @param      tag     The application tag
@@ -1,4 +1,5 @@
 #include <inttypes.h>
+#include <string.h>
 #include <toolbox/hex.h>
 #include <core/check.h>
 #include "flipper_format_stream.h"
@@ -26,10 +27,49 @@ bool flipper_format_stream_write_eol(Stream* stream) {
     return flipper_format_stream_write(stream, &flipper_format_eoln, 1);
 }
 
+#define FLIPPER_FORMAT_STREAM_BUFFER_SIZE 32
+
+typedef struct {
+    uint8_t buffer[FLIPPER_FORMAT_STREAM_BUFFER_SIZE];
+    const uint8_t* data;
+    size_t size;
+    bool peeked;
+} FlipperFormatStreamChunk;
+
+/**
+ * Get data from the current position, in place if the stream can be peeked, copied otherwise.
+ * Must be followed by flipper_format_stream_chunk_consume.
+ */
+static size_t flipper_format_stream_chunk_get(Stream* stream, FlipperFormatStreamChunk* chunk) {
+    chunk->size = stream_peek(stream, &chunk->data);
+    chunk->peeked = chunk->size > 0;
+    if(!chunk->peeked) {
+        chunk->size = stream_read(stream, chunk->buffer, FLIPPER_FORMAT_STREAM_BUFFER_SIZE);
+        chunk->data = chunk->buffer;
+    }
+    return chunk->size;
+}
+
+/**
+ * Move the rw pointer to the end of the used part of the chunk.
+ */
+static bool flipper_format_stream_chunk_consume(
+    Stream* stream,
+    FlipperFormatStreamChunk* chunk,
+    size_t used) {
+    int32_t offset = chunk->peeked ? (int32_t)used : (int32_t)used - (int32_t)chunk->size;
+    return offset ? stream_seek(stream, offset, StreamOffsetFromCurrent) : true;
+}
+
+static void flipper_format_stream_string_cat(string_t str, const uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        string_push_back(str, data[i]);
+    }
+}
+
 static bool flipper_format_stream_read_valid_key(Stream* stream, string_t key) {
     string_reset(key);
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
+    FlipperFormatStreamChunk chunk;
 
     bool found = false;
     bool error = false;
@@ -37,24 +77,31 @@ static bool flipper_format_stream_read_valid_key(Stream* stream, string_t key) {
     bool new_line = true;
 
     while(true) {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
+        size_t was_read = flipper_format_stream_chunk_get(stream, &chunk);
         if(was_read == 0) break;
 
-        for(size_t i = 0; i < was_read; i++) {
-            uint8_t data = buffer[i];
-            if(data == flipper_format_eoln) {
+        const uint8_t* data = chunk.data;
+        // start of the run of key symbols that is not yet added to the key
+        size_t run = 0;
+        size_t i;
+        for(i = 0; i < was_read; i++) {
+            uint8_t symbol = data[i];
+            if(symbol == flipper_format_eoln) {
                 // EOL found, clean data, start accumulating data and set the new_line flag
                 string_reset(key);
                 accumulate = true;
                 new_line = true;
-            } else if(data == flipper_format_eolr) {
+                run = i + 1;
+            } else if(symbol == flipper_format_eolr) {
                 // ignore
-            } else if(data == flipper_format_comment && new_line) {
+                if(accumulate) flipper_format_stream_string_cat(key, &data[run], i - run);
+                run = i + 1;
+            } else if(symbol == flipper_format_comment && new_line) {
                 // if there is a comment character and we are at the beginning of a new line
                 // do not accumulate comment data and reset the new_line flag
                 accumulate = false;
                 new_line = false;
-            } else if(data == flipper_format_delimiter) {
+            } else if(symbol == flipper_format_delimiter) {
                 if(new_line) {
                     // we are on a "new line" and found the delimiter
                     // this can only be if we have previously found some kind of key, so
@@ -66,13 +113,7 @@ static bool flipper_format_stream_read_valid_key(Stream* stream, string_t key) {
                 } else {
                     // parse the delimiter only if we are accumulating data
                     if(accumulate) {
-                        // we found the delimiter, move the rw pointer to the delimiter location
-                        // and signal that we have found something
-                        if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                            error = true;
-                            break;
-                        }
-
+                        // we found the delimiter, signal that we have found something
                         found = true;
                         break;
                     }
@@ -80,17 +121,21 @@ static bool flipper_format_stream_read_valid_key(Stream* stream, string_t key) {
             } else {
                 // just new symbol, reset the new_line flag
                 new_line = false;
-                if(accumulate) {
-                    // and accumulate data if we want
-                    string_push_back(key, data);
-                }
             }
         }
 
+        // add the rest of the run, the delimiter is not a part of the key
+        if(accumulate) flipper_format_stream_string_cat(key, &data[run], i - run);
+
+        // move the rw pointer to the delimiter location or to the end of the chunk
+        if(!flipper_format_stream_chunk_consume(stream, &chunk, i)) {
+            error = true;
+        }
+
         if(found || error) break;
     }
 
-    return found;
+    return found && !error;
 }
 
 bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool strict_mode) {
@@ -119,57 +164,59 @@ bool flipper_format_stream_seek_to_key(Stream* stream, const char* key, bool str
 
 static bool flipper_format_stream_read_value(Stream* stream, string_t value, bool* last) {
     string_reset(value);
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
+    FlipperFormatStreamChunk chunk;
     bool result = false;
     bool error = false;
 
     while(true) {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
+        size_t was_read = flipper_format_stream_chunk_get(stream, &chunk);
 
         if(was_read == 0) {
             // check EOF
             if(stream_eof(stream) && string_size(value) > 0) {
                 result = true;
                 *last = true;
-                break;
             }
+            break;
         }
 
-        for(uint16_t i = 0; i < was_read; i++) {
-            uint8_t data = buffer[i];
-            if(data == flipper_format_eoln) {
-                if(string_size(value) > 0) {
-                    if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                        error = true;
-                        break;
-                    }
-
+        const uint8_t* data = chunk.data;
+        // start of the run of value symbols that is not yet added to the value
+        size_t run = 0;
+        size_t i;
+        for(i = 0; i < was_read; i++) {
+            uint8_t symbol = data[i];
+            if(symbol == flipper_format_eoln) {
+                if(string_size(value) > 0 || i > run) {
                     result = true;
                     *last = true;
-                    break;
                 } else {
+                    i++;
                     error = true;
                 }
-            } else if(data == ' ') {
-                if(string_size(value) > 0) {
-                    if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                        error = true;
-                        break;
-                    }
-
+                break;
+            } else if(symbol == ' ') {
+                if(string_size(value) > 0 || i > run) {
                     result = true;
                     *last = false;
                     break;
                 }
-
-            } else if(data == flipper_format_eolr) {
+                run = i + 1;
+            } else if(symbol == flipper_format_eolr) {
                 // Ignore
-            } else {
-                string_push_back(value, data);
+                flipper_format_stream_string_cat(value, &data[run], i - run);
+                run = i + 1;
             }
         }
 
+        flipper_format_stream_string_cat(value, &data[run], i - run);
+
+        // move the rw pointer to the value separator or to the end of the chunk
+        if(!flipper_format_stream_chunk_consume(stream, &chunk, i)) {
+            result = false;
+            error = true;
+        }
+
         if(error || result) break;
     }
 
@@ -178,69 +225,41 @@ static bool flipper_format_stream_read_value(Stream* stream, string_t value, boo
 
 static bool flipper_format_stream_read_line(Stream* stream, string_t str_result) {
     string_reset(str_result);
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
+    FlipperFormatStreamChunk chunk;
 
     do {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
+        size_t was_read = flipper_format_stream_chunk_get(stream, &chunk);
         if(was_read == 0) break;
 
-        bool result = false;
-        bool error = false;
-
-        for(size_t i = 0; i < was_read; i++) {
-            uint8_t data = buffer[i];
-            if(data == flipper_format_eoln) {
-                if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                    error = true;
-                    break;
-                }
-
-                result = true;
-                break;
-            } else if(data == flipper_format_eolr) {
-                // Ignore
-            } else {
-                string_push_back(str_result, data);
-            }
+        const uint8_t* eol = memchr(chunk.data, flipper_format_eoln, was_read);
+        size_t line_size = eol ? (size_t)(eol - chunk.data) : was_read;
+        for(size_t i = 0; i < line_size; i++) {
+            if(chunk.data[i] != flipper_format_eolr) string_push_back(str_result, chunk.data[i]);
         }
 
-        if(result || error) {
-            break;
-        }
+        if(!flipper_format_stream_chunk_consume(stream, &chunk, line_size) || eol) break;
     } while(true);
 
     return string_size(str_result) != 0;
 }
 
 static bool flipper_format_stream_seek_to_next_line(Stream* stream) {
-    const size_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
+    FlipperFormatStreamChunk chunk;
     bool result = false;
-    bool error = false;
 
     do {
-        size_t was_read = stream_read(stream, buffer, buffer_size);
+        size_t was_read = flipper_format_stream_chunk_get(stream, &chunk);
         if(was_read == 0) {
-            if(stream_eof(stream)) {
-                result = true;
-                break;
-            }
+            result = stream_eof(stream);
+            break;
         }
 
-        for(size_t i = 0; i < was_read; i++) {
-            if(buffer[i] == flipper_format_eoln) {
-                if(!stream_seek(stream, i - was_read, StreamOffsetFromCurrent)) {
-                    error = true;
-                    break;
-                }
-
-                result = true;
-                break;
-            }
-        }
+        const uint8_t* eol = memchr(chunk.data, flipper_format_eoln, was_read);
+        size_t used = eol ? (size_t)(eol - chunk.data) : was_read;
+        if(!flipper_format_stream_chunk_consume(stream, &chunk, used)) break;
 
-        if(result || error) {
+        if(eol) {
+            result = true;
             break;
         }
     } while(true);
@@ -9,14 +9,18 @@
 
 static void infrared_common_decoder_reset_state(InfraredCommonDecoder* decoder);
 
-static inline size_t consume_samples(uint32_t* array, size_t len, size_t shift) {
-    furi_assert(len >= shift);
-    len -= shift;
-    for(size_t i = 0; i < len; ++i) {
-        array[i] = array[i + shift];
-    }
+static inline void consume_samples(InfraredCommonDecoder* decoder, uint8_t shift) {
+    furi_assert(decoder->timings_cnt >= shift);
+    decoder->timings_head = (decoder->timings_head + shift) & INFRARED_COMMON_DECODER_TIMINGS_MASK;
+    decoder->timings_cnt -= shift;
+}
 
-    return len;
+static void infrared_common_timing_window_init(
+    InfraredCommonTimingWindow* window,
+    uint32_t timing,
+    uint32_t tolerance) {
+    window->min = (timing > tolerance) ? (timing - tolerance) : 0;
+    window->max = timing + tolerance;
 }
 
 static inline void accumulate_lsb(InfraredCommonDecoder* decoder, bool bit) {
@@ -44,7 +48,7 @@ static bool infrared_check_preamble(InfraredCommonDecoder* decoder) {
 
     // align to start at Mark timing
     if(!start_level) {
-        decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 1);
+        consume_samples(decoder, 1);
     }
 
     if(decoder->protocol->timings.preamble_mark == 0) {
@@ -52,16 +56,14 @@ static bool infrared_check_preamble(InfraredCommonDecoder* decoder) {
     }
 
     while((!result) && (decoder->timings_cnt >= 2)) {
-        float preamble_tolerance = decoder->protocol->timings.preamble_tolerance;
-        uint16_t preamble_mark = decoder->protocol->timings.preamble_mark;
-        uint16_t preamble_space = decoder->protocol->timings.preamble_space;
-
-        if((MATCH_TIMING(decoder->timings[0], preamble_mark, preamble_tolerance)) &&
-           (MATCH_TIMING(decoder->timings[1], preamble_space, preamble_tolerance))) {
+        if(infrared_common_match_timing(
+               &decoder->windows.preamble_mark, infrared_common_decoder_get_timing(decoder, 0)) &&
+           infrared_common_match_timing(
+               &decoder->windows.preamble_space, infrared_common_decoder_get_timing(decoder, 1))) {
             result = true;
         }
 
-        decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 2);
+        consume_samples(decoder, 2);
     }
 
     return result;
@@ -80,7 +82,7 @@ static InfraredStatus infrared_common_decode_bits(InfraredCommonDecoder* decoder
 
     while(decoder->timings_cnt && (status == InfraredStatusOk)) {
         bool level = (decoder->level + decoder->timings_cnt + 1) % 2;
-        uint32_t timing = decoder->timings[0];
+        uint32_t timing = infrared_common_decoder_get_timing(decoder, 0);
 
         if(timings->min_split_time && !level) {
             if(timing > timings->min_split_time) {
@@ -104,7 +106,7 @@ static InfraredStatus infrared_common_decode_bits(InfraredCommonDecoder* decoder
         if(status == InfraredStatusError) {
             break;
         }
-        decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 1);
+        consume_samples(decoder, 1);
 
         /* check if largest protocol version can be decoded */
         if(level && (decoder->protocol->databit_len[0] == decoder->databit_cnt) &&
@@ -123,27 +125,26 @@ InfraredStatus
     furi_assert(decoder);
 
     InfraredStatus status = InfraredStatusOk;
-    uint32_t bit_tolerance = decoder->protocol->timings.bit_tolerance;
-    uint16_t bit1_mark = decoder->protocol->timings.bit1_mark;
-    uint16_t bit1_space = decoder->protocol->timings.bit1_space;
-    uint16_t bit0_mark = decoder->protocol->timings.bit0_mark;
-    uint16_t bit0_space = decoder->protocol->timings.bit0_space;
+    const InfraredCommonTimingWindows* windows = &decoder->windows;
+    bool same_mark =
+        (decoder->protocol->timings.bit1_mark == decoder->protocol->timings.bit0_mark);
 
-    bool analyze_timing = level ^ (bit1_mark == bit0_mark);
-    uint16_t bit1 = level ? bit1_mark : bit1_space;
-    uint16_t bit0 = level ? bit0_mark : bit0_space;
-    uint16_t no_info_timing = (bit1_mark == bit0_mark) ? bit1_mark : bit1_space;
+    bool analyze_timing = level ^ same_mark;
+    const InfraredCommonTimingWindow* bit1 = level ? &windows->bit1_mark : &windows->bit1_space;
+    const InfraredCommonTimingWindow* bit0 = level ? &windows->bit0_mark : &windows->bit0_space;
+    const InfraredCommonTimingWindow* no_info_timing =
+        same_mark ? &windows->bit1_mark : &windows->bit1_space;
 
     if(analyze_timing) {
-        if(MATCH_TIMING(timing, bit1, bit_tolerance)) {
+        if(infrared_common_match_timing(bit1, timing)) {
             accumulate_lsb(decoder, 1);
-        } else if(MATCH_TIMING(timing, bit0, bit_tolerance)) {
+        } else if(infrared_common_match_timing(bit0, timing)) {
             accumulate_lsb(decoder, 0);
         } else {
             status = InfraredStatusError;
         }
     } else {
-        if(!MATCH_TIMING(timing, no_info_timing, bit_tolerance)) {
+        if(!infrared_common_match_timing(no_info_timing, timing)) {
             status = InfraredStatusError;
         }
     }
@@ -155,14 +156,12 @@ InfraredStatus
 InfraredStatus
     infrared_common_decode_manchester(InfraredCommonDecoder* decoder, bool level, uint32_t timing) {
     furi_assert(decoder);
-    uint32_t bit = decoder->protocol->timings.bit1_mark;
-    uint32_t tolerance = decoder->protocol->timings.bit_tolerance;
 
     bool* switch_detect = &decoder->switch_detect;
     furi_assert((*switch_detect == true) || (*switch_detect == false));
 
-    bool single_timing = MATCH_TIMING(timing, bit, tolerance);
-    bool double_timing = MATCH_TIMING(timing, 2 * bit, tolerance);
+    bool single_timing = infrared_common_match_timing(&decoder->windows.bit1_mark, timing);
+    bool double_timing = infrared_common_match_timing(&decoder->windows.bit_double, timing);
 
     if(!single_timing && !double_timing) {
         return InfraredStatusError;
@@ -232,9 +231,11 @@ InfraredMessage*
     }
     decoder->level = level; // start with low level (Space timing)
 
-    decoder->timings[decoder->timings_cnt] = duration;
+    furi_check(decoder->timings_cnt < INFRARED_COMMON_DECODER_TIMINGS_SIZE);
+    decoder->timings
+        [(decoder->timings_head + decoder->timings_cnt) & INFRARED_COMMON_DECODER_TIMINGS_MASK] =
+        duration;
     decoder->timings_cnt++;
-    furi_check(decoder->timings_cnt <= sizeof(decoder->timings));
 
     while(1) {
         switch(decoder->state) {
@@ -291,6 +292,26 @@ void* infrared_common_decoder_alloc(const InfraredCommonProtocolSpec* protocol)
     InfraredCommonDecoder* decoder = malloc(alloc_size);
     decoder->protocol = protocol;
     decoder->level = true;
+
+    const InfraredTimings* timings = &protocol->timings;
+    InfraredCommonTimingWindows* windows = &decoder->windows;
+    infrared_common_timing_window_init(
+        &windows->preamble_mark, timings->preamble_mark, timings->preamble_tolerance);
+    infrared_common_timing_window_init(
+        &windows->preamble_space, timings->preamble_space, timings->preamble_tolerance);
+    infrared_common_timing_window_init(
+        &windows->bit1_mark, timings->bit1_mark, timings->bit_tolerance);
+    infrared_common_timing_window_init(
+        &windows->bit1_space, timings->bit1_space, timings->bit_tolerance);
+    infrared_common_timing_window_init(
+        &windows->bit0_mark, timings->bit0_mark, timings->bit_tolerance);
+    infrared_common_timing_window_init(
+        &windows->bit0_space, timings->bit0_space, timings->bit_tolerance);
+    infrared_common_timing_window_init(
+        &windows->bit_double, 2 * timings->bit1_mark, timings->bit_tolerance);
+    infrared_common_timing_window_init(
+        &windows->bit_triple, 3 * timings->bit1_mark, timings->bit_tolerance);
+
     return decoder;
 }
 
@@ -306,7 +327,7 @@ void infrared_common_decoder_reset_state(InfraredCommonDecoder* decoder) {
     decoder->message.protocol = InfraredProtocolUnknown;
     if(decoder->protocol->timings.preamble_mark == 0) {
         if(decoder->timings_cnt > 0) {
-            decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 1);
+            consume_samples(decoder, 1);
         }
     }
 }
@@ -6,6 +6,10 @@
 
 #define MATCH_TIMING(x, v, delta) (((x) < (v + delta)) && ((x) > (v - delta)))
 
+/* Power of 2, timings are kept in ring buffer */
+#define INFRARED_COMMON_DECODER_TIMINGS_SIZE 8
+#define INFRARED_COMMON_DECODER_TIMINGS_MASK (INFRARED_COMMON_DECODER_TIMINGS_SIZE - 1)
+
 typedef struct InfraredCommonDecoder InfraredCommonDecoder;
 typedef struct InfraredCommonEncoder InfraredCommonEncoder;
 
@@ -27,6 +31,24 @@ typedef struct {
     InfraredCommonEncode encode_repeat;
 } InfraredCommonProtocolSpec;
 
+/* Timing matches window if min < timing < max, same as MATCH_TIMING() */
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+} InfraredCommonTimingWindow;
+
+/* Windows precalculated from protocol timings on decoder allocation */
+typedef struct {
+    InfraredCommonTimingWindow preamble_mark;
+    InfraredCommonTimingWindow preamble_space;
+    InfraredCommonTimingWindow bit1_mark;
+    InfraredCommonTimingWindow bit1_space;
+    InfraredCommonTimingWindow bit0_mark;
+    InfraredCommonTimingWindow bit0_space;
+    InfraredCommonTimingWindow bit_double; /* manchester: 2 * bit1_mark */
+    InfraredCommonTimingWindow bit_triple; /* manchester: 3 * bit1_mark */
+} InfraredCommonTimingWindows;
+
 typedef enum {
     InfraredCommonDecoderStateWaitPreamble,
     InfraredCommonDecoderStateDecode,
@@ -43,9 +65,11 @@ typedef enum {
 struct InfraredCommonDecoder {
     const InfraredCommonProtocolSpec* protocol;
     void* context;
-    uint32_t timings[6];
+    InfraredCommonTimingWindows windows;
+    uint32_t timings[INFRARED_COMMON_DECODER_TIMINGS_SIZE];
     InfraredMessage message;
     InfraredCommonStateDecoder state;
+    uint8_t timings_head;
     uint8_t timings_cnt;
     bool switch_detect;
     bool level;
@@ -65,6 +89,17 @@ struct InfraredCommonEncoder {
     uint8_t data[];
 };
 
+static inline bool
+    infrared_common_match_timing(const InfraredCommonTimingWindow* window, uint32_t timing) {
+    return (timing > window->min) && (timing < window->max);
+}
+
+/* index 0 is the oldest timing not consumed yet */
+static inline uint32_t
+    infrared_common_decoder_get_timing(const InfraredCommonDecoder* decoder, uint8_t index) {
+    return decoder->timings[(decoder->timings_head + index) & INFRARED_COMMON_DECODER_TIMINGS_MASK];
+}
+
 InfraredMessage*
     infrared_common_decode(InfraredCommonDecoder* decoder, bool level, uint32_t duration);
 InfraredStatus
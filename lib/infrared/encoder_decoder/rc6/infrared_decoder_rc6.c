@@ -61,11 +61,10 @@ InfraredStatus infrared_decoder_rc6_decode_manchester(
     // 4th bit lasts 2x times more
     InfraredStatus status = InfraredStatusError;
     uint32_t bit = decoder->protocol->timings.bit1_mark;
-    uint32_t tolerance = decoder->protocol->timings.bit_tolerance;
 
-    bool single_timing = MATCH_TIMING(timing, bit, tolerance);
-    bool double_timing = MATCH_TIMING(timing, 2 * bit, tolerance);
-    bool triple_timing = MATCH_TIMING(timing, 3 * bit, tolerance);
+    bool single_timing = infrared_common_match_timing(&decoder->windows.bit1_mark, timing);
+    bool double_timing = infrared_common_match_timing(&decoder->windows.bit_double, timing);
+    bool triple_timing = infrared_common_match_timing(&decoder->windows.bit_triple, timing);
 
     if(decoder->databit_cnt == 4) {
         furi_assert(decoder->switch_detect == true);
@@ -34,19 +34,27 @@ bool infrared_decoder_samsung32_interpret(InfraredCommonDecoder* decoder) {
 InfraredStatus infrared_decoder_samsung32_decode_repeat(InfraredCommonDecoder* decoder) {
     furi_assert(decoder);
 
-    float preamble_tolerance = decoder->protocol->timings.preamble_tolerance;
+    uint32_t preamble_tolerance = decoder->protocol->timings.preamble_tolerance;
     uint32_t bit_tolerance = decoder->protocol->timings.bit_tolerance;
     InfraredStatus status = InfraredStatusError;
 
     if(decoder->timings_cnt < 6) return InfraredStatusOk;
 
-    if((decoder->timings[0] > INFRARED_SAMSUNG_REPEAT_PAUSE_MIN) &&
-       (decoder->timings[0] < INFRARED_SAMSUNG_REPEAT_PAUSE_MAX) &&
-       MATCH_TIMING(decoder->timings[1], INFRARED_SAMSUNG_REPEAT_MARK, preamble_tolerance) &&
-       MATCH_TIMING(decoder->timings[2], INFRARED_SAMSUNG_REPEAT_SPACE, preamble_tolerance) &&
-       MATCH_TIMING(decoder->timings[3], decoder->protocol->timings.bit1_mark, bit_tolerance) &&
-       MATCH_TIMING(decoder->timings[4], decoder->protocol->timings.bit1_space, bit_tolerance) &&
-       MATCH_TIMING(decoder->timings[5], decoder->protocol->timings.bit1_mark, bit_tolerance)) {
+    uint32_t pause = infrared_common_decoder_get_timing(decoder, 0);
+    uint32_t repeat_mark = infrared_common_decoder_get_timing(decoder, 1);
+    uint32_t repeat_space = infrared_common_decoder_get_timing(decoder, 2);
+    uint32_t bit1_mark = infrared_common_decoder_get_timing(decoder, 3);
+    uint32_t bit1_space = infrared_common_decoder_get_timing(decoder, 4);
+    uint32_t stop_mark = infrared_common_decoder_get_timing(decoder, 5);
+    const InfraredTimings* timings = &decoder->protocol->timings;
+
+    if((pause > INFRARED_SAMSUNG_REPEAT_PAUSE_MIN) &&
+       (pause < INFRARED_SAMSUNG_REPEAT_PAUSE_MAX) &&
+       MATCH_TIMING(repeat_mark, INFRARED_SAMSUNG_REPEAT_MARK, preamble_tolerance) &&
+       MATCH_TIMING(repeat_space, INFRARED_SAMSUNG_REPEAT_SPACE, preamble_tolerance) &&
+       MATCH_TIMING(bit1_mark, timings->bit1_mark, bit_tolerance) &&
+       MATCH_TIMING(bit1_space, timings->bit1_space, bit_tolerance) &&
+       MATCH_TIMING(stop_mark, timings->bit1_mark, bit_tolerance)) {
         status = InfraredStatusReady;
         decoder->timings_cnt = 0;
     } else {
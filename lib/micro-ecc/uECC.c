@@ -943,6 +943,10 @@ uECC_VLI_API int uECC_generate_random_int(uECC_word_t *random,
     return 0;
 }
 
+#if uECC_FIXED_BASE_COMB
+#include "fixed-base.inc"
+#endif
+
 static uECC_word_t EccPoint_compute_public_key(uECC_word_t *result,
                                                uECC_word_t *private_key,
                                                uECC_Curve curve) {
@@ -952,6 +956,12 @@ static uECC_word_t EccPoint_compute_public_key(uECC_word_t *result,
     uECC_word_t *initial_Z = 0;
     uECC_word_t carry;
 
+#if uECC_FIXED_BASE_COMB
+    if (EccPoint_mult_fixed_base(result, private_key, curve)) {
+        return 1;
+    }
+#endif
+
     /* Regularize the bitcount for the private key so that attackers cannot use a side channel
        attack to learn the number of leading zeros. */
     carry = regularize_k(private_key, tmp1, tmp2, curve);
@@ -1269,16 +1279,21 @@ static int uECC_sign_with_k_internal(const uint8_t *private_key,
         return 0;
     }
 
-    carry = regularize_k(k, tmp, s, curve);
-    /* If an RNG function was specified, try to get a random initial Z value to improve
-       protection against side-channel attacks. */
-    if (g_rng_function) {
-        if (!uECC_generate_random_int(k2[carry], curve->p, num_words)) {
-            return 0;
+#if uECC_FIXED_BASE_COMB
+    if (!EccPoint_mult_fixed_base(p, k, curve))
+#endif
+    {
+        carry = regularize_k(k, tmp, s, curve);
+        /* If an RNG function was specified, try to get a random initial Z value to improve
+           protection against side-channel attacks. */
+        if (g_rng_function) {
+            if (!uECC_generate_random_int(k2[carry], curve->p, num_words)) {
+                return 0;
+            }
+            initial_Z = k2[carry];
         }
-        initial_Z = k2[carry];
+        EccPoint_mult(p, curve->G, k2[!carry], initial_Z, num_n_bits + 1, curve);
     }
-    EccPoint_mult(p, curve->G, k2[!carry], initial_Z, num_n_bits + 1, curve);
     if (uECC_vli_isZero(p, num_words)) {
         return 0;
     }
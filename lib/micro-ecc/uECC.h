@@ -69,6 +69,13 @@ the same endianness. */
     #define uECC_SUPPORTS_secp256k1 1
 #endif
 
+/* uECC_FIXED_BASE_COMB - If enabled (defined as nonzero), public key computation and signing on
+secp256r1 use a comb with a precomputed 2 KB table of generator multiples instead of the generic
+Montgomery ladder. Several times faster, but increases code size. */
+#ifndef uECC_FIXED_BASE_COMB
+    #define uECC_FIXED_BASE_COMB uECC_SUPPORTS_secp256r1
+#endif
+
 /* Specifies whether compressed point format is supported.
    Set to 0 to disable point compression/decompression functions. */
 #ifndef uECC_SUPPORT_COMPRESSED_POINT
@@ -2,6 +2,7 @@
 
 #include <lib/toolbox/args.h>
 #include <lib/flipper_format/flipper_format.h>
+#include <lib/nfc/protocols/nfc_util.h>
 
 #define MF_CLASSIC_DICT_FLIPPER_PATH EXT_PATH("nfc/assets/mf_classic_dict.nfc")
 #define MF_CLASSIC_DICT_USER_PATH EXT_PATH("nfc/assets/mf_classic_dict_user.nfc")
@@ -9,12 +10,113 @@
 #define TAG "MfClassicDict"
 
 #define NFC_MF_CLASSIC_KEY_LEN (13)
+#define MF_CLASSIC_DICT_KEY_SIZE (6)
 
 struct MfClassicDict {
     Stream* stream;
     uint32_t total_keys;
+    // Unique keys in file order, MF_CLASSIC_DICT_KEY_SIZE bytes each, NULL if read from stream
+    uint8_t* keys;
+    uint32_t key_index;
+    uint64_t found_keys[MF_CLASSIC_DICT_FOUND_KEYS_MAX];
+    uint8_t found_count;
+    uint8_t found_index;
 };
 
+static bool mf_classic_dict_parse_key(string_t line, uint64_t* key) {
+    if(string_get_char(line, 0) == '#') return false;
+    if(string_size(line) != NFC_MF_CLASSIC_KEY_LEN) return false;
+
+    uint8_t key_byte_tmp = 0;
+    *key = 0ULL;
+    for(uint8_t i = 0; i < 12; i += 2) {
+        if(!args_char_to_hex(
+               string_get_char(line, i), string_get_char(line, i + 1), &key_byte_tmp)) {
+            return false;
+        }
+        *key |= (uint64_t)key_byte_tmp << 8 * (5 - i / 2);
+    }
+    return true;
+}
+
+static int mf_classic_dict_key_cmp(const void* a, const void* b) {
+    uint64_t key_a = *(const uint64_t*)a;
+    uint64_t key_b = *(const uint64_t*)b;
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+static size_t mf_classic_dict_lower_bound(const uint64_t* keys, size_t count, uint64_t key) {
+    size_t left = 0;
+    while(count) {
+        size_t half = count / 2;
+        if(keys[left + half] < key) {
+            left += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return left;
+}
+
+static bool mf_classic_dict_load_keys(MfClassicDict* dict) {
+    // Every key line takes at least NFC_MF_CLASSIC_KEY_LEN bytes
+    size_t keys_max = stream_size(dict->stream) / NFC_MF_CLASSIC_KEY_LEN + 1;
+    // Parsed keys and their sorted copy are needed at the same time
+    if(keys_max * sizeof(uint64_t) * 2 > memmgr_heap_get_max_free_block() / 2) {
+        FURI_LOG_W(TAG, "Not enough memory, reading keys from file");
+        return false;
+    }
+
+    uint64_t* keys = malloc(keys_max * sizeof(uint64_t));
+    size_t keys_count = 0;
+    string_t next_line;
+    string_init(next_line);
+    while(keys_count < keys_max) {
+        if(!stream_read_line(dict->stream, next_line)) break;
+        if(!mf_classic_dict_parse_key(next_line, &keys[keys_count])) continue;
+        keys_count++;
+    }
+    string_clear(next_line);
+
+    // Drop duplicates, keeping the first occurrence to preserve the file order
+    uint64_t* keys_sorted = malloc(keys_count * sizeof(uint64_t) + 1);
+    memcpy(keys_sorted, keys, keys_count * sizeof(uint64_t));
+    qsort(keys_sorted, keys_count, sizeof(uint64_t), mf_classic_dict_key_cmp);
+    uint8_t* keys_seen = malloc(keys_count / 8 + 1);
+    memset(keys_seen, 0, keys_count / 8 + 1);
+
+    // Packed keys never outrun the parsed ones, so the same buffer is reused
+    uint8_t* keys_packed = (uint8_t*)keys;
+    dict->total_keys = 0;
+    for(size_t i = 0; i < keys_count; i++) {
+        uint64_t key = keys[i];
+        size_t pos = mf_classic_dict_lower_bound(keys_sorted, keys_count, key);
+        if(keys_seen[pos / 8] & (1 << (pos % 8))) continue;
+        keys_seen[pos / 8] |= 1 << (pos % 8);
+        nfc_util_num2bytes(
+            key,
+            MF_CLASSIC_DICT_KEY_SIZE,
+            &keys_packed[dict->total_keys * MF_CLASSIC_DICT_KEY_SIZE]);
+        dict->total_keys++;
+    }
+    free(keys_seen);
+    free(keys_sorted);
+
+    dict->keys = realloc(keys, dict->total_keys * MF_CLASSIC_DICT_KEY_SIZE + 1);
+    if(keys_count != dict->total_keys) {
+        FURI_LOG_I(TAG, "Skipped %d duplicate keys", keys_count - dict->total_keys);
+    }
+    return true;
+}
+
+static bool mf_classic_dict_is_key_found(MfClassicDict* dict, uint64_t key) {
+    for(size_t i = 0; i < dict->found_count; i++) {
+        if(dict->found_keys[i] == key) return true;
+    }
+    return false;
+}
+
 bool mf_classic_dict_check_presence(MfClassicDictType dict_type) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
 
@@ -52,16 +154,18 @@ MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
             }
         }
 
-        // Read total amount of keys
-        string_t next_line;
-        string_init(next_line);
-        while(true) {
-            if(!stream_read_line(dict->stream, next_line)) break;
-            if(string_get_char(next_line, 0) == '#') continue;
-            if(string_size(next_line) != NFC_MF_CLASSIC_KEY_LEN) continue;
-            dict->total_keys++;
+        if(!mf_classic_dict_load_keys(dict)) {
+            // Read total amount of keys
+            string_t next_line;
+            string_init(next_line);
+            uint64_t key;
+            while(true) {
+                if(!stream_read_line(dict->stream, next_line)) break;
+                if(!mf_classic_dict_parse_key(next_line, &key)) continue;
+                dict->total_keys++;
+            }
+            string_clear(next_line);
         }
-        string_clear(next_line);
         stream_rewind(dict->stream);
 
         dict_loaded = true;
@@ -83,6 +187,7 @@ void mf_classic_dict_free(MfClassicDict* dict) {
 
     buffered_file_stream_close(dict->stream);
     stream_free(dict->stream);
+    if(dict->keys) free(dict->keys);
     free(dict);
 }
 
@@ -96,25 +201,30 @@ bool mf_classic_dict_get_next_key(MfClassicDict* dict, uint64_t* key) {
     furi_assert(dict);
     furi_assert(dict->stream);
 
-    uint8_t key_byte_tmp = 0;
-    string_t next_line;
-    string_init(next_line);
+    if(dict->found_index < dict->found_count) {
+        *key = dict->found_keys[dict->found_index++];
+        return true;
+    }
 
     bool key_read = false;
-    *key = 0ULL;
-    while(!key_read) {
-        if(!stream_read_line(dict->stream, next_line)) break;
-        if(string_get_char(next_line, 0) == '#') continue;
-        if(string_size(next_line) != NFC_MF_CLASSIC_KEY_LEN) continue;
-        for(uint8_t i = 0; i < 12; i += 2) {
-            args_char_to_hex(
-                string_get_char(next_line, i), string_get_char(next_line, i + 1), &key_byte_tmp);
-            *key |= (uint64_t)key_byte_tmp << 8 * (5 - i / 2);
+    if(dict->keys) {
+        while(!key_read && dict->key_index < dict->total_keys) {
+            *key = nfc_util_bytes2num(
+                &dict->keys[dict->key_index++ * MF_CLASSIC_DICT_KEY_SIZE],
+                MF_CLASSIC_DICT_KEY_SIZE);
+            key_read = !mf_classic_dict_is_key_found(dict, *key);
         }
-        key_read = true;
+    } else {
+        string_t next_line;
+        string_init(next_line);
+        while(!key_read) {
+            if(!stream_read_line(dict->stream, next_line)) break;
+            if(!mf_classic_dict_parse_key(next_line, key)) continue;
+            key_read = !mf_classic_dict_is_key_found(dict, *key);
+        }
+        string_clear(next_line);
     }
 
-    string_clear(next_line);
     return key_read;
 }
 
@@ -122,7 +232,19 @@ bool mf_classic_dict_rewind(MfClassicDict* dict) {
     furi_assert(dict);
     furi_assert(dict->stream);
 
-    return stream_rewind(dict->stream);
+    dict->found_index = 0;
+    dict->key_index = 0;
+    return dict->keys ? true : stream_rewind(dict->stream);
+}
+
+void mf_classic_dict_set_key_found(MfClassicDict* dict, uint64_t key) {
+    furi_assert(dict);
+
+    if(mf_classic_dict_is_key_found(dict, key)) return;
+    if(dict->found_count == MF_CLASSIC_DICT_FOUND_KEYS_MAX) return;
+    // Don't return the key twice if iteration is already past found keys
+    if(dict->found_index == dict->found_count) dict->found_index++;
+    dict->found_keys[dict->found_count++] = key;
 }
 
 bool mf_classic_dict_add_key(MfClassicDict* dict, uint8_t* key) {
@@ -141,6 +263,23 @@ bool mf_classic_dict_add_key(MfClassicDict* dict, uint8_t* key) {
         if(!stream_seek(dict->stream, 0, StreamOffsetFromEnd)) break;
         if(!stream_insert_string(dict->stream, key_str)) break;
         key_added = true;
+
+        if(dict->keys) {
+            uint64_t key_num = nfc_util_bytes2num(key, MF_CLASSIC_DICT_KEY_SIZE);
+            bool key_present = false;
+            for(size_t i = 0; i < dict->total_keys && !key_present; i++) {
+                key_present = nfc_util_bytes2num(
+                                  &dict->keys[i * MF_CLASSIC_DICT_KEY_SIZE],
+                                  MF_CLASSIC_DICT_KEY_SIZE) == key_num;
+            }
+            if(key_present) break;
+            dict->keys =
+                realloc(dict->keys, (dict->total_keys + 1) * MF_CLASSIC_DICT_KEY_SIZE);
+            memcpy(&dict->keys[dict->total_keys * MF_CLASSIC_DICT_KEY_SIZE],
+                   key,
+                   MF_CLASSIC_DICT_KEY_SIZE);
+        }
+        dict->total_keys++;
     } while(false);
 
     string_clear(key_str);
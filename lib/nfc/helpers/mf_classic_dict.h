@@ -6,6 +6,9 @@
 #include <lib/toolbox/stream/file_stream.h>
 #include <lib/toolbox/stream/buffered_file_stream.h>
 
+// Enough to hold both keys of every sector of MIFARE Classic 4K
+#define MF_CLASSIC_DICT_FOUND_KEYS_MAX (80)
+
 typedef enum {
     MfClassicDictTypeUser,
     MfClassicDictTypeFlipper,
@@ -25,4 +28,13 @@ bool mf_classic_dict_get_next_key(MfClassicDict* dict, uint64_t* key);
 
 bool mf_classic_dict_rewind(MfClassicDict* dict);
 
+/** Mark key as found on the card
+ * Found keys are returned first after every rewind and skipped in the rest of the dictionary,
+ * since cards tend to reuse the same key in multiple sectors.
+ *
+ * @param dict  MfClassicDict instance
+ * @param key   found key
+ */
+void mf_classic_dict_set_key_found(MfClassicDict* dict, uint64_t key);
+
 bool mf_classic_dict_add_key(MfClassicDict* dict, uint8_t* key);
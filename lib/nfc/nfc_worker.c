@@ -449,6 +449,7 @@ void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
                     is_key_a_found = mf_classic_is_key_found(data, i, MfClassicKeyA);
                     if(mf_classic_authenticate(&tx_rx, block_num, key, MfClassicKeyA)) {
                         mf_classic_set_key_found(data, i, MfClassicKeyA, key);
+                        mf_classic_dict_set_key_found(dict, key);
                         nfc_worker->callback(NfcWorkerEventFoundKeyA, nfc_worker->context);
                     }
                     furi_hal_nfc_sleep();
@@ -457,6 +458,7 @@ void nfc_worker_mf_classic_dict_attack(NfcWorker* nfc_worker) {
                     is_key_b_found = mf_classic_is_key_found(data, i, MfClassicKeyB);
                     if(mf_classic_authenticate(&tx_rx, block_num, key, MfClassicKeyB)) {
                         mf_classic_set_key_found(data, i, MfClassicKeyB, key);
+                        mf_classic_dict_set_key_found(dict, key);
                         nfc_worker->callback(NfcWorkerEventFoundKeyB, nfc_worker->context);
                     }
                 }
@@ -10,6 +10,77 @@
 
 #define BEBIT(x, n) FURI_BIT(x, (n) ^ 24)
 
+#ifndef CRYPTO1_BIT_SERIAL
+// crypto1_filter() terms looked up by input byte, OR-ed together they give the fc index
+static const uint8_t crypto1_filter_lut_lo[256] = {
+    0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10,
+    0x10, 0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10,
+    0x10, 0x10, 0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10,
+    0x10, 0x10, 0x10, 0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08,
+    0x18, 0x18, 0x18, 0x18, 0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08,
+    0x08, 0x18, 0x18, 0x18, 0x18, 0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10, 0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x00, 0x00,
+    0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10, 0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08,
+    0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00, 0x10, 0x10, 0x00, 0x10,
+    0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10, 0x00, 0x00, 0x10, 0x10, 0x00,
+    0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10, 0x08, 0x08, 0x18, 0x18,
+    0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18, 0x08, 0x08, 0x18,
+    0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00,
+    0x10, 0x10, 0x00, 0x10, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10, 0x08,
+    0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18,
+    0x08, 0x08, 0x18, 0x18, 0x08, 0x18, 0x08, 0x08, 0x08, 0x18, 0x08, 0x08, 0x18, 0x18, 0x18,
+    0x18};
+
+static const uint8_t crypto1_filter_lut_mid[256] = {
+    0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04,
+    0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04,
+    0x04, 0x04, 0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06,
+    0x06, 0x06, 0x06, 0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02,
+    0x06, 0x06, 0x06, 0x06, 0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00,
+    0x00, 0x04, 0x04, 0x04, 0x04, 0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x06, 0x06, 0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00, 0x00,
+    0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x04, 0x04, 0x00, 0x04, 0x00,
+    0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04, 0x02, 0x02, 0x06, 0x06, 0x02, 0x06,
+    0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06, 0x00, 0x00, 0x04, 0x04, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x04, 0x04,
+    0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x04, 0x04, 0x04, 0x02, 0x02, 0x06,
+    0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06, 0x02, 0x02,
+    0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06, 0x02,
+    0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06, 0x06,
+    0x02, 0x02, 0x06, 0x06, 0x02, 0x06, 0x02, 0x02, 0x02, 0x06, 0x02, 0x02, 0x06, 0x06, 0x06,
+    0x06};
+
+static const uint8_t crypto1_filter_lut_hi[16] = {
+    0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00, 0x01,
+    0x01};
+
+static inline uint8_t crypto1_filter_lut(uint32_t in) {
+    return FURI_BIT(
+        0xEC57E80A,
+        crypto1_filter_lut_lo[in & 0xff] | crypto1_filter_lut_mid[in >> 8 & 0xff] |
+            crypto1_filter_lut_hi[in >> 16 & 0xf]);
+}
+
+static inline uint32_t crypto1_parity32(uint32_t x) {
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    return 0x6996 >> (x & 0xf) & 1;
+}
+
+// Same as crypto1_bit(), with in and is_encrypted being 0 or 1. Halves are swapped by the caller.
+static inline uint8_t
+    crypto1_step(uint32_t* odd, uint32_t* even, uint32_t in, uint32_t is_encrypted) {
+    uint8_t out = crypto1_filter_lut(*odd);
+    uint32_t feed = (out & is_encrypted) ^ in;
+    feed ^= crypto1_parity32((LF_POLY_ODD & *odd) ^ (LF_POLY_EVEN & *even));
+    *even = *even << 1 | feed;
+    return out;
+}
+#endif
+
 void crypto1_reset(Crypto1* crypto1) {
     furi_assert(crypto1);
     crypto1->even = 0;
@@ -49,12 +120,52 @@ uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     return out;
 }
 
-uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+#ifndef CRYPTO1_BIT_SERIAL
+
+uint8_t crypto1_byte_parity(Crypto1* crypto1, uint8_t in, int is_encrypted, uint8_t* parity) {
+    furi_assert(crypto1);
+    furi_assert(parity);
+    // Even number of steps, so halves are swapped by alternating the arguments
+    uint32_t odd = crypto1->odd;
+    uint32_t even = crypto1->even;
+    uint32_t encrypted = !!is_encrypted;
+    uint8_t out = 0;
+    for(uint8_t i = 0; i < 8; i += 2) {
+        out |= crypto1_step(&odd, &even, FURI_BIT(in, i), encrypted) << i;
+        out |= crypto1_step(&even, &odd, FURI_BIT(in, i + 1), encrypted) << (i + 1);
+    }
+    crypto1->odd = odd;
+    crypto1->even = even;
+    *parity = crypto1_filter_lut(odd);
+    return out;
+}
+
+uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     furi_assert(crypto1);
+    uint32_t odd = crypto1->odd;
+    uint32_t even = crypto1->even;
+    uint32_t encrypted = !!is_encrypted;
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 32; i += 2) {
+        out |= (uint32_t)crypto1_step(&odd, &even, BEBIT(in, i), encrypted) << (24 ^ i);
+        out |= (uint32_t)crypto1_step(&even, &odd, BEBIT(in, i + 1), encrypted)
+               << (24 ^ (i + 1));
+    }
+    crypto1->odd = odd;
+    crypto1->even = even;
+    return out;
+}
+
+#else
+
+uint8_t crypto1_byte_parity(Crypto1* crypto1, uint8_t in, int is_encrypted, uint8_t* parity) {
+    furi_assert(crypto1);
+    furi_assert(parity);
     uint8_t out = 0;
     for(uint8_t i = 0; i < 8; i++) {
         out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
     }
+    *parity = crypto1_filter(crypto1->odd);
     return out;
 }
 
@@ -67,6 +178,13 @@ uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     return out;
 }
 
+#endif
+
+uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t parity;
+    return crypto1_byte_parity(crypto1, in, is_encrypted, &parity);
+}
+
 uint32_t prng_successor(uint32_t x, uint32_t n) {
     SWAPENDIAN(x);
     while(n--) x = x >> 1 | (x >> 16 ^ x >> 18 ^ x >> 19 ^ x >> 21) << 31;
@@ -3,6 +3,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/* Table driven filter with byte and word stepping is used by default,
+ * define CRYPTO1_BIT_SERIAL to build the reference implementation based on crypto1_bit() */
+
 typedef struct {
     uint32_t odd;
     uint32_t even;
@@ -16,6 +19,17 @@ uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted);
 
 uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted);
 
+/** Step 8 bits and get the keystream bit that follows them
+ *
+ * @param crypto1       Crypto1 instance
+ * @param in            input byte
+ * @param is_encrypted  feed keystream back
+ * @param parity        keystream bit to encrypt the parity of the byte
+ *
+ * @return keystream byte
+ */
+uint8_t crypto1_byte_parity(Crypto1* crypto1, uint8_t in, int is_encrypted, uint8_t* parity);
+
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted);
 
 uint32_t crypto1_filter(uint32_t in);
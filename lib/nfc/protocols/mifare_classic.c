@@ -400,18 +400,17 @@ static bool mf_classic_auth(
         crypto1_word(crypto, nt ^ cuid, 0);
         uint8_t nr[4] = {};
         nfc_util_num2bytes(prng_successor(DWT->CYCCNT, 32), 4, nr);
+        uint8_t parity = 0;
         for(uint8_t i = 0; i < 4; i++) {
-            tx_rx->tx_data[i] = crypto1_byte(crypto, nr[i], 0) ^ nr[i];
-            tx_rx->tx_parity[0] |=
-                (((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(nr[i])) & 0x01) << (7 - i));
+            tx_rx->tx_data[i] = crypto1_byte_parity(crypto, nr[i], 0, &parity) ^ nr[i];
+            tx_rx->tx_parity[0] |= ((parity ^ nfc_util_odd_parity8(nr[i])) & 0x01) << (7 - i);
         }
         nt = prng_successor(nt, 32);
         for(uint8_t i = 4; i < 8; i++) {
             nt = prng_successor(nt, 8);
-            tx_rx->tx_data[i] = crypto1_byte(crypto, 0x00, 0) ^ (nt & 0xff);
-            tx_rx->tx_parity[0] |=
-                (((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(nt & 0xff)) & 0x01)
-                 << (7 - i));
+            tx_rx->tx_data[i] = crypto1_byte_parity(crypto, 0x00, 0, &parity) ^ (nt & 0xff);
+            tx_rx->tx_parity[0] |= ((parity ^ nfc_util_odd_parity8(nt & 0xff)) & 0x01)
+                                   << (7 - i);
         }
         tx_rx->tx_rx_type = FuriHalNfcTxRxTypeRaw;
         tx_rx->tx_bits = 8 * 8;
@@ -497,10 +496,10 @@ bool mf_classic_read_block(
     memset(tx_rx->tx_data, 0, sizeof(tx_rx->tx_data));
     memset(tx_rx->tx_parity, 0, sizeof(tx_rx->tx_parity));
 
+    uint8_t parity = 0;
     for(uint8_t i = 0; i < 4; i++) {
-        tx_rx->tx_data[i] = crypto1_byte(crypto, 0x00, 0) ^ plain_cmd[i];
-        tx_rx->tx_parity[0] |=
-            ((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_cmd[i])) & 0x01) << (7 - i);
+        tx_rx->tx_data[i] = crypto1_byte_parity(crypto, 0x00, 0, &parity) ^ plain_cmd[i];
+        tx_rx->tx_parity[0] |= ((parity ^ nfc_util_odd_parity8(plain_cmd[i])) & 0x01) << (7 - i);
     }
     tx_rx->tx_bits = 4 * 9;
     tx_rx->tx_rx_type = FuriHalNfcTxRxTypeRaw;
@@ -750,12 +749,13 @@ void mf_crypto1_encrypt(
         }
     } else {
         memset(encrypted_parity, 0, plain_data_bits / 8 + 1);
+        uint8_t parity = 0;
         for(uint8_t i = 0; i < plain_data_bits / 8; i++) {
-            encrypted_data[i] = crypto1_byte(crypto, keystream ? keystream[i] : 0, 0) ^
-                                plain_data[i];
-            encrypted_parity[i / 8] |=
-                (((crypto1_filter(crypto->odd) ^ nfc_util_odd_parity8(plain_data[i])) & 0x01)
-                 << (7 - (i & 0x0007)));
+            encrypted_data[i] =
+                crypto1_byte_parity(crypto, keystream ? keystream[i] : 0, 0, &parity) ^
+                plain_data[i];
+            encrypted_parity[i / 8] |= (((parity ^ nfc_util_odd_parity8(plain_data[i])) & 0x01)
+                                        << (7 - (i & 0x0007)));
         }
     }
 }
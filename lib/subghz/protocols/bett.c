@@ -52,6 +52,17 @@ typedef enum {
     BETTDecoderStepCheckDuration,
 } BETTDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_bett_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 44, .delta_count = 15},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_bett_decoder_timing = {
+    .block_const = &subghz_protocol_bett_const,
+    .start = subghz_protocol_bett_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_bett_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderBETT, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_bett_decoder = {
     .alloc = subghz_protocol_decoder_bett_alloc,
     .free = subghz_protocol_decoder_bett_free,
@@ -63,6 +74,8 @@ const SubGhzProtocolDecoder subghz_protocol_bett_decoder = {
     .serialize = subghz_protocol_decoder_bett_serialize,
     .deserialize = subghz_protocol_decoder_bett_deserialize,
     .get_string = subghz_protocol_decoder_bett_get_string,
+
+    .timing = &subghz_protocol_bett_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_bett_encoder = {
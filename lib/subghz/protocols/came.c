@@ -42,6 +42,17 @@ typedef enum {
     CameDecoderStepCheckDuration,
 } CameDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_came_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 51, .delta_count = 51},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_came_decoder_timing = {
+    .block_const = &subghz_protocol_came_const,
+    .start = subghz_protocol_came_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_came_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderCame, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_came_decoder = {
     .alloc = subghz_protocol_decoder_came_alloc,
     .free = subghz_protocol_decoder_came_free,
@@ -53,6 +64,8 @@ const SubGhzProtocolDecoder subghz_protocol_came_decoder = {
     .serialize = subghz_protocol_decoder_came_serialize,
     .deserialize = subghz_protocol_decoder_came_deserialize,
     .get_string = subghz_protocol_decoder_came_get_string,
+
+    .timing = &subghz_protocol_came_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_encoder = {
@@ -25,6 +25,7 @@ struct SubGhzProtocolDecoderCameAtomo {
 
     ManchesterState manchester_saved_state;
     const char* came_atomo_rainbow_table_file_name;
+    SubGhzKeystoreRaw* came_atomo_rainbow_table;
 };
 
 struct SubGhzProtocolEncoderCameAtomo {
@@ -39,6 +40,17 @@ typedef enum {
     CameAtomoDecoderStepDecoderData,
 } CameAtomoDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_came_atomo_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeLong, .te_count = 60, .delta_count = 40},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_came_atomo_decoder_timing = {
+    .block_const = &subghz_protocol_came_atomo_const,
+    .start = subghz_protocol_came_atomo_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_came_atomo_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderCameAtomo, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_came_atomo_decoder = {
     .alloc = subghz_protocol_decoder_came_atomo_alloc,
     .free = subghz_protocol_decoder_came_atomo_free,
@@ -50,6 +62,8 @@ const SubGhzProtocolDecoder subghz_protocol_came_atomo_decoder = {
     .serialize = subghz_protocol_decoder_came_atomo_serialize,
     .deserialize = subghz_protocol_decoder_came_atomo_deserialize,
     .get_string = subghz_protocol_decoder_came_atomo_get_string,
+
+    .timing = &subghz_protocol_came_atomo_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_atomo_encoder = {
@@ -87,6 +101,9 @@ void subghz_protocol_decoder_came_atomo_free(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderCameAtomo* instance = context;
     instance->came_atomo_rainbow_table_file_name = NULL;
+    if(instance->came_atomo_rainbow_table) {
+        subghz_keystore_raw_close(instance->came_atomo_rainbow_table);
+    }
     free(instance);
 }
 
@@ -186,22 +203,36 @@ void subghz_protocol_decoder_came_atomo_feed(void* context, bool level, uint32_t
     }
 }
 
+/** 
+ * Rainbow table is opened on first use and kept open while the decoder exists
+ * @param instance Pointer to a SubGhzProtocolDecoderCameAtomo instance
+ * @return SubGhzKeystoreRaw* or NULL if there is no table
+ */
+static SubGhzKeystoreRaw*
+    subghz_protocol_came_atomo_get_rainbow_table(SubGhzProtocolDecoderCameAtomo* instance) {
+    const char* file_name = instance->came_atomo_rainbow_table_file_name;
+    if(!instance->came_atomo_rainbow_table && file_name && strcmp(file_name, "") != 0) {
+        instance->came_atomo_rainbow_table = subghz_keystore_raw_open(file_name);
+    }
+    return instance->came_atomo_rainbow_table;
+}
+
 /** 
  * Read bytes from rainbow table
- * @param file_name Full path to rainbow table the file 
+ * @param rainbow_table Open rainbow table file
  * @param number_atomo_magic_xor Сell number in the array
  * @return atomo_magic_xor
  */
 static uint64_t subghz_protocol_came_atomo_get_magic_xor_in_file(
-    const char* file_name,
+    SubGhzKeystoreRaw* rainbow_table,
     uint8_t number_atomo_magic_xor) {
-    if(!strcmp(file_name, "")) return SUBGHZ_NO_CAME_ATOMO_RAINBOW_TABLE;
+    if(!rainbow_table) return SUBGHZ_NO_CAME_ATOMO_RAINBOW_TABLE;
 
     uint8_t buffer[sizeof(uint64_t)] = {0};
     uint32_t address = number_atomo_magic_xor * sizeof(uint64_t);
     uint64_t atomo_magic_xor = 0;
 
-    if(subghz_keystore_raw_get_data(file_name, address, buffer, sizeof(uint64_t))) {
+    if(subghz_keystore_raw_read(rainbow_table, address, buffer, sizeof(uint64_t))) {
         for(size_t i = 0; i < sizeof(uint64_t); i++) {
             atomo_magic_xor = (atomo_magic_xor << 8) | buffer[i];
         }
@@ -214,11 +245,11 @@ static uint64_t subghz_protocol_came_atomo_get_magic_xor_in_file(
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
- * @param file_name Full path to rainbow table the file
+ * @param rainbow_table Open rainbow table file
  */
 static void subghz_protocol_came_atomo_remote_controller(
     SubGhzBlockGeneric* instance,
-    const char* file_name) {
+    SubGhzKeystoreRaw* rainbow_table) {
     /* 
     * 0x1fafef3ed0f7d9ef
     * 0x185fcc1531ee86e7
@@ -277,7 +308,8 @@ static void subghz_protocol_came_atomo_remote_controller(
     parcel_counter >>= 4;
     uint8_t ind = (parcel_counter + 1) % 32;
     uint64_t temp_data = instance->data & 0x0000FFFFFFFFFFFF;
-    uint64_t atomo_magic_xor = subghz_protocol_came_atomo_get_magic_xor_in_file(file_name, ind);
+    uint64_t atomo_magic_xor =
+        subghz_protocol_came_atomo_get_magic_xor_in_file(rainbow_table, ind);
 
     if(atomo_magic_xor != SUBGHZ_NO_CAME_ATOMO_RAINBOW_TABLE) {
         temp_data = temp_data ^ atomo_magic_xor;
@@ -329,7 +361,7 @@ void subghz_protocol_decoder_came_atomo_get_string(void* context, string_t outpu
     furi_assert(context);
     SubGhzProtocolDecoderCameAtomo* instance = context;
     subghz_protocol_came_atomo_remote_controller(
-        &instance->generic, instance->came_atomo_rainbow_table_file_name);
+        &instance->generic, subghz_protocol_came_atomo_get_rainbow_table(instance));
     uint32_t code_found_hi = instance->generic.data >> 32;
     uint32_t code_found_lo = instance->generic.data & 0x00000000ffffffff;
 
@@ -70,6 +70,17 @@ typedef enum {
     CameTweeDecoderStepDecoderData,
 } CameTweeDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_came_twee_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeLong, .te_count = 51, .delta_count = 20},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_came_twee_decoder_timing = {
+    .block_const = &subghz_protocol_came_twee_const,
+    .start = subghz_protocol_came_twee_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_came_twee_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderCameTwee, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_came_twee_decoder = {
     .alloc = subghz_protocol_decoder_came_twee_alloc,
     .free = subghz_protocol_decoder_came_twee_free,
@@ -81,6 +92,8 @@ const SubGhzProtocolDecoder subghz_protocol_came_twee_decoder = {
     .serialize = subghz_protocol_decoder_came_twee_serialize,
     .deserialize = subghz_protocol_decoder_came_twee_deserialize,
     .get_string = subghz_protocol_decoder_came_twee_get_string,
+
+    .timing = &subghz_protocol_came_twee_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_twee_encoder = {
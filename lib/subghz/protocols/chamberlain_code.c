@@ -66,6 +66,17 @@ typedef enum {
     Chamb_CodeDecoderStepCheckDuration,
 } Chamb_CodeDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_chamb_code_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 39, .delta_count = 20},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_chamb_code_decoder_timing = {
+    .block_const = &subghz_protocol_chamb_code_const,
+    .start = subghz_protocol_chamb_code_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_chamb_code_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderChamb_Code, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_chamb_code_decoder = {
     .alloc = subghz_protocol_decoder_chamb_code_alloc,
     .free = subghz_protocol_decoder_chamb_code_free,
@@ -77,6 +88,8 @@ const SubGhzProtocolDecoder subghz_protocol_chamb_code_decoder = {
     .serialize = subghz_protocol_decoder_chamb_code_serialize,
     .deserialize = subghz_protocol_decoder_chamb_code_deserialize,
     .get_string = subghz_protocol_decoder_chamb_code_get_string,
+
+    .timing = &subghz_protocol_chamb_code_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_chamb_code_encoder = {
@@ -43,6 +43,17 @@ typedef enum {
     DoitrandDecoderStepCheckDuration,
 } DoitrandDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_doitrand_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 62, .delta_count = 30},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_doitrand_decoder_timing = {
+    .block_const = &subghz_protocol_doitrand_const,
+    .start = subghz_protocol_doitrand_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_doitrand_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderDoitrand, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_doitrand_decoder = {
     .alloc = subghz_protocol_decoder_doitrand_alloc,
     .free = subghz_protocol_decoder_doitrand_free,
@@ -54,6 +65,8 @@ const SubGhzProtocolDecoder subghz_protocol_doitrand_decoder = {
     .serialize = subghz_protocol_decoder_doitrand_serialize,
     .deserialize = subghz_protocol_decoder_doitrand_deserialize,
     .get_string = subghz_protocol_decoder_doitrand_get_string,
+
+    .timing = &subghz_protocol_doitrand_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_doitrand_encoder = {
@@ -36,6 +36,17 @@ typedef enum {
     FaacSLHDecoderStepCheckDuration,
 } FaacSLHDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_faac_slh_start_pulses[] = {
+    {.level = true, .te = SubGhzProtocolDecoderTeLong, .te_count = 2, .delta_count = 3},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_faac_slh_decoder_timing = {
+    .block_const = &subghz_protocol_faac_slh_const,
+    .start = subghz_protocol_faac_slh_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_faac_slh_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderFaacSLH, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_faac_slh_decoder = {
     .alloc = subghz_protocol_decoder_faac_slh_alloc,
     .free = subghz_protocol_decoder_faac_slh_free,
@@ -47,6 +58,8 @@ const SubGhzProtocolDecoder subghz_protocol_faac_slh_decoder = {
     .serialize = subghz_protocol_decoder_faac_slh_serialize,
     .deserialize = subghz_protocol_decoder_faac_slh_deserialize,
     .get_string = subghz_protocol_decoder_faac_slh_get_string,
+
+    .timing = &subghz_protocol_faac_slh_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_faac_slh_encoder = {
@@ -36,6 +36,17 @@ typedef enum {
     GateTXDecoderStepCheckDuration,
 } GateTXDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_gate_tx_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 47, .delta_count = 47},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_gate_tx_decoder_timing = {
+    .block_const = &subghz_protocol_gate_tx_const,
+    .start = subghz_protocol_gate_tx_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_gate_tx_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderGateTx, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_gate_tx_decoder = {
     .alloc = subghz_protocol_decoder_gate_tx_alloc,
     .free = subghz_protocol_decoder_gate_tx_free,
@@ -47,6 +58,8 @@ const SubGhzProtocolDecoder subghz_protocol_gate_tx_decoder = {
     .serialize = subghz_protocol_decoder_gate_tx_serialize,
     .deserialize = subghz_protocol_decoder_gate_tx_deserialize,
     .get_string = subghz_protocol_decoder_gate_tx_get_string,
+
+    .timing = &subghz_protocol_gate_tx_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_gate_tx_encoder = {
@@ -46,6 +46,17 @@ typedef enum {
     HoltekDecoderStepCheckDuration,
 } HoltekDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_holtek_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 36, .delta_count = 36},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_holtek_decoder_timing = {
+    .block_const = &subghz_protocol_holtek_const,
+    .start = subghz_protocol_holtek_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_holtek_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderHoltek, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_holtek_decoder = {
     .alloc = subghz_protocol_decoder_holtek_alloc,
     .free = subghz_protocol_decoder_holtek_free,
@@ -57,6 +68,8 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_decoder = {
     .serialize = subghz_protocol_decoder_holtek_serialize,
     .deserialize = subghz_protocol_decoder_holtek_deserialize,
     .get_string = subghz_protocol_decoder_holtek_get_string,
+
+    .timing = &subghz_protocol_holtek_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_holtek_encoder = {
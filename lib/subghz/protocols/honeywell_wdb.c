@@ -47,6 +47,17 @@ typedef enum {
     Honeywell_WDBDecoderStepCheckDuration,
 } Honeywell_WDBDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_honeywell_wdb_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 3, .delta_count = 1},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_honeywell_wdb_decoder_timing = {
+    .block_const = &subghz_protocol_honeywell_wdb_const,
+    .start = subghz_protocol_honeywell_wdb_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_honeywell_wdb_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderHoneywell_WDB, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_honeywell_wdb_decoder = {
     .alloc = subghz_protocol_decoder_honeywell_wdb_alloc,
     .free = subghz_protocol_decoder_honeywell_wdb_free,
@@ -58,6 +69,8 @@ const SubGhzProtocolDecoder subghz_protocol_honeywell_wdb_decoder = {
     .serialize = subghz_protocol_decoder_honeywell_wdb_serialize,
     .deserialize = subghz_protocol_decoder_honeywell_wdb_deserialize,
     .get_string = subghz_protocol_decoder_honeywell_wdb_get_string,
+
+    .timing = &subghz_protocol_honeywell_wdb_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_honeywell_wdb_encoder = {
@@ -38,6 +38,17 @@ typedef enum {
     HormannDecoderStepCheckDuration,
 } HormannDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_hormann_start_pulses[] = {
+    {.level = true, .te = SubGhzProtocolDecoderTeShort, .te_count = 64, .delta_count = 64},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_hormann_decoder_timing = {
+    .block_const = &subghz_protocol_hormann_const,
+    .start = subghz_protocol_hormann_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_hormann_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderHormann, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_hormann_decoder = {
     .alloc = subghz_protocol_decoder_hormann_alloc,
     .free = subghz_protocol_decoder_hormann_free,
@@ -49,6 +60,8 @@ const SubGhzProtocolDecoder subghz_protocol_hormann_decoder = {
     .serialize = subghz_protocol_decoder_hormann_serialize,
     .deserialize = subghz_protocol_decoder_hormann_deserialize,
     .get_string = subghz_protocol_decoder_hormann_get_string,
+
+    .timing = &subghz_protocol_hormann_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_hormann_encoder = {
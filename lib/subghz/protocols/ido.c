@@ -36,6 +36,17 @@ typedef enum {
     IDoDecoderStepCheckDuration,
 } IDoDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_ido_start_pulses[] = {
+    {.level = true, .te = SubGhzProtocolDecoderTeShort, .te_count = 10, .delta_count = 5},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_ido_decoder_timing = {
+    .block_const = &subghz_protocol_ido_const,
+    .start = subghz_protocol_ido_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_ido_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderIDo, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_ido_decoder = {
     .alloc = subghz_protocol_decoder_ido_alloc,
     .free = subghz_protocol_decoder_ido_free,
@@ -47,6 +58,8 @@ const SubGhzProtocolDecoder subghz_protocol_ido_decoder = {
     .deserialize = subghz_protocol_decoder_ido_deserialize,
     .serialize = subghz_protocol_decoder_ido_serialize,
     .get_string = subghz_protocol_decoder_ido_get_string,
+
+    .timing = &subghz_protocol_ido_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_ido_encoder = {
@@ -1,5 +1,6 @@
 #include "keeloq.h"
 #include "keeloq_common.h"
+#include "keeloq_batch.h"
 
 #include "../subghz_keystore.h"
 #include <m-string.h>
@@ -48,6 +49,17 @@ typedef enum {
     KeeloqDecoderStepCheckDuration,
 } KeeloqDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_keeloq_start_pulses[] = {
+    {.level = true, .te = SubGhzProtocolDecoderTeShort, .te_count = 1, .delta_count = 1},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_keeloq_decoder_timing = {
+    .block_const = &subghz_protocol_keeloq_const,
+    .start = subghz_protocol_keeloq_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_keeloq_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderKeeloq, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_keeloq_decoder = {
     .alloc = subghz_protocol_decoder_keeloq_alloc,
     .free = subghz_protocol_decoder_keeloq_free,
@@ -59,6 +71,8 @@ const SubGhzProtocolDecoder subghz_protocol_keeloq_decoder = {
     .serialize = subghz_protocol_decoder_keeloq_serialize,
     .deserialize = subghz_protocol_decoder_keeloq_deserialize,
     .get_string = subghz_protocol_decoder_keeloq_get_string,
+
+    .timing = &subghz_protocol_keeloq_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_keeloq_encoder = {
@@ -131,7 +145,7 @@ static bool subghz_protocol_keeloq_gen_data(SubGhzProtocolEncoderKeeloq* instanc
 
     for
         M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            res = strcmp(string_get_cstr(manufacture_code->name), instance->manufacture_name);
+            res = strcmp(manufacture_code->name, instance->manufacture_name);
             if(res == 0) {
                 switch(manufacture_code->type) {
                 case KEELOQ_LEARNING_SIMPLE:
@@ -457,13 +471,51 @@ static inline bool subghz_protocol_keeloq_check_decrypt(
     return false;
 }
 
-/** 
- * Checking the accepted code against the database manafacture key
+typedef enum {
+    KeeloqBatchVariantSimple = 0,
+    KeeloqBatchVariantSimpleMirrored,
+    KeeloqBatchVariantNormal,
+    KeeloqBatchVariantNormalMirrored,
+    KeeloqBatchVariantSecure,
+    KeeloqBatchVariantSecureMirrored,
+    KeeloqBatchVariantMagicXor,
+    KeeloqBatchVariantMagicXorMirrored,
+    KeeloqBatchVariantCount,
+} KeeloqBatchVariant;
+
+/**
+ * Validation of decrypt data for all lanes, bitsliced subghz_protocol_keeloq_check_decrypt.
+ * @param state Bitsliced decrypt data
+ * @param btn Button number, 4 bit
+ * @param end_serial decrement the last 10 bits of the serial number
+ * @return Lanes that passed validation
+ */
+static uint32_t subghz_protocol_keeloq_batch_check_decrypt(
+    const uint32_t* state,
+    uint8_t btn,
+    uint32_t end_serial) {
+    uint32_t btn_match = 0xFFFFFFFF;
+    for(uint8_t i = 0; i < 4; i++) {
+        btn_match &= ~(state[28 + i] ^ ((uint32_t)0 - ((btn >> i) & 1)));
+    }
+    uint32_t serial_match = 0xFFFFFFFF;
+    uint32_t serial_zero = 0xFFFFFFFF;
+    for(uint8_t i = 0; i < 8; i++) {
+        serial_match &= ~(state[16 + i] ^ ((uint32_t)0 - ((end_serial >> i) & 1)));
+        serial_zero &= ~state[16 + i];
+    }
+    return btn_match & (serial_match | serial_zero);
+}
+
+/**
+ * Checking the accepted code against the database manafacture key.
+ * Keys are checked KEELOQ_BATCH_LANES at a time, first matching key in keystore
+ * order wins, KEELOQ_LEARNING_UNKNOWN keys try learnings in KeeloqBatchVariant order.
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param fix Fix part of the parcel
  * @param hop Hop encrypted part of the parcel
  * @param keystore Pointer to a SubGhzKeystore* instance
- * @param manufacture_name 
+ * @param manufacture_name
  * @return true on successful search
  */
 static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
@@ -478,120 +530,86 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
 
     uint16_t end_serial = (uint16_t)(fix & 0xFF);
     uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man;
     uint32_t seed = 0;
 
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            switch(manufacture_code->type) {
-            case KEELOQ_LEARNING_SIMPLE:
-                // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_NORMAL:
-                // Normal Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_SECURE:
-                man = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_UNKNOWN:
-                // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                // Check for mirrored man
-                uint64_t man_rev = 0;
-                uint64_t man_rev_byte = 0;
-                for(uint8_t i = 0; i < 64; i += 8) {
-                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                    man_rev = man_rev | man_rev_byte << (56 - i);
-                }
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-                //###########################
-                // Normal Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+    uint32_t mirrored[KEELOQ_BATCH_SCHEDULE_SIZE];
+    uint32_t man[KEELOQ_BATCH_SCHEDULE_SIZE];
+    uint32_t state[KEELOQ_BATCH_STATE_SIZE];
 
+    for
+        M_EACH(batch, *subghz_keystore_get_batch_data(keystore), SubGhzKeyBatchArray_t) {
+            uint32_t unknown = batch->type[KEELOQ_LEARNING_UNKNOWN];
+            uint32_t lanes[KeeloqBatchVariantCount] = {
+                [KeeloqBatchVariantSimple] = batch->type[KEELOQ_LEARNING_SIMPLE] | unknown,
+                [KeeloqBatchVariantSimpleMirrored] = unknown,
+                [KeeloqBatchVariantNormal] = batch->type[KEELOQ_LEARNING_NORMAL] | unknown,
+                [KeeloqBatchVariantNormalMirrored] = unknown,
+                [KeeloqBatchVariantSecure] = batch->type[KEELOQ_LEARNING_SECURE] | unknown,
+                [KeeloqBatchVariantSecureMirrored] = unknown,
+                [KeeloqBatchVariantMagicXor] = batch->type[KEELOQ_LEARNING_MAGIC_XOR_TYPE_1] |
+                                               unknown,
+                [KeeloqBatchVariantMagicXorMirrored] = unknown,
+            };
+            if(unknown) {
                 // Check for mirrored man
-                man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
-
-                // Secure Learning
-                man = subghz_protocol_keeloq_common_secure_learning(
-                    fix, seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
-                }
+                subghz_protocol_keeloq_batch_mirror(mirrored, batch->key);
+            }
 
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_secure_learning(fix, seed, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
+            uint32_t found[KeeloqBatchVariantCount] = {0};
+            uint32_t decrypt[KeeloqBatchVariantCount] = {0};
+            uint32_t found_any = 0;
+            for(uint8_t variant = 0; variant < KeeloqBatchVariantCount; variant++) {
+                // Only keys before the first match can still take precedence
+                if(found_any) lanes[variant] &= (found_any & -found_any) - 1;
+                if(!lanes[variant]) continue;
+
+                const uint32_t* key = (variant & 1) ? mirrored : batch->key;
+                switch(variant & ~1) {
+                case KeeloqBatchVariantSimple:
+                    // Simple Learning
+                    subghz_protocol_keeloq_batch_decrypt(state, hop, key);
+                    break;
+                case KeeloqBatchVariantNormal:
+                    // Normal Learning
+                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+                    subghz_protocol_keeloq_batch_normal_learning(man, fix, key);
+                    subghz_protocol_keeloq_batch_decrypt(state, hop, man);
+                    break;
+                case KeeloqBatchVariantSecure:
+                    // Secure Learning
+                    subghz_protocol_keeloq_batch_secure_learning(man, fix, seed, key);
+                    subghz_protocol_keeloq_batch_decrypt(state, hop, man);
+                    break;
+                case KeeloqBatchVariantMagicXor:
+                    // Magic xor type1 learning
+                    subghz_protocol_keeloq_batch_magic_xor_type1_learning(man, fix, key);
+                    subghz_protocol_keeloq_batch_decrypt(state, hop, man);
+                    break;
                 }
 
-                // Magic xor type1 learning
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                    fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
+                found[variant] =
+                    subghz_protocol_keeloq_batch_check_decrypt(state, btn, end_serial) &
+                    lanes[variant];
+                if(found[variant]) {
+                    decrypt[variant] = subghz_protocol_keeloq_batch_get_lane(
+                        state, __builtin_ctz(found[variant]));
+                    found_any |= found[variant];
                 }
+            }
 
-                // Check for mirrored man
-                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                    *manufacture_name = string_get_cstr(manufacture_code->name);
-                    return 1;
+            if(found_any) {
+                uint8_t lane = __builtin_ctz(found_any);
+                for(uint8_t variant = 0; variant < KeeloqBatchVariantCount; variant++) {
+                    if(found[variant] & (1UL << lane)) {
+                        subghz_protocol_keeloq_check_decrypt(
+                            instance, decrypt[variant], btn, end_serial);
+                        break;
+                    }
                 }
-                break;
+                const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(
+                    *subghz_keystore_get_data(keystore), batch->first + lane);
+                *manufacture_name = manufacture_code->name;
+                return 1;
             }
         }
 
@@ -0,0 +1,141 @@
+#include "keeloq_batch.h"
+
+#include <furi.h>
+
+#define KEELOQ_BATCH_STATE_MASK (KEELOQ_BATCH_STATE_SIZE - 1)
+#define KEELOQ_BATCH_SCHEDULE_MASK (KEELOQ_BATCH_SCHEDULE_SIZE - 1)
+#define KEELOQ_BATCH_ROUNDS 528
+
+/** Broadcast single bit to all lanes
+ * @param value - source value
+ * @param n - bit number
+ * @return 0xFFFFFFFF if bit is set, 0 otherwise
+ */
+static inline uint32_t subghz_protocol_keeloq_batch_broadcast(uint64_t value, uint8_t n) {
+    return (uint32_t)0 - (uint32_t)((value >> n) & 1);
+}
+
+/** Boolean form of KEELOQ_NLF (0x3A5C742E) lookup
+ * @param a - lane bits for index bit 0
+ * @param b - lane bits for index bit 1
+ * @param c - lane bits for index bit 2
+ * @param d - lane bits for index bit 3
+ * @param e - lane bits for index bit 4
+ * @return NLF output for every lane
+ */
+static inline uint32_t subghz_protocol_keeloq_batch_nlf(
+    uint32_t a,
+    uint32_t b,
+    uint32_t c,
+    uint32_t d,
+    uint32_t e) {
+    // a ^ b ^ ab ^ bc ^ ad ^ cd ^ e(a ^ ab ^ c ^ ac ^ bd ^ cd)
+    uint32_t ab = a & b;
+    uint32_t cd = c & d;
+    return a ^ b ^ ab ^ (b & c) ^ (a & d) ^ cd ^
+           (e & (a ^ ab ^ c ^ (a & c) ^ (b & d) ^ cd));
+}
+
+void subghz_protocol_keeloq_batch_load_keys(
+    uint32_t* schedule,
+    const uint64_t* keys,
+    size_t count) {
+    furi_assert(schedule);
+    furi_assert(count <= KEELOQ_BATCH_LANES);
+
+    for(uint8_t i = 0; i < KEELOQ_BATCH_SCHEDULE_SIZE; i++) {
+        uint32_t word = 0;
+        for(size_t lane = 0; lane < count; lane++) {
+            word |= (uint32_t)((keys[lane] >> i) & 1) << lane;
+        }
+        schedule[i] = word;
+    }
+}
+
+uint32_t subghz_protocol_keeloq_batch_get_lane(const uint32_t* state, uint8_t lane) {
+    furi_assert(state);
+    furi_assert(lane < KEELOQ_BATCH_LANES);
+
+    uint32_t value = 0;
+    for(uint8_t i = 0; i < KEELOQ_BATCH_STATE_SIZE; i++) {
+        value |= ((state[i] >> lane) & 1) << i;
+    }
+    return value;
+}
+
+void subghz_protocol_keeloq_batch_decrypt(
+    uint32_t* state,
+    const uint32_t data,
+    const uint32_t* schedule) {
+    furi_assert(state);
+    furi_assert(schedule);
+
+    // Shift register is kept in place, `head` points to the slot holding bit 0,
+    // so every round costs one store instead of shifting all 32 words.
+    uint32_t x[KEELOQ_BATCH_STATE_SIZE];
+    for(uint8_t i = 0; i < KEELOQ_BATCH_STATE_SIZE; i++) {
+        x[i] = subghz_protocol_keeloq_batch_broadcast(data, i);
+    }
+
+    uint8_t head = 0;
+    for(uint32_t r = 0; r < KEELOQ_BATCH_ROUNDS; r++) {
+        uint32_t feedback = x[(head + 31) & KEELOQ_BATCH_STATE_MASK] ^
+                            x[(head + 15) & KEELOQ_BATCH_STATE_MASK] ^
+                            schedule[(15 - r) & KEELOQ_BATCH_SCHEDULE_MASK] ^
+                            subghz_protocol_keeloq_batch_nlf(
+                                x[head],
+                                x[(head + 8) & KEELOQ_BATCH_STATE_MASK],
+                                x[(head + 19) & KEELOQ_BATCH_STATE_MASK],
+                                x[(head + 25) & KEELOQ_BATCH_STATE_MASK],
+                                x[(head + 30) & KEELOQ_BATCH_STATE_MASK]);
+        // x << 1: old bit 31 slot becomes new bit 0
+        head = (head - 1) & KEELOQ_BATCH_STATE_MASK;
+        x[head] = feedback;
+    }
+
+    for(uint8_t i = 0; i < KEELOQ_BATCH_STATE_SIZE; i++) {
+        state[i] = x[(head + i) & KEELOQ_BATCH_STATE_MASK];
+    }
+}
+
+void subghz_protocol_keeloq_batch_mirror(uint32_t* schedule, const uint32_t* key_schedule) {
+    furi_assert(schedule);
+    furi_assert(key_schedule);
+
+    for(uint8_t i = 0; i < KEELOQ_BATCH_SCHEDULE_SIZE; i += 8) {
+        for(uint8_t j = 0; j < 8; j++) {
+            schedule[56 - i + j] = key_schedule[i + j];
+        }
+    }
+}
+
+void subghz_protocol_keeloq_batch_normal_learning(
+    uint32_t* schedule,
+    uint32_t data,
+    const uint32_t* key_schedule) {
+    data &= 0x0FFFFFFF;
+    subghz_protocol_keeloq_batch_decrypt(&schedule[0], data | 0x20000000, key_schedule);
+    subghz_protocol_keeloq_batch_decrypt(
+        &schedule[KEELOQ_BATCH_STATE_SIZE], data | 0x60000000, key_schedule);
+}
+
+void subghz_protocol_keeloq_batch_secure_learning(
+    uint32_t* schedule,
+    uint32_t data,
+    uint32_t seed,
+    const uint32_t* key_schedule) {
+    data &= 0x0FFFFFFF;
+    subghz_protocol_keeloq_batch_decrypt(&schedule[KEELOQ_BATCH_STATE_SIZE], data, key_schedule);
+    subghz_protocol_keeloq_batch_decrypt(&schedule[0], seed, key_schedule);
+}
+
+void subghz_protocol_keeloq_batch_magic_xor_type1_learning(
+    uint32_t* schedule,
+    uint32_t data,
+    const uint32_t* xor_schedule) {
+    data &= 0x0FFFFFFF;
+    uint64_t man = ((uint64_t)data << 32) | data;
+    for(uint8_t i = 0; i < KEELOQ_BATCH_SCHEDULE_SIZE; i++) {
+        schedule[i] = xor_schedule[i] ^ subghz_protocol_keeloq_batch_broadcast(man, i);
+    }
+}
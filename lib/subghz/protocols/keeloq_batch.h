@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Bitsliced KeeLoq
+ * Processes 32 manufacture keys per pass, one key per bit (lane) of a 32-bit word.
+ * Key schedule: schedule[i] holds bit i of every key, bit N of the word is lane N.
+ * State: state[i] holds bit i of every lane result, same layout as the schedule.
+ */
+#define KEELOQ_BATCH_LANES 32
+#define KEELOQ_BATCH_SCHEDULE_SIZE 64
+#define KEELOQ_BATCH_STATE_SIZE 32
+
+/**
+ * Transpose up to 32 keys into bitsliced key schedule
+ * @param schedule - resulting key schedule, KEELOQ_BATCH_SCHEDULE_SIZE words
+ * @param keys - manufacture keys (64bit)
+ * @param count - number of keys, unused lanes are filled with zero key
+ */
+void subghz_protocol_keeloq_batch_load_keys(
+    uint32_t* schedule,
+    const uint64_t* keys,
+    size_t count);
+
+/**
+ * Extract one lane from bitsliced state
+ * @param state - bitsliced state, KEELOQ_BATCH_STATE_SIZE words
+ * @param lane - lane number, 0..31
+ * @return 32bit value of the lane
+ */
+uint32_t subghz_protocol_keeloq_batch_get_lane(const uint32_t* state, uint8_t lane);
+
+/**
+ * Simple Learning Decrypt, same data for all lanes
+ * @param state - resulting bitsliced state, KEELOQ_BATCH_STATE_SIZE words
+ * @param data - keeloq encrypt data
+ * @param schedule - key schedule
+ */
+void subghz_protocol_keeloq_batch_decrypt(
+    uint32_t* state,
+    const uint32_t data,
+    const uint32_t* schedule);
+
+/**
+ * Byte mirrored keys
+ * @param schedule - resulting key schedule
+ * @param key_schedule - manufacture key schedule
+ */
+void subghz_protocol_keeloq_batch_mirror(uint32_t* schedule, const uint32_t* key_schedule);
+
+/**
+ * Normal Learning
+ * @param schedule - resulting key schedule, manufacture for this serial number per lane
+ * @param data - serial number (28bit)
+ * @param key_schedule - manufacture key schedule
+ */
+void subghz_protocol_keeloq_batch_normal_learning(
+    uint32_t* schedule,
+    uint32_t data,
+    const uint32_t* key_schedule);
+
+/**
+ * Secure Learning
+ * @param schedule - resulting key schedule, manufacture for this serial number per lane
+ * @param data - serial number (28bit)
+ * @param seed - seed number (32bit)
+ * @param key_schedule - manufacture key schedule
+ */
+void subghz_protocol_keeloq_batch_secure_learning(
+    uint32_t* schedule,
+    uint32_t data,
+    uint32_t seed,
+    const uint32_t* key_schedule);
+
+/**
+ * Magic_xor_type1 Learning
+ * @param schedule - resulting key schedule, manufacture for this serial number per lane
+ * @param data - serial number (28bit)
+ * @param xor_schedule - magic xor schedule
+ */
+void subghz_protocol_keeloq_batch_magic_xor_type1_learning(
+    uint32_t* schedule,
+    uint32_t data,
+    const uint32_t* xor_schedule);
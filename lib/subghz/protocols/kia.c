@@ -38,6 +38,17 @@ typedef enum {
     KIADecoderStepCheckDuration,
 } KIADecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_kia_start_pulses[] = {
+    {.level = true, .te = SubGhzProtocolDecoderTeShort, .te_count = 1, .delta_count = 1},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_kia_decoder_timing = {
+    .block_const = &subghz_protocol_kia_const,
+    .start = subghz_protocol_kia_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_kia_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderKIA, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_kia_decoder = {
     .alloc = subghz_protocol_decoder_kia_alloc,
     .free = subghz_protocol_decoder_kia_free,
@@ -49,6 +60,8 @@ const SubGhzProtocolDecoder subghz_protocol_kia_decoder = {
     .serialize = subghz_protocol_decoder_kia_serialize,
     .deserialize = subghz_protocol_decoder_kia_deserialize,
     .get_string = subghz_protocol_decoder_kia_get_string,
+
+    .timing = &subghz_protocol_kia_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_kia_encoder = {
@@ -42,6 +42,17 @@ typedef enum {
     LinearDecoderStepCheckDuration,
 } LinearDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_linear_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 42, .delta_count = 20},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_linear_decoder_timing = {
+    .block_const = &subghz_protocol_linear_const,
+    .start = subghz_protocol_linear_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_linear_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderLinear, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_linear_decoder = {
     .alloc = subghz_protocol_decoder_linear_alloc,
     .free = subghz_protocol_decoder_linear_free,
@@ -53,6 +64,8 @@ const SubGhzProtocolDecoder subghz_protocol_linear_decoder = {
     .serialize = subghz_protocol_decoder_linear_serialize,
     .deserialize = subghz_protocol_decoder_linear_deserialize,
     .get_string = subghz_protocol_decoder_linear_get_string,
+
+    .timing = &subghz_protocol_linear_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_linear_encoder = {
@@ -38,6 +38,17 @@ typedef enum {
     MarantecDecoderStepDecoderData,
 } MarantecDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_marantec_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeLong, .te_count = 5, .delta_count = 8},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_marantec_decoder_timing = {
+    .block_const = &subghz_protocol_marantec_const,
+    .start = subghz_protocol_marantec_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_marantec_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderMarantec, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_marantec_decoder = {
     .alloc = subghz_protocol_decoder_marantec_alloc,
     .free = subghz_protocol_decoder_marantec_free,
@@ -49,6 +60,8 @@ const SubGhzProtocolDecoder subghz_protocol_marantec_decoder = {
     .serialize = subghz_protocol_decoder_marantec_serialize,
     .deserialize = subghz_protocol_decoder_marantec_deserialize,
     .get_string = subghz_protocol_decoder_marantec_get_string,
+
+    .timing = &subghz_protocol_marantec_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_marantec_encoder = {
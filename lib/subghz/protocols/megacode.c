@@ -48,6 +48,17 @@ typedef enum {
     MegaCodeDecoderStepCheckDuration,
 } MegaCodeDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_megacode_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 13, .delta_count = 17},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_megacode_decoder_timing = {
+    .block_const = &subghz_protocol_megacode_const,
+    .start = subghz_protocol_megacode_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_megacode_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderMegaCode, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_megacode_decoder = {
     .alloc = subghz_protocol_decoder_megacode_alloc,
     .free = subghz_protocol_decoder_megacode_free,
@@ -59,6 +70,8 @@ const SubGhzProtocolDecoder subghz_protocol_megacode_decoder = {
     .serialize = subghz_protocol_decoder_megacode_serialize,
     .deserialize = subghz_protocol_decoder_megacode_deserialize,
     .get_string = subghz_protocol_decoder_megacode_get_string,
+
+    .timing = &subghz_protocol_megacode_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_megacode_encoder = {
@@ -38,6 +38,17 @@ typedef enum {
     NeroRadioDecoderStepCheckDuration,
 } NeroRadioDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_nero_radio_start_pulses[] = {
+    {.level = true, .te = SubGhzProtocolDecoderTeShort, .te_count = 1, .delta_count = 1},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_nero_radio_decoder_timing = {
+    .block_const = &subghz_protocol_nero_radio_const,
+    .start = subghz_protocol_nero_radio_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_nero_radio_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderNeroRadio, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_nero_radio_decoder = {
     .alloc = subghz_protocol_decoder_nero_radio_alloc,
     .free = subghz_protocol_decoder_nero_radio_free,
@@ -49,6 +60,8 @@ const SubGhzProtocolDecoder subghz_protocol_nero_radio_decoder = {
     .serialize = subghz_protocol_decoder_nero_radio_serialize,
     .deserialize = subghz_protocol_decoder_nero_radio_deserialize,
     .get_string = subghz_protocol_decoder_nero_radio_get_string,
+
+    .timing = &subghz_protocol_nero_radio_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nero_radio_encoder = {
@@ -37,6 +37,17 @@ typedef enum {
     NeroSketchDecoderStepCheckDuration,
 } NeroSketchDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_nero_sketch_start_pulses[] = {
+    {.level = true, .te = SubGhzProtocolDecoderTeShort, .te_count = 1, .delta_count = 1},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_nero_sketch_decoder_timing = {
+    .block_const = &subghz_protocol_nero_sketch_const,
+    .start = subghz_protocol_nero_sketch_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_nero_sketch_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderNeroSketch, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_nero_sketch_decoder = {
     .alloc = subghz_protocol_decoder_nero_sketch_alloc,
     .free = subghz_protocol_decoder_nero_sketch_free,
@@ -48,6 +59,8 @@ const SubGhzProtocolDecoder subghz_protocol_nero_sketch_decoder = {
     .serialize = subghz_protocol_decoder_nero_sketch_serialize,
     .deserialize = subghz_protocol_decoder_nero_sketch_deserialize,
     .get_string = subghz_protocol_decoder_nero_sketch_get_string,
+
+    .timing = &subghz_protocol_nero_sketch_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nero_sketch_encoder = {
@@ -35,6 +35,17 @@ typedef enum {
     NiceFloDecoderStepCheckDuration,
 } NiceFloDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_nice_flo_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 36, .delta_count = 36},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_nice_flo_decoder_timing = {
+    .block_const = &subghz_protocol_nice_flo_const,
+    .start = subghz_protocol_nice_flo_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_nice_flo_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderNiceFlo, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_nice_flo_decoder = {
     .alloc = subghz_protocol_decoder_nice_flo_alloc,
     .free = subghz_protocol_decoder_nice_flo_free,
@@ -46,6 +57,8 @@ const SubGhzProtocolDecoder subghz_protocol_nice_flo_decoder = {
     .serialize = subghz_protocol_decoder_nice_flo_serialize,
     .deserialize = subghz_protocol_decoder_nice_flo_deserialize,
     .get_string = subghz_protocol_decoder_nice_flo_get_string,
+
+    .timing = &subghz_protocol_nice_flo_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nice_flo_encoder = {
@@ -28,6 +28,7 @@ struct SubGhzProtocolDecoderNiceFlorS {
     SubGhzBlockGeneric generic;
 
     const char* nice_flor_s_rainbow_table_file_name;
+    SubGhzKeystoreRaw* nice_flor_s_rainbow_table;
 };
 
 struct SubGhzProtocolEncoderNiceFlorS {
@@ -45,6 +46,17 @@ typedef enum {
     NiceFlorSDecoderStepCheckDuration,
 } NiceFlorSDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_nice_flor_s_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 38, .delta_count = 38},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_nice_flor_s_decoder_timing = {
+    .block_const = &subghz_protocol_nice_flor_s_const,
+    .start = subghz_protocol_nice_flor_s_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_nice_flor_s_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderNiceFlorS, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_nice_flor_s_decoder = {
     .alloc = subghz_protocol_decoder_nice_flor_s_alloc,
     .free = subghz_protocol_decoder_nice_flor_s_free,
@@ -56,6 +68,8 @@ const SubGhzProtocolDecoder subghz_protocol_nice_flor_s_decoder = {
     .serialize = subghz_protocol_decoder_nice_flor_s_serialize,
     .deserialize = subghz_protocol_decoder_nice_flor_s_deserialize,
     .get_string = subghz_protocol_decoder_nice_flor_s_get_string,
+
+    .timing = &subghz_protocol_nice_flor_s_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nice_flor_s_encoder = {
@@ -79,16 +93,17 @@ const SubGhzProtocol subghz_protocol_nice_flor_s = {
 
 /** 
  * Read bytes from rainbow table
- * @param file_name Full path to rainbow table the file 
+ * @param rainbow_table Open rainbow table file
  * @param address Byte address in file
  * @return data
  */
-static uint8_t
-    subghz_protocol_nice_flor_s_get_byte_in_file(const char* file_name, uint32_t address) {
-    if(!file_name) return 0;
+static uint8_t subghz_protocol_nice_flor_s_get_byte_in_file(
+    SubGhzKeystoreRaw* rainbow_table,
+    uint32_t address) {
+    if(!rainbow_table) return 0;
 
     uint8_t buffer[1] = {0};
-    if(subghz_keystore_raw_get_data(file_name, address, buffer, sizeof(uint8_t))) {
+    if(subghz_keystore_raw_read(rainbow_table, address, buffer, sizeof(uint8_t))) {
         return buffer[0];
     } else {
         return 0;
@@ -101,17 +116,17 @@ static inline void subghz_protocol_decoder_nice_flor_s_magic_xor(uint8_t* p, uin
     }
 }
 
-uint64_t subghz_protocol_nice_flor_s_encrypt(uint64_t data, const char* file_name) {
+uint64_t subghz_protocol_nice_flor_s_encrypt(uint64_t data, SubGhzKeystoreRaw* rainbow_table) {
     uint8_t* p = (uint8_t*)&data;
 
     uint8_t k = 0;
     for(uint8_t y = 0; y < 2; y++) {
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] & 0x1f);
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(rainbow_table, p[0] & 0x1f);
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
         p[0] ^= k & 0xe0;
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] >> 3) + 0x25;
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(rainbow_table, p[0] >> 3) + 0x25;
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
@@ -135,8 +150,9 @@ uint64_t subghz_protocol_nice_flor_s_encrypt(uint64_t data, const char* file_nam
     return data;
 }
 
-static uint64_t
-    subghz_protocol_nice_flor_s_decrypt(SubGhzBlockGeneric* instance, const char* file_name) {
+static uint64_t subghz_protocol_nice_flor_s_decrypt(
+    SubGhzBlockGeneric* instance,
+    SubGhzKeystoreRaw* rainbow_table) {
     furi_assert(instance);
     uint64_t data = instance->data;
     uint8_t* p = (uint8_t*)&data;
@@ -153,12 +169,12 @@ static uint64_t
     p[1] = k;
 
     for(uint8_t y = 0; y < 2; y++) {
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] >> 3) + 0x25;
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(rainbow_table, p[0] >> 3) + 0x25;
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
         p[0] ^= k & 0x7;
-        k = subghz_protocol_nice_flor_s_get_byte_in_file(file_name, p[0] & 0x1f);
+        k = subghz_protocol_nice_flor_s_get_byte_in_file(rainbow_table, p[0] & 0x1f);
         subghz_protocol_decoder_nice_flor_s_magic_xor(p, k);
 
         p[5] &= 0x0f;
@@ -190,6 +206,9 @@ void subghz_protocol_decoder_nice_flor_s_free(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderNiceFlorS* instance = context;
     instance->nice_flor_s_rainbow_table_file_name = NULL;
+    if(instance->nice_flor_s_rainbow_table) {
+        subghz_keystore_raw_close(instance->nice_flor_s_rainbow_table);
+    }
     free(instance);
 }
 
@@ -278,14 +297,30 @@ void subghz_protocol_decoder_nice_flor_s_feed(void* context, bool level, uint32_
     }
 }
 
+/** 
+ * Rainbow table is opened on first use and kept open while the decoder exists
+ * @param instance Pointer to a SubGhzProtocolDecoderNiceFlorS instance
+ * @return SubGhzKeystoreRaw* or NULL if there is no table
+ */
+static SubGhzKeystoreRaw*
+    subghz_protocol_nice_flor_s_get_rainbow_table(SubGhzProtocolDecoderNiceFlorS* instance) {
+    if(!instance->nice_flor_s_rainbow_table && instance->nice_flor_s_rainbow_table_file_name) {
+        instance->nice_flor_s_rainbow_table =
+            subghz_keystore_raw_open(instance->nice_flor_s_rainbow_table_file_name);
+    }
+    return instance->nice_flor_s_rainbow_table;
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param file_name Full path to rainbow table the file 
+ * @param rainbow_table Open rainbow table file
  */
 static void subghz_protocol_nice_flor_s_remote_controller(
     SubGhzBlockGeneric* instance,
-    const char* file_name) {
+    const char* file_name,
+    SubGhzKeystoreRaw* rainbow_table) {
     /*
     * Packet format Nice Flor-s: START-P0-P1-P2-P3-P4-P5-P6-P7-STOP
     * P0 (4-bit)    - button positional code - 1:0x1, 2:0x2, 3:0x4, 4:0x8;
@@ -313,7 +348,7 @@ static void subghz_protocol_nice_flor_s_remote_controller(
         instance->serial = 0;
         instance->btn = 0;
     } else {
-        uint64_t decrypt = subghz_protocol_nice_flor_s_decrypt(instance, file_name);
+        uint64_t decrypt = subghz_protocol_nice_flor_s_decrypt(instance, rainbow_table);
         instance->cnt = decrypt & 0xFFFF;
         instance->serial = (decrypt >> 16) & 0xFFFFFFF;
         instance->btn = (decrypt >> 48) & 0xF;
@@ -359,7 +394,9 @@ void subghz_protocol_decoder_nice_flor_s_get_string(void* context, string_t outp
     SubGhzProtocolDecoderNiceFlorS* instance = context;
 
     subghz_protocol_nice_flor_s_remote_controller(
-        &instance->generic, instance->nice_flor_s_rainbow_table_file_name);
+        &instance->generic,
+        instance->nice_flor_s_rainbow_table_file_name,
+        subghz_protocol_nice_flor_s_get_rainbow_table(instance));
     uint32_t code_found_hi = instance->generic.data >> 32;
     uint32_t code_found_lo = instance->generic.data & 0x00000000ffffffff;
 
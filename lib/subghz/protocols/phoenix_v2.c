@@ -38,6 +38,17 @@ typedef enum {
     Phoenix_V2DecoderStepCheckDuration,
 } Phoenix_V2DecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_phoenix_v2_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 60, .delta_count = 30},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_phoenix_v2_decoder_timing = {
+    .block_const = &subghz_protocol_phoenix_v2_const,
+    .start = subghz_protocol_phoenix_v2_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_phoenix_v2_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderPhoenix_V2, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_phoenix_v2_decoder = {
     .alloc = subghz_protocol_decoder_phoenix_v2_alloc,
     .free = subghz_protocol_decoder_phoenix_v2_free,
@@ -49,6 +60,8 @@ const SubGhzProtocolDecoder subghz_protocol_phoenix_v2_decoder = {
     .serialize = subghz_protocol_decoder_phoenix_v2_serialize,
     .deserialize = subghz_protocol_decoder_phoenix_v2_deserialize,
     .get_string = subghz_protocol_decoder_phoenix_v2_get_string,
+
+    .timing = &subghz_protocol_phoenix_v2_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_phoenix_v2_encoder = {
@@ -46,6 +46,17 @@ typedef enum {
     PrincetonDecoderStepCheckDuration,
 } PrincetonDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_princeton_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 36, .delta_count = 36},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_princeton_decoder_timing = {
+    .block_const = &subghz_protocol_princeton_const,
+    .start = subghz_protocol_princeton_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_princeton_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderPrinceton, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_princeton_decoder = {
     .alloc = subghz_protocol_decoder_princeton_alloc,
     .free = subghz_protocol_decoder_princeton_free,
@@ -57,6 +68,8 @@ const SubGhzProtocolDecoder subghz_protocol_princeton_decoder = {
     .serialize = subghz_protocol_decoder_princeton_serialize,
     .deserialize = subghz_protocol_decoder_princeton_deserialize,
     .get_string = subghz_protocol_decoder_princeton_get_string,
+
+    .timing = &subghz_protocol_princeton_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_princeton_encoder = {
@@ -1,6 +1,7 @@
 #include "raw.h"
 #include <lib/flipper_format/flipper_format.h>
 #include "../subghz_file_encoder_worker.h"
+#include "../subghz_raw_packed.h"
 
 #include "../blocks/const.h"
 #include "../blocks/decoder.h"
@@ -32,6 +33,7 @@ struct SubGhzProtocolDecoderRAW {
     string_t file_name;
     size_t sample_write;
     bool last_level;
+    bool packed;
 };
 
 struct SubGhzProtocolEncoderRAW {
@@ -153,6 +155,14 @@ bool subghz_protocol_raw_save_to_file_init(
             FURI_LOG_E(TAG, "Unable to add Protocol");
             break;
         }
+        if(instance->packed) {
+            uint32_t version = SUBGHZ_RAW_PACKED_VERSION;
+            if(!flipper_format_write_uint32(
+                   instance->flipper_file, SUBGHZ_RAW_PACKED_KEY, &version, 1)) {
+                FURI_LOG_E(TAG, "Unable to add " SUBGHZ_RAW_PACKED_KEY);
+                break;
+            }
+        }
 
         instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
         instance->file_is_open = RAWFileIsOpenWrite;
@@ -170,8 +180,17 @@ static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* ins
 
     bool is_write = false;
     if(instance->file_is_open == RAWFileIsOpenWrite) {
-        if(!flipper_format_write_int32(
-               instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
+        bool res;
+        if(instance->packed) {
+            res = subghz_raw_packed_write(
+                flipper_format_get_raw_stream(instance->flipper_file),
+                instance->upload_raw,
+                instance->ind_write);
+        } else {
+            res = flipper_format_write_int32(
+                instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write);
+        }
+        if(!res) {
             FURI_LOG_E(TAG, "Unable to add RAW_Data");
         } else {
             instance->sample_write += instance->ind_write;
@@ -182,6 +201,12 @@ static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* ins
     return is_write;
 }
 
+void subghz_protocol_raw_save_to_file_set_packed(SubGhzProtocolDecoderRAW* instance, bool packed) {
+    furi_assert(instance);
+    furi_assert(instance->file_is_open == RAWFileIsOpenClose);
+    instance->packed = packed;
+}
+
 void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
     furi_assert(instance);
 
@@ -209,6 +234,7 @@ void* subghz_protocol_decoder_raw_alloc(SubGhzEnvironment* environment) {
     instance->upload_raw = NULL;
     instance->ind_write = 0;
     instance->last_level = false;
+    instance->packed = false;
     instance->file_is_open = RAWFileIsOpenClose;
     string_init(instance->file_name);
 
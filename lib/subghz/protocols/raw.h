@@ -25,6 +25,14 @@ bool subghz_protocol_raw_save_to_file_init(
     const char* dev_name,
     SubGhzPresetDefinition* preset);
 
+/**
+ * Write samples as packed binary blocks instead of RAW_Data lines, off by default.
+ * Must be set before subghz_protocol_raw_save_to_file_init.
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param packed true - packed binary data, false - text
+ */
+void subghz_protocol_raw_save_to_file_set_packed(SubGhzProtocolDecoderRAW* instance, bool packed);
+
 /**
  * Stop writing file to flash
  * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
@@ -44,6 +44,17 @@ typedef enum {
     ScherKhanDecoderStepCheckDuration,
 } ScherKhanDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_scher_khan_start_pulses[] = {
+    {.level = true, .te = SubGhzProtocolDecoderTeShort, .te_count = 2, .delta_count = 1},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_scher_khan_decoder_timing = {
+    .block_const = &subghz_protocol_scher_khan_const,
+    .start = subghz_protocol_scher_khan_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_scher_khan_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderScherKhan, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_scher_khan_decoder = {
     .alloc = subghz_protocol_decoder_scher_khan_alloc,
     .free = subghz_protocol_decoder_scher_khan_free,
@@ -55,6 +66,8 @@ const SubGhzProtocolDecoder subghz_protocol_scher_khan_decoder = {
     .serialize = subghz_protocol_decoder_scher_khan_serialize,
     .deserialize = subghz_protocol_decoder_scher_khan_deserialize,
     .get_string = subghz_protocol_decoder_scher_khan_get_string,
+
+    .timing = &subghz_protocol_scher_khan_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_scher_khan_encoder = {
@@ -59,6 +59,17 @@ typedef enum {
     SecPlus_v1DecoderStepDecoderData,
 } SecPlus_v1DecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_secplus_v1_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeShort, .te_count = 120, .delta_count = 120},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_secplus_v1_decoder_timing = {
+    .block_const = &subghz_protocol_secplus_v1_const,
+    .start = subghz_protocol_secplus_v1_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_secplus_v1_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderSecPlus_v1, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_secplus_v1_decoder = {
     .alloc = subghz_protocol_decoder_secplus_v1_alloc,
     .free = subghz_protocol_decoder_secplus_v1_free,
@@ -70,6 +81,8 @@ const SubGhzProtocolDecoder subghz_protocol_secplus_v1_decoder = {
     .serialize = subghz_protocol_decoder_secplus_v1_serialize,
     .deserialize = subghz_protocol_decoder_secplus_v1_deserialize,
     .get_string = subghz_protocol_decoder_secplus_v1_get_string,
+
+    .timing = &subghz_protocol_secplus_v1_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_secplus_v1_encoder = {
@@ -51,6 +51,17 @@ typedef enum {
     SecPlus_v2DecoderStepDecoderData,
 } SecPlus_v2DecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_secplus_v2_start_pulses[] = {
+    {.level = false, .te = SubGhzProtocolDecoderTeLong, .te_count = 130, .delta_count = 100},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_secplus_v2_decoder_timing = {
+    .block_const = &subghz_protocol_secplus_v2_const,
+    .start = subghz_protocol_secplus_v2_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_secplus_v2_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderSecPlus_v2, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_secplus_v2_decoder = {
     .alloc = subghz_protocol_decoder_secplus_v2_alloc,
     .free = subghz_protocol_decoder_secplus_v2_free,
@@ -62,6 +73,8 @@ const SubGhzProtocolDecoder subghz_protocol_secplus_v2_decoder = {
     .serialize = subghz_protocol_decoder_secplus_v2_serialize,
     .deserialize = subghz_protocol_decoder_secplus_v2_deserialize,
     .get_string = subghz_protocol_decoder_secplus_v2_get_string,
+
+    .timing = &subghz_protocol_secplus_v2_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_secplus_v2_encoder = {
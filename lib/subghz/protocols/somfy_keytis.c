@@ -42,6 +42,17 @@ typedef enum {
     SomfyKeytisDecoderStepDecoderData,
 } SomfyKeytisDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_somfy_keytis_start_pulses[] = {
+    {.level = true, .te = SubGhzProtocolDecoderTeShort, .te_count = 4, .delta_count = 4},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_somfy_keytis_decoder_timing = {
+    .block_const = &subghz_protocol_somfy_keytis_const,
+    .start = subghz_protocol_somfy_keytis_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_somfy_keytis_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderSomfyKeytis, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_somfy_keytis_decoder = {
     .alloc = subghz_protocol_decoder_somfy_keytis_alloc,
     .free = subghz_protocol_decoder_somfy_keytis_free,
@@ -53,6 +64,8 @@ const SubGhzProtocolDecoder subghz_protocol_somfy_keytis_decoder = {
     .serialize = subghz_protocol_decoder_somfy_keytis_serialize,
     .deserialize = subghz_protocol_decoder_somfy_keytis_deserialize,
     .get_string = subghz_protocol_decoder_somfy_keytis_get_string,
+
+    .timing = &subghz_protocol_somfy_keytis_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_somfy_keytis_encoder = {
@@ -41,6 +41,17 @@ typedef enum {
     SomfyTelisDecoderStepDecoderData,
 } SomfyTelisDecoderStep;
 
+static const SubGhzProtocolDecoderPulse subghz_protocol_somfy_telis_start_pulses[] = {
+    {.level = true, .te = SubGhzProtocolDecoderTeShort, .te_count = 4, .delta_count = 4},
+};
+
+static const SubGhzProtocolDecoderTiming subghz_protocol_somfy_telis_decoder_timing = {
+    .block_const = &subghz_protocol_somfy_telis_const,
+    .start = subghz_protocol_somfy_telis_start_pulses,
+    .start_count = COUNT_OF(subghz_protocol_somfy_telis_start_pulses),
+    .parser_step_offset = offsetof(SubGhzProtocolDecoderSomfyTelis, decoder.parser_step),
+};
+
 const SubGhzProtocolDecoder subghz_protocol_somfy_telis_decoder = {
     .alloc = subghz_protocol_decoder_somfy_telis_alloc,
     .free = subghz_protocol_decoder_somfy_telis_free,
@@ -52,6 +63,8 @@ const SubGhzProtocolDecoder subghz_protocol_somfy_telis_decoder = {
     .serialize = subghz_protocol_decoder_somfy_telis_serialize,
     .deserialize = subghz_protocol_decoder_somfy_telis_deserialize,
     .get_string = subghz_protocol_decoder_somfy_telis_get_string,
+
+    .timing = &subghz_protocol_somfy_telis_decoder_timing,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_somfy_telis_encoder = {
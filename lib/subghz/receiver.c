@@ -4,8 +4,15 @@
 
 #include <m-array.h>
 
+/* Quarter-octave duration buckets: 4 per power of two, durations above 2^20us share the last one */
+#define SUBGHZ_RECEIVER_BUCKET_DURATION_BITS 20
+#define SUBGHZ_RECEIVER_BUCKET_COUNT ((SUBGHZ_RECEIVER_BUCKET_DURATION_BITS + 1) * 4)
+#define SUBGHZ_RECEIVER_BUCKET_SLOT_MAX 32
+
 typedef struct {
     SubGhzProtocolEncoderBase* base;
+    const uint32_t* parser_step; // NULL if the decoder gets every pulse
+    uint32_t mask;
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
@@ -15,23 +22,70 @@ struct SubGhzReceiver {
     SubGhzReceiverSlotArray_t slots;
     SubGhzProtocolFlag filter;
 
+    // Slots whose start pulses overlap the bucket, by level
+    uint32_t start_mask[2][SUBGHZ_RECEIVER_BUCKET_COUNT];
+    bool dispatch;
+
     SubGhzReceiverCallback callback;
     void* context;
 };
 
+static inline uint8_t subghz_receiver_get_bucket(uint32_t duration) {
+    if(duration < 4) return duration;
+    uint8_t bits = 32 - __builtin_clz(duration);
+    if(bits > SUBGHZ_RECEIVER_BUCKET_DURATION_BITS) {
+        return SUBGHZ_RECEIVER_BUCKET_COUNT - 1;
+    }
+    return bits * 4 + ((duration >> (bits - 3)) & 0x3);
+}
+
+static void subghz_receiver_add_timing(
+    SubGhzReceiver* instance,
+    SubGhzReceiverSlot* slot,
+    const SubGhzProtocolDecoderTiming* timing) {
+    slot->parser_step = (const uint32_t*)((uint8_t*)slot->base + timing->parser_step_offset);
+
+    for(size_t i = 0; i < timing->start_count; i++) {
+        const SubGhzProtocolDecoderPulse* pulse = &timing->start[i];
+        uint32_t te = (pulse->te == SubGhzProtocolDecoderTeShort) ?
+                          timing->block_const->te_short :
+                          timing->block_const->te_long;
+        uint32_t center = te * pulse->te_count;
+        uint32_t delta = timing->block_const->te_delta * pulse->delta_count;
+        // DURATION_DIFF(duration, center) < delta
+        uint32_t duration_min = (center >= delta) ? (center - delta + 1) : 0;
+        uint32_t duration_max = center + delta - 1;
+
+        uint8_t bucket_max = subghz_receiver_get_bucket(duration_max);
+        for(uint8_t bucket = subghz_receiver_get_bucket(duration_min); bucket <= bucket_max;
+            bucket++) {
+            instance->start_mask[pulse->level][bucket] |= slot->mask;
+        }
+    }
+}
+
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
     SubGhzReceiverSlotArray_init(instance->slots);
+    memset(instance->start_mask, 0, sizeof(instance->start_mask));
 
     for(size_t i = 0; i < subghz_protocol_registry_count(); ++i) {
         const SubGhzProtocol* protocol = subghz_protocol_registry_get_by_index(i);
 
         if(protocol->decoder && protocol->decoder->alloc) {
+            size_t index = SubGhzReceiverSlotArray_size(instance->slots);
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
             slot->base = protocol->decoder->alloc(environment);
+            slot->parser_step = NULL;
+            slot->mask = 0;
+            if(protocol->decoder->timing && index < SUBGHZ_RECEIVER_BUCKET_SLOT_MAX) {
+                slot->mask = 1UL << index;
+                subghz_receiver_add_timing(instance, slot, protocol->decoder->timing);
+            }
         }
     }
 
+    instance->dispatch = true;
     instance->callback = NULL;
     instance->context = NULL;
 
@@ -59,9 +113,17 @@ void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t durat
     furi_assert(instance);
     furi_assert(instance->slots);
 
+    uint32_t start_mask = instance->dispatch ?
+                              instance->start_mask[level][subghz_receiver_get_bucket(duration)] :
+                              0xFFFFFFFF;
+
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
             if((slot->base->protocol->flag & instance->filter) == instance->filter) {
+                // Idle decoder can't leave reset state on this pulse
+                if(slot->parser_step && !(start_mask & slot->mask) && *slot->parser_step == 0) {
+                    continue;
+                }
                 slot->base->protocol->decoder->feed(slot->base, level, duration);
             }
         }
@@ -105,6 +167,11 @@ void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag fil
     instance->filter = filter;
 }
 
+void subghz_receiver_set_dispatch(SubGhzReceiver* instance, bool enable) {
+    furi_assert(instance);
+    instance->dispatch = enable;
+}
+
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
     SubGhzReceiver* instance,
     const char* decoder_name) {
@@ -55,6 +55,14 @@ void subghz_receiver_set_rx_callback(
  */
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter);
 
+/**
+ * Enable routing of pulses by decoder timing. Idle decoders only get pulses that
+ * can start their frame. Enabled by default, disable to feed every pulse to all decoders.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param enable true to enable pulse routing
+ */
+void subghz_receiver_set_dispatch(SubGhzReceiver* instance, bool enable);
+
 /**
  * Search for a cattery by his name.
  * @param instance Pointer to a SubGhzReceiver instance
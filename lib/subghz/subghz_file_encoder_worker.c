@@ -1,4 +1,5 @@
 #include "subghz_file_encoder_worker.h"
+#include "subghz_raw_packed.h"
 #include <stream_buffer.h>
 
 #include <toolbox/stream/stream.h>
@@ -19,6 +20,7 @@ struct SubGhzFileEncoderWorker {
     volatile bool worker_running;
     volatile bool worker_stoping;
     bool level;
+    bool packed;
     string_t str_data;
     string_t file_path;
 
@@ -54,13 +56,17 @@ void subghz_file_encoder_worker_add_level_duration(
     }
 }
 
-bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
+bool subghz_file_encoder_worker_parse_line(
+    const char* line,
+    SubGhzFileEncoderWorkerDataCallback callback,
+    void* context) {
+    furi_assert(callback);
     char* str1;
     bool res = false;
     // Line sample: "RAW_Data: -1, 2, -2..."
 
     // Look for a key in the line
-    str1 = strstr(strStart, "RAW_Data: ");
+    str1 = strstr(line, "RAW_Data: ");
 
     if(str1 != NULL) {
         // Skip key
@@ -72,13 +78,23 @@ bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, co
 
             // Skip space
             str1 += 1;
-            subghz_file_encoder_worker_add_level_duration(instance, atoi(str1));
+            callback(atoi(str1), context);
         }
         res = true;
     }
     return res;
 }
 
+static void subghz_file_encoder_worker_data_parse_callback(int32_t duration, void* context) {
+    SubGhzFileEncoderWorker* instance = context;
+    subghz_file_encoder_worker_add_level_duration(instance, duration);
+}
+
+bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
+    return subghz_file_encoder_worker_parse_line(
+        strStart, subghz_file_encoder_worker_data_parse_callback, instance);
+}
+
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
     furi_assert(context);
     SubGhzFileEncoderWorker* instance = context;
@@ -129,6 +145,12 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
 
         //skip the end of the previous line "\n"
         stream_seek(stream, 1, StreamOffsetFromCurrent);
+
+        // Packed data goes right after its marker line, text lines are read from the start
+        size_t data_start = stream_tell(stream);
+        instance->packed = stream_read_line(stream, instance->str_data) &&
+                           subghz_raw_packed_check_line(string_get_cstr(instance->str_data));
+        if(!instance->packed) stream_seek(stream, data_start, StreamOffsetFromStart);
         res = true;
         instance->worker_stoping = false;
         FURI_LOG_I(TAG, "Start transmission");
@@ -137,7 +159,14 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     while(res && instance->worker_running) {
         size_t stream_free_byte = xStreamBufferSpacesAvailable(instance->stream);
         if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
+            if(instance->packed) {
+                if(!subghz_raw_packed_read(
+                       stream, subghz_file_encoder_worker_data_parse_callback, instance)) {
+                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+                    break;
+                }
+            } else if(stream_read_line(stream, instance->str_data)) {
                 string_strim(instance->str_data);
                 if(!subghz_file_encoder_worker_data_parse(
                        instance, string_get_cstr(instance->str_data))) {
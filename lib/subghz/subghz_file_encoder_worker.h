@@ -4,6 +4,8 @@
 
 typedef void (*SubGhzFileEncoderWorkerCallbackEnd)(void* context);
 
+typedef void (*SubGhzFileEncoderWorkerDataCallback)(int32_t duration, void* context);
+
 typedef struct SubGhzFileEncoderWorker SubGhzFileEncoderWorker;
 
 /** 
@@ -28,6 +30,18 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc();
  */
 void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance);
 
+/**
+ * Parse RAW_Data line, same parser the worker uses for file playback.
+ * @param line Line sample: "RAW_Data: -1, 2, -2..."
+ * @param callback Called for each signed duration, positive is high level
+ * @param context Context for callback
+ * @return true if line holds RAW_Data
+ */
+bool subghz_file_encoder_worker_parse_line(
+    const char* line,
+    SubGhzFileEncoderWorkerDataCallback callback,
+    void* context);
+
 /**
  * Getting the level and duration of the upload to be loaded into DMA.
  * @param context Pointer to a SubGhzFileEncoderWorker instance
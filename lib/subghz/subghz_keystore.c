@@ -15,25 +15,57 @@
 
 #define SUBGHZ_KEYSTORE_FILE_TYPE "Flipper SubGhz Keystore File"
 #define SUBGHZ_KEYSTORE_FILE_RAW_TYPE "Flipper SubGhz Keystore RAW File"
+#define SUBGHZ_KEYSTORE_FILE_BINARY_TYPE "Flipper SubGhz Keystore Binary File"
 #define SUBGHZ_KEYSTORE_FILE_VERSION 0
 
 #define SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT 1
 #define SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE 512
 #define SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE (SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE * 2)
 
+#define SUBGHZ_KEYSTORE_RAW_CACHE_SIZE 16
+
+#define SUBGHZ_KEYSTORE_NAME_BLOCK_SIZE 1024
+#define SUBGHZ_KEYSTORE_BINARY_BUFFER_SIZE 2048
+#define SUBGHZ_KEYSTORE_BINARY_KEYS_MAX 0x10000
+#define SUBGHZ_KEYSTORE_BINARY_NAMES_MAX 0x10000
+
 typedef enum {
     SubGhzKeystoreEncryptionNone,
     SubGhzKeystoreEncryptionAES256,
 } SubGhzKeystoreEncryption;
 
+/** Binary keystore record, name_offset points into the name table that follows the records */
+typedef struct {
+    uint64_t key;
+    uint16_t type;
+    uint16_t reserved;
+    uint32_t name_offset;
+} SubGhzKeystoreBinaryRecord;
+
+_Static_assert(
+    sizeof(SubGhzKeystoreBinaryRecord) == 16,
+    "Incorrect SubGhzKeystoreBinaryRecord size");
+
+ARRAY_DEF(SubGhzKeystoreNameBlockArray, char*, M_PTR_OPLIST)
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
+    SubGhzKeyBatchArray_t batch_data;
+    size_t batch_key_count;
+    SubGhzKeystoreNameBlockArray_t name_blocks; // storage for SubGhzKey names
+    char* name_cursor;
+    size_t name_free;
 };
 
 SubGhzKeystore* subghz_keystore_alloc() {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    SubGhzKeyBatchArray_init(instance->batch_data);
+    instance->batch_key_count = 0;
+    SubGhzKeystoreNameBlockArray_init(instance->name_blocks);
+    instance->name_cursor = NULL;
+    instance->name_free = 0;
 
     return instance;
 }
@@ -43,21 +75,43 @@ void subghz_keystore_free(SubGhzKeystore* instance) {
 
     for
         M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
-            string_clear(manufacture_code->name);
             manufacture_code->key = 0;
         }
     SubGhzKeyArray_clear(instance->data);
+    SubGhzKeyBatchArray_clear(instance->batch_data);
+
+    for
+        M_EACH(name_block, instance->name_blocks, SubGhzKeystoreNameBlockArray_t) {
+            free(*name_block);
+        }
+    SubGhzKeystoreNameBlockArray_clear(instance->name_blocks);
 
     free(instance);
 }
 
+static const char* subghz_keystore_store_name(SubGhzKeystore* instance, const char* name) {
+    size_t size = strlen(name) + 1;
+    if(instance->name_free < size) {
+        // Names are never freed one by one, so pack them into blocks
+        size_t block_size = MAX(size, (size_t)SUBGHZ_KEYSTORE_NAME_BLOCK_SIZE);
+        instance->name_cursor = malloc(block_size);
+        instance->name_free = block_size;
+        SubGhzKeystoreNameBlockArray_push_back(instance->name_blocks, instance->name_cursor);
+    }
+    char* stored_name = instance->name_cursor;
+    memcpy(stored_name, name, size);
+    instance->name_cursor += size;
+    instance->name_free -= size;
+    return stored_name;
+}
+
 static void subghz_keystore_add_key(
     SubGhzKeystore* instance,
     const char* name,
     uint64_t key,
     uint16_t type) {
     SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
-    string_init_set_str(manufacture_code->name, name);
+    manufacture_code->name = subghz_keystore_store_name(instance, name);
     manufacture_code->key = key;
     manufacture_code->type = type;
 }
@@ -177,6 +231,132 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
     return result;
 }
 
+static bool subghz_keystore_read_binary_data(
+    Stream* stream,
+    uint8_t* data,
+    size_t size,
+    bool decrypt) {
+    if(stream_read(stream, data, size) != size) {
+        FURI_LOG_E(TAG, "Unexpected end of file");
+        return false;
+    }
+    // CBC chain continues from the previous call while the key stays loaded
+    if(decrypt && !furi_hal_crypto_decrypt(data, data, size)) {
+        FURI_LOG_E(TAG, "Decryption failed");
+        return false;
+    }
+    return true;
+}
+
+static bool subghz_keystore_read_binary_file(
+    SubGhzKeystore* instance,
+    FlipperFormat* flipper_format,
+    uint8_t* iv) {
+    bool result = false;
+    bool key_loaded = false;
+    uint32_t key_count = 0;
+    uint32_t names_size = 0;
+    size_t initial_key_count = SubGhzKeyArray_size(instance->data);
+    SubGhzKeystoreBinaryRecord* records = NULL;
+    char* names = NULL;
+
+    string_t str_temp;
+    string_init(str_temp);
+
+    do {
+        if(!flipper_format_read_uint32(flipper_format, "Keys", &key_count, 1) ||
+           !flipper_format_read_uint32(flipper_format, "Names", &names_size, 1)) {
+            FURI_LOG_E(TAG, "Missing key count or name table size");
+            break;
+        }
+        if(key_count > SUBGHZ_KEYSTORE_BINARY_KEYS_MAX || names_size == 0 ||
+           names_size > SUBGHZ_KEYSTORE_BINARY_NAMES_MAX || names_size % 16 != 0) {
+            FURI_LOG_E(TAG, "Invalid key count or name table size");
+            break;
+        }
+        if(!flipper_format_read_string(flipper_format, "Encrypt_data", str_temp)) {
+            FURI_LOG_E(TAG, "Missing Encrypt_data");
+            break;
+        }
+
+        Stream* stream = flipper_format_get_raw_stream(flipper_format);
+        //skip the end of the previous line "\n"
+        stream_seek(stream, 1, StreamOffsetFromCurrent);
+        size_t data_size = key_count * sizeof(SubGhzKeystoreBinaryRecord) + names_size;
+        if(stream_size(stream) - stream_tell(stream) < data_size) {
+            FURI_LOG_E(TAG, "Data size mismatch");
+            break;
+        }
+
+        if(iv) {
+            if(!furi_hal_crypto_store_load_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, iv)) {
+                FURI_LOG_E(TAG, "Unable to load decryption key");
+                break;
+            }
+            key_loaded = true;
+        }
+
+        names = malloc(names_size);
+        records = malloc(SUBGHZ_KEYSTORE_BINARY_BUFFER_SIZE);
+        SubGhzKeyArray_reserve(instance->data, initial_key_count + key_count);
+
+        // Names are resolved before the table is read, offsets are checked against its size
+        result = true;
+        size_t records_left = key_count;
+        while(records_left > 0 && result) {
+            size_t count = MIN(
+                records_left,
+                SUBGHZ_KEYSTORE_BINARY_BUFFER_SIZE / sizeof(SubGhzKeystoreBinaryRecord));
+            result = subghz_keystore_read_binary_data(
+                stream,
+                (uint8_t*)records,
+                count * sizeof(SubGhzKeystoreBinaryRecord),
+                key_loaded);
+            for(size_t i = 0; i < count && result; i++) {
+                if(records[i].name_offset >= names_size) {
+                    FURI_LOG_E(TAG, "Invalid name offset");
+                    result = false;
+                    break;
+                }
+                SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
+                manufacture_code->name = names + records[i].name_offset;
+                manufacture_code->key = records[i].key;
+                manufacture_code->type = records[i].type;
+            }
+            records_left -= count;
+        }
+        if(!result) break;
+
+        // Stream reads are limited to 16 bit sizes, so the table is read in chunks too
+        for(size_t offset = 0; offset < names_size && result;
+            offset += SUBGHZ_KEYSTORE_BINARY_BUFFER_SIZE) {
+            result = subghz_keystore_read_binary_data(
+                stream,
+                (uint8_t*)names + offset,
+                MIN(names_size - offset, SUBGHZ_KEYSTORE_BINARY_BUFFER_SIZE),
+                key_loaded);
+        }
+        if(result && names[names_size - 1] != '\0') {
+            FURI_LOG_E(TAG, "Malformed name table");
+            result = false;
+        }
+    } while(0);
+
+    if(key_loaded) furi_hal_crypto_store_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+
+    if(result) {
+        SubGhzKeystoreNameBlockArray_push_back(instance->name_blocks, names);
+        FURI_LOG_I(TAG, "Loaded %lu keys", key_count);
+    } else {
+        SubGhzKeyArray_resize(instance->data, initial_key_count);
+        if(names) free(names);
+    }
+    if(records) free(records);
+    string_clear(str_temp);
+
+    return result;
+}
+
 bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
     furi_assert(instance);
     bool result = false;
@@ -206,26 +386,32 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
             break;
         }
 
-        if(strcmp(string_get_cstr(filetype), SUBGHZ_KEYSTORE_FILE_TYPE) != 0 ||
+        bool binary = strcmp(string_get_cstr(filetype), SUBGHZ_KEYSTORE_FILE_BINARY_TYPE) == 0;
+        if((!binary && strcmp(string_get_cstr(filetype), SUBGHZ_KEYSTORE_FILE_TYPE) != 0) ||
            version != SUBGHZ_KEYSTORE_FILE_VERSION) {
             FURI_LOG_E(TAG, "Type or version mismatch");
             break;
         }
 
-        Stream* stream = flipper_format_get_raw_stream(flipper_format);
-        if(encryption == SubGhzKeystoreEncryptionNone) {
-            result = subghz_keystore_read_file(instance, stream, NULL);
-        } else if(encryption == SubGhzKeystoreEncryptionAES256) {
+        uint8_t* key_iv = NULL;
+        if(encryption == SubGhzKeystoreEncryptionAES256) {
             if(!flipper_format_read_hex(flipper_format, "IV", iv, 16)) {
                 FURI_LOG_E(TAG, "Missing IV");
                 break;
             }
             subghz_keystore_mess_with_iv(iv);
-            result = subghz_keystore_read_file(instance, stream, iv);
-        } else {
+            key_iv = iv;
+        } else if(encryption != SubGhzKeystoreEncryptionNone) {
             FURI_LOG_E(TAG, "Unknown encryption");
             break;
         }
+
+        if(binary) {
+            result = subghz_keystore_read_binary_file(instance, flipper_format, key_iv);
+        } else {
+            Stream* stream = flipper_format_get_raw_stream(flipper_format);
+            result = subghz_keystore_read_file(instance, stream, key_iv);
+        }
     } while(0);
     flipper_format_free(flipper_format);
 
@@ -287,7 +473,7 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
                     (uint32_t)(key->key >> 32),
                     (uint32_t)key->key,
                     key->type,
-                    string_get_cstr(key->name));
+                    key->name);
                 // Verify length and align
                 furi_assert(len > 0);
                 if(len % 16 != 0) {
@@ -331,11 +517,204 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
     return result;
 }
 
+typedef struct {
+    Stream* stream;
+    uint8_t* buffer;
+    size_t size;
+    bool encrypt;
+} SubGhzKeystoreBinaryWriter;
+
+static bool subghz_keystore_binary_flush(SubGhzKeystoreBinaryWriter* writer) {
+    if(writer->encrypt && !furi_hal_crypto_encrypt(writer->buffer, writer->buffer, writer->size)) {
+        FURI_LOG_E(TAG, "Encryption failed");
+        return false;
+    }
+    bool result = stream_write(writer->stream, writer->buffer, writer->size) == writer->size;
+    writer->size = 0;
+    return result;
+}
+
+static bool subghz_keystore_binary_write(
+    SubGhzKeystoreBinaryWriter* writer,
+    const void* data,
+    size_t size) {
+    const uint8_t* bytes = data;
+    while(size > 0) {
+        size_t chunk = MIN(size, SUBGHZ_KEYSTORE_BINARY_BUFFER_SIZE - writer->size);
+        memcpy(writer->buffer + writer->size, bytes, chunk);
+        writer->size += chunk;
+        bytes += chunk;
+        size -= chunk;
+        if(writer->size == SUBGHZ_KEYSTORE_BINARY_BUFFER_SIZE &&
+           !subghz_keystore_binary_flush(writer)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool subghz_keystore_save_binary(SubGhzKeystore* instance, const char* file_name, uint8_t* iv) {
+    furi_assert(instance);
+    bool result = false;
+    bool key_loaded = false;
+    uint32_t key_count = SubGhzKeyArray_size(instance->data);
+
+    // Equal names are stored once, offsets are assigned in order of first use
+    uint32_t* name_offsets = malloc(sizeof(uint32_t) * MAX(key_count, 1UL));
+    uint32_t names_size = 0;
+    for(size_t i = 0; i < key_count; i++) {
+        const char* name = SubGhzKeyArray_cget(instance->data, i)->name;
+        size_t j = 0;
+        while(j < i && strcmp(SubGhzKeyArray_cget(instance->data, j)->name, name) != 0) j++;
+        if(j < i) {
+            name_offsets[i] = name_offsets[j];
+        } else {
+            name_offsets[i] = names_size;
+            names_size += strlen(name) + 1;
+        }
+    }
+    uint32_t names_used = names_size;
+    if(names_size == 0 || names_size % 16 != 0) {
+        names_size += 16 - names_size % 16;
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    SubGhzKeystoreBinaryWriter writer = {
+        .stream = flipper_format_get_raw_stream(flipper_format),
+        .buffer = malloc(SUBGHZ_KEYSTORE_BINARY_BUFFER_SIZE),
+        .size = 0,
+        .encrypt = iv != NULL,
+    };
+
+    do {
+        if(names_size > SUBGHZ_KEYSTORE_BINARY_NAMES_MAX ||
+           key_count > SUBGHZ_KEYSTORE_BINARY_KEYS_MAX) {
+            FURI_LOG_E(TAG, "Keystore is too large");
+            break;
+        }
+        if(!flipper_format_file_open_always(flipper_format, file_name)) {
+            FURI_LOG_E(TAG, "Unable to open file for write: %s", file_name);
+            break;
+        }
+        if(!flipper_format_write_header_cstr(
+               flipper_format, SUBGHZ_KEYSTORE_FILE_BINARY_TYPE, SUBGHZ_KEYSTORE_FILE_VERSION)) {
+            FURI_LOG_E(TAG, "Unable to add header");
+            break;
+        }
+        uint32_t encryption = iv ? SubGhzKeystoreEncryptionAES256 :
+                                   SubGhzKeystoreEncryptionNone;
+        if(!flipper_format_write_uint32(flipper_format, "Encryption", &encryption, 1)) {
+            FURI_LOG_E(TAG, "Unable to add Encryption");
+            break;
+        }
+        if(iv && !flipper_format_write_hex(flipper_format, "IV", iv, 16)) {
+            FURI_LOG_E(TAG, "Unable to add IV");
+            break;
+        }
+        if(!flipper_format_write_uint32(flipper_format, "Keys", &key_count, 1) ||
+           !flipper_format_write_uint32(flipper_format, "Names", &names_size, 1)) {
+            FURI_LOG_E(TAG, "Unable to add Keys and Names");
+            break;
+        }
+        if(!flipper_format_write_string_cstr(flipper_format, "Encrypt_data", "BIN")) {
+            FURI_LOG_E(TAG, "Unable to add Encrypt_data");
+            break;
+        }
+
+        if(iv) {
+            subghz_keystore_mess_with_iv(iv);
+            if(!furi_hal_crypto_store_load_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, iv)) {
+                FURI_LOG_E(TAG, "Unable to load encryption key");
+                break;
+            }
+            key_loaded = true;
+        }
+
+        bool written = true;
+        for(size_t i = 0; i < key_count && written; i++) {
+            const SubGhzKey* key = SubGhzKeyArray_cget(instance->data, i);
+            SubGhzKeystoreBinaryRecord record = {
+                .key = key->key,
+                .type = key->type,
+                .reserved = 0,
+                .name_offset = name_offsets[i],
+            };
+            written = subghz_keystore_binary_write(&writer, &record, sizeof(record));
+        }
+
+        uint32_t names_offset = 0;
+        for(size_t i = 0; i < key_count && written; i++) {
+            if(name_offsets[i] != names_offset) continue;
+            const char* name = SubGhzKeyArray_cget(instance->data, i)->name;
+            size_t size = strlen(name) + 1;
+            written = subghz_keystore_binary_write(&writer, name, size);
+            names_offset += size;
+        }
+        furi_assert(!written || names_offset == names_used);
+
+        const uint8_t padding[16] = {0};
+        if(written) {
+            written = subghz_keystore_binary_write(&writer, padding, names_size - names_used);
+        }
+        if(written && writer.size > 0) {
+            written = subghz_keystore_binary_flush(&writer);
+        }
+
+        result = written;
+        if(result) {
+            FURI_LOG_I(TAG, "Success. Saved %lu keys", key_count);
+        } else {
+            FURI_LOG_E(TAG, "Failed to write keys");
+        }
+    } while(0);
+
+    if(key_loaded) furi_hal_crypto_store_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+    free(writer.buffer);
+    free(name_offsets);
+
+    return result;
+}
+
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
     furi_assert(instance);
     return &instance->data;
 }
 
+static void subghz_keystore_build_batch_data(SubGhzKeystore* instance) {
+    uint64_t keys[KEELOQ_BATCH_LANES];
+    size_t total_keys = SubGhzKeyArray_size(instance->data);
+
+    SubGhzKeyBatchArray_reset(instance->batch_data);
+    for(size_t first = 0; first < total_keys; first += KEELOQ_BATCH_LANES) {
+        SubGhzKeyBatch* batch = SubGhzKeyBatchArray_push_raw(instance->batch_data);
+        memset(batch, 0, sizeof(SubGhzKeyBatch));
+        batch->first = first;
+        batch->count = MIN(total_keys - first, (size_t)KEELOQ_BATCH_LANES);
+
+        for(uint8_t lane = 0; lane < batch->count; lane++) {
+            const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(instance->data, first + lane);
+            keys[lane] = manufacture_code->key;
+            if(manufacture_code->type < SUBGHZ_KEYSTORE_BATCH_TYPE_COUNT) {
+                batch->type[manufacture_code->type] |= 1UL << lane;
+            }
+        }
+        subghz_protocol_keeloq_batch_load_keys(batch->key, keys, batch->count);
+    }
+    instance->batch_key_count = total_keys;
+}
+
+SubGhzKeyBatchArray_t* subghz_keystore_get_batch_data(SubGhzKeystore* instance) {
+    furi_assert(instance);
+    if(instance->batch_key_count != SubGhzKeyArray_size(instance->data)) {
+        subghz_keystore_build_batch_data(instance);
+    }
+    return &instance->batch_data;
+}
+
 bool subghz_keystore_raw_encrypted_save(
     const char* input_file_name,
     const char* output_file_name,
@@ -475,29 +854,52 @@ bool subghz_keystore_raw_encrypted_save(
     return encrypted;
 }
 
-bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t* data, size_t len) {
-    bool result = false;
+typedef struct {
+    uint32_t index;
+    uint32_t last_use;
+    uint8_t data[16];
+} SubGhzKeystoreRawBlock;
+
+struct SubGhzKeystoreRaw {
+    Storage* storage;
+    FlipperFormat* flipper_format;
+    Stream* stream;
+    FuriMutex* mutex;
+    size_t data_start;
+    size_t block_count;
     uint8_t iv[16];
+    uint32_t use_counter;
+    size_t cached;
+    SubGhzKeystoreRawBlock cache[SUBGHZ_KEYSTORE_RAW_CACHE_SIZE];
+};
+
+static SubGhzKeystoreRawStats subghz_keystore_raw_stats = {0};
+
+SubGhzKeystoreRaw* subghz_keystore_raw_open(const char* file_name) {
+    furi_assert(file_name);
+    SubGhzKeystoreRaw* instance = malloc(sizeof(SubGhzKeystoreRaw));
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->flipper_format = flipper_format_file_alloc(instance->storage);
+    instance->stream = flipper_format_get_raw_stream(instance->flipper_format);
+
     uint32_t version;
     SubGhzKeystoreEncryption encryption;
-
     string_t str_temp;
     string_init(str_temp);
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    char* decrypted_line = malloc(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
-
-    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    bool result = false;
     do {
-        if(!flipper_format_file_open_existing(flipper_format, file_name)) {
+        subghz_keystore_raw_stats.file_opens++;
+        if(!flipper_format_file_open_existing(instance->flipper_format, file_name)) {
             FURI_LOG_E(TAG, "Unable to open file for read: %s", file_name);
             break;
         }
-        if(!flipper_format_read_header(flipper_format, str_temp, &version)) {
+        if(!flipper_format_read_header(instance->flipper_format, str_temp, &version)) {
             FURI_LOG_E(TAG, "Missing or incorrect header");
             break;
         }
-        if(!flipper_format_read_uint32(flipper_format, "Encryption", (uint32_t*)&encryption, 1)) {
+        if(!flipper_format_read_uint32(
+               instance->flipper_format, "Encryption", (uint32_t*)&encryption, 1)) {
             FURI_LOG_E(TAG, "Missing encryption type");
             break;
         }
@@ -508,97 +910,206 @@ bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t*
             break;
         }
 
-        Stream* stream = flipper_format_get_raw_stream(flipper_format);
         if(encryption != SubGhzKeystoreEncryptionAES256) {
             FURI_LOG_E(TAG, "Unknown encryption");
             break;
         }
 
-        if(offset < 16) {
-            if(!flipper_format_read_hex(flipper_format, "IV", iv, 16)) {
-                FURI_LOG_E(TAG, "Missing IV");
-                break;
-            }
-            subghz_keystore_mess_with_iv(iv);
+        if(!flipper_format_read_hex(instance->flipper_format, "IV", instance->iv, 16)) {
+            FURI_LOG_E(TAG, "Missing IV");
+            break;
         }
+        subghz_keystore_mess_with_iv(instance->iv);
 
-        if(!flipper_format_read_string(flipper_format, "Encrypt_data", str_temp)) {
+        if(!flipper_format_read_string(instance->flipper_format, "Encrypt_data", str_temp)) {
             FURI_LOG_E(TAG, "Missing Encrypt_data");
             break;
         }
 
-        size_t bufer_size;
-        if(len <= (16 - offset % 16)) {
-            bufer_size = 32;
-        } else {
-            bufer_size = (((len) / 16) + 2) * 32;
+        //skip the end of the previous line "\n"
+        stream_seek(instance->stream, 1, StreamOffsetFromCurrent);
+        instance->data_start = stream_tell(instance->stream);
+        instance->block_count = (stream_size(instance->stream) - instance->data_start) / 32;
+        instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+        result = true;
+    } while(false);
+
+    string_clear(str_temp);
+
+    if(!result) {
+        flipper_format_free(instance->flipper_format);
+        furi_record_close(RECORD_STORAGE);
+        free(instance);
+        instance = NULL;
+    }
+
+    return instance;
+}
+
+void subghz_keystore_raw_close(SubGhzKeystoreRaw* instance) {
+    furi_assert(instance);
+    furi_mutex_free(instance->mutex);
+    flipper_format_free(instance->flipper_format);
+    furi_record_close(RECORD_STORAGE);
+    free(instance);
+}
+
+static SubGhzKeystoreRawBlock*
+    subghz_keystore_raw_cache_find(SubGhzKeystoreRaw* instance, uint32_t index) {
+    for(size_t i = 0; i < instance->cached; i++) {
+        if(instance->cache[i].index == index) {
+            instance->cache[i].last_use = ++instance->use_counter;
+            return &instance->cache[i];
+        }
+    }
+    return NULL;
+}
+
+static void subghz_keystore_raw_cache_put(
+    SubGhzKeystoreRaw* instance,
+    uint32_t index,
+    const uint8_t* data) {
+    // Already cached block is refreshed in place instead of taking another slot
+    SubGhzKeystoreRawBlock* block = subghz_keystore_raw_cache_find(instance, index);
+    if(!block && instance->cached < SUBGHZ_KEYSTORE_RAW_CACHE_SIZE) {
+        block = &instance->cache[instance->cached++];
+    } else if(!block) {
+        block = &instance->cache[0];
+        for(size_t i = 1; i < SUBGHZ_KEYSTORE_RAW_CACHE_SIZE; i++) {
+            if(instance->cache[i].last_use < block->last_use) {
+                block = &instance->cache[i];
+            }
         }
-        furi_assert(SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE >= bufer_size / 2);
+    }
+    block->index = index;
+    block->last_use = ++instance->use_counter;
+    memcpy(block->data, data, 16);
+}
 
-        uint8_t buffer[bufer_size];
-        size_t ret = 0;
-        bool decrypted = true;
-        //skip the end of the previous line "\n"
-        stream_read(stream, buffer, 1);
+/* Decrypts blocks [first, last] in one key load and puts them in the cache */
+static bool
+    subghz_keystore_raw_decrypt(SubGhzKeystoreRaw* instance, uint32_t first, uint32_t last) {
+    size_t count = last - first + 1;
+    // Previous block is the IV in CBC mode
+    size_t hex_size = (count + (first ? 1 : 0)) * 32;
+    uint8_t* buffer = malloc(hex_size);
+    uint8_t* decrypted = malloc(count * 16);
+    uint8_t iv[16];
+    bool result = false;
 
-        size_t size = stream_size(stream);
-        size -= stream_tell(stream);
-        if(size < (offset * 2 + len * 2)) {
-            FURI_LOG_E(TAG, "Seek position exceeds file size");
+    do {
+        size_t position = instance->data_start + (first ? (first - 1) * 32 : 0);
+        if(!stream_seek(instance->stream, position, StreamOffsetFromStart) ||
+           stream_read(instance->stream, buffer, hex_size) != hex_size) {
+            FURI_LOG_E(TAG, "Unable to read blocks");
             break;
         }
 
-        if(offset >= 16) {
-            stream_seek(stream, ((offset / 16) - 1) * 32, StreamOffsetFromCurrent);
-            ret = stream_read(stream, buffer, 32);
-            furi_assert(ret == 32);
-            for(uint16_t i = 0; i < ret - 1; i += 2) {
-                uint8_t hi_nibble = 0;
-                uint8_t lo_nibble = 0;
-                hex_char_to_hex_nibble(buffer[i], &hi_nibble);
-                hex_char_to_hex_nibble(buffer[i + 1], &lo_nibble);
-                iv[i / 2] = (hi_nibble << 4) | lo_nibble;
-            }
+        for(size_t i = 0; i < hex_size / 2; i++) {
+            uint8_t hi_nibble = 0;
+            uint8_t lo_nibble = 0;
+            hex_char_to_hex_nibble(buffer[i * 2], &hi_nibble);
+            hex_char_to_hex_nibble(buffer[i * 2 + 1], &lo_nibble);
+            buffer[i] = (hi_nibble << 4) | lo_nibble;
+        }
+
+        uint8_t* ciphertext = buffer;
+        if(first) {
+            memcpy(iv, buffer, 16);
+            ciphertext += 16;
+        } else {
+            memcpy(iv, instance->iv, 16);
         }
 
         if(!furi_hal_crypto_store_load_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, iv)) {
             FURI_LOG_E(TAG, "Unable to load encryption key");
             break;
         }
+        result = furi_hal_crypto_decrypt(ciphertext, decrypted, count * 16);
+        furi_hal_crypto_store_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+        if(!result) {
+            FURI_LOG_E(TAG, "Decryption failed");
+            break;
+        }
 
-        do {
-            memset(buffer, 0, bufer_size);
-            ret = stream_read(stream, buffer, bufer_size);
-            furi_assert(ret == bufer_size);
-            for(uint16_t i = 0; i < ret - 1; i += 2) {
-                uint8_t hi_nibble = 0;
-                uint8_t lo_nibble = 0;
-                hex_char_to_hex_nibble(buffer[i], &hi_nibble);
-                hex_char_to_hex_nibble(buffer[i + 1], &lo_nibble);
-                buffer[i / 2] = (hi_nibble << 4) | lo_nibble;
-            }
+        subghz_keystore_raw_stats.block_decrypts += count;
+        for(size_t i = 0; i < count; i++) {
+            subghz_keystore_raw_cache_put(instance, first + i, &decrypted[i * 16]);
+        }
+    } while(false);
 
-            memset(decrypted_line, 0, SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
+    free(buffer);
+    free(decrypted);
+    return result;
+}
 
-            if(!furi_hal_crypto_decrypt(
-                   (uint8_t*)buffer, (uint8_t*)decrypted_line, bufer_size / 2)) {
-                decrypted = false;
-                FURI_LOG_E(TAG, "Decryption failed");
-                break;
-            }
-            memcpy(data, (uint8_t*)decrypted_line + (offset - (offset / 16) * 16), len);
+bool subghz_keystore_raw_read(
+    SubGhzKeystoreRaw* instance,
+    size_t offset,
+    uint8_t* data,
+    size_t len) {
+    furi_assert(instance);
+    furi_assert(data);
+    if(!len) return true;
 
-        } while(0);
-        furi_hal_crypto_store_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
-        if(decrypted) result = true;
-    } while(0);
-    flipper_format_free(flipper_format);
+    uint32_t first = offset / 16;
+    uint32_t last = (offset + len - 1) / 16;
+    if(last >= instance->block_count) {
+        FURI_LOG_E(TAG, "Seek position exceeds file size");
+        return false;
+    }
+    furi_assert(last - first < SUBGHZ_KEYSTORE_RAW_CACHE_SIZE);
 
-    furi_record_close(RECORD_STORAGE);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    // Refresh cached blocks of this read, so decrypting the missing ones doesn't evict them
+    for(size_t i = 0; i < instance->cached; i++) {
+        if(instance->cache[i].index >= first && instance->cache[i].index <= last) {
+            instance->cache[i].last_use = ++instance->use_counter;
+        }
+    }
 
-    free(decrypted_line);
+    bool result = true;
+    for(uint32_t index = first; result && index <= last; index++) {
+        SubGhzKeystoreRawBlock* block = subghz_keystore_raw_cache_find(instance, index);
+        if(block) {
+            subghz_keystore_raw_stats.cache_hits++;
+        } else {
+            // Missing run is decrypted together, its IV chain is in the file anyway
+            uint32_t run_last = index;
+            while(run_last < last && !subghz_keystore_raw_cache_find(instance, run_last + 1)) {
+                run_last++;
+            }
+            result = subghz_keystore_raw_decrypt(instance, index, run_last);
+            block = subghz_keystore_raw_cache_find(instance, index);
+        }
+        if(result) {
+            size_t block_offset = (index == first) ? offset % 16 : 0;
+            size_t copy = MIN(16 - block_offset, len);
+            memcpy(data, &block->data[block_offset], copy);
+            data += copy;
+            len -= copy;
+        }
+    }
+    furi_check(furi_mutex_release(instance->mutex) == FuriStatusOk);
 
-    string_clear(str_temp);
+    return result;
+}
 
+bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t* data, size_t len) {
+    SubGhzKeystoreRaw* instance = subghz_keystore_raw_open(file_name);
+    if(!instance) {
+        return false;
+    }
+    bool result = subghz_keystore_raw_read(instance, offset, data, len);
+    subghz_keystore_raw_close(instance);
     return result;
 }
+
+void subghz_keystore_raw_get_stats(SubGhzKeystoreRawStats* stats) {
+    furi_assert(stats);
+    *stats = subghz_keystore_raw_stats;
+}
+
+void subghz_keystore_raw_reset_stats() {
+    memset(&subghz_keystore_raw_stats, 0, sizeof(subghz_keystore_raw_stats));
+}
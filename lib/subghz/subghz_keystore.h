@@ -4,8 +4,10 @@
 #include <m-array.h>
 #include <stdint.h>
 
+#include "protocols/keeloq_batch.h"
+
 typedef struct {
-    string_t name;
+    const char* name; // owned by SubGhzKeystore
     uint64_t key;
     uint16_t type;
 } SubGhzKey;
@@ -14,8 +16,29 @@ ARRAY_DEF(SubGhzKeyArray, SubGhzKey, M_POD_OPLIST)
 
 #define M_OPL_SubGhzKeyArray_t() ARRAY_OPLIST(SubGhzKeyArray, M_POD_OPLIST)
 
+#define SUBGHZ_KEYSTORE_BATCH_TYPE_COUNT 8
+
+typedef struct {
+    uint32_t key[KEELOQ_BATCH_SCHEDULE_SIZE]; // bitsliced key schedule
+    uint32_t type[SUBGHZ_KEYSTORE_BATCH_TYPE_COUNT]; // lanes by key type
+    size_t first; // index of the lane 0 key in SubGhzKeyArray
+    uint8_t count;
+} SubGhzKeyBatch;
+
+ARRAY_DEF(SubGhzKeyBatchArray, SubGhzKeyBatch, M_POD_OPLIST)
+
+#define M_OPL_SubGhzKeyBatchArray_t() ARRAY_OPLIST(SubGhzKeyBatchArray, M_POD_OPLIST)
+
 typedef struct SubGhzKeystore SubGhzKeystore;
 
+typedef struct SubGhzKeystoreRaw SubGhzKeystoreRaw;
+
+typedef struct {
+    uint32_t file_opens;
+    uint32_t block_decrypts; // 16-byte AES blocks
+    uint32_t cache_hits;
+} SubGhzKeystoreRawStats;
+
 /**
  * Allocate SubGhzKeystore.
  * @return SubGhzKeystore* pointer to a SubGhzKeystore instance
@@ -29,7 +52,7 @@ SubGhzKeystore* subghz_keystore_alloc();
 void subghz_keystore_free(SubGhzKeystore* instance);
 
 /** 
- * Loading manufacture key from file
+ * Loading manufacture key from file, text or binary keystore
  * @param instance Pointer to a SubGhzKeystore instance
  * @param filename Full path to the file
  */
@@ -43,6 +66,16 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* filename);
  */
 bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_t* iv);
 
+/** 
+ * Save manufacture key to binary keystore file: fixed size key records followed
+ * by name table, loaded with a few large reads
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param filename Full path to the file
+ * @param iv IV, 16 bytes, or NULL to save unencrypted
+ * @return true On success
+ */
+bool subghz_keystore_save_binary(SubGhzKeystore* instance, const char* filename, uint8_t* iv);
+
 /** 
  * Get array of keys and names manufacture
  * @param instance Pointer to a SubGhzKeystore instance
@@ -50,6 +83,14 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_
  */
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance);
 
+/** 
+ * Get keys packed by KEELOQ_BATCH_LANES in bitsliced form, built on first use and
+ * rebuilt when the key array changes
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @return SubGhzKeyBatchArray_t*
+ */
+SubGhzKeyBatchArray_t* subghz_keystore_get_batch_data(SubGhzKeystore* instance);
+
 /** 
  * Save RAW encrypted to file
  * @param input_file_name Full path to the input file
@@ -70,3 +111,42 @@ bool subghz_keystore_raw_encrypted_save(
  * @return true On success
  */
 bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t* data, size_t len);
+
+/** 
+ * Open encrypted RAW file and keep it open with the header parsed.
+ * Decrypted blocks are kept in a small LRU cache.
+ * @param file_name Full path to the input file
+ * @return SubGhzKeystoreRaw* handle or NULL on error
+ */
+SubGhzKeystoreRaw* subghz_keystore_raw_open(const char* file_name);
+
+/** 
+ * Close encrypted RAW file
+ * @param instance Pointer to a SubGhzKeystoreRaw instance
+ */
+void subghz_keystore_raw_close(SubGhzKeystoreRaw* instance);
+
+/** 
+ * Get decrypted RAW data
+ * @param instance Pointer to a SubGhzKeystoreRaw instance
+ * @param offset Offset from the start of the RAW data
+ * @param data Returned array
+ * @param len Required data length
+ * @return true On success
+ */
+bool subghz_keystore_raw_read(
+    SubGhzKeystoreRaw* instance,
+    size_t offset,
+    uint8_t* data,
+    size_t len);
+
+/** 
+ * Get RAW data access counters, for all handles together
+ * @param stats Returned counters
+ */
+void subghz_keystore_raw_get_stats(SubGhzKeystoreRawStats* stats);
+
+/** 
+ * Reset RAW data access counters
+ */
+void subghz_keystore_raw_reset_stats();
@@ -0,0 +1,241 @@
+#include "subghz_raw_packed.h"
+#include "subghz_file_encoder_worker.h"
+#include "types.h"
+
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+
+#define TAG "SubGhzRawPacked"
+
+#define SUBGHZ_RAW_PACKED_MAGIC 0xA5
+#define SUBGHZ_RAW_PACKED_VARINT_MAX_SIZE 5
+#define SUBGHZ_RAW_PACKED_CONVERT_SIZE 512
+
+typedef struct {
+    uint8_t magic;
+    uint8_t level;
+    uint16_t count;
+    uint16_t size;
+} __attribute__((packed)) SubGhzRawPackedBlockHeader;
+
+#define SUBGHZ_RAW_PACKED_PAYLOAD_MAX_SIZE \
+    (SUBGHZ_RAW_PACKED_BLOCK_MAX_SIZE - sizeof(SubGhzRawPackedBlockHeader))
+
+typedef struct {
+    FlipperFormat* flipper_format;
+    int32_t* data;
+    size_t count;
+    bool pack;
+    bool error;
+} SubGhzRawPackedConvert;
+
+bool subghz_raw_packed_check_line(const char* line) {
+    furi_assert(line);
+    size_t key_size = strlen(SUBGHZ_RAW_PACKED_KEY);
+    if(strncmp(line, SUBGHZ_RAW_PACKED_KEY, key_size) != 0 || line[key_size] != ':') {
+        return false;
+    }
+    return atoi(&line[key_size + 1]) == SUBGHZ_RAW_PACKED_VERSION;
+}
+
+bool subghz_raw_packed_write(Stream* stream, const int32_t* data, size_t count) {
+    furi_assert(stream);
+    furi_assert(data);
+
+    uint8_t block[SUBGHZ_RAW_PACKED_BLOCK_MAX_SIZE];
+    SubGhzRawPackedBlockHeader* header = (SubGhzRawPackedBlockHeader*)block;
+    uint8_t* payload = block + sizeof(SubGhzRawPackedBlockHeader);
+
+    size_t ind = 0;
+    while(ind < count) {
+        int32_t last[2] = {0, 0};
+        bool level = data[ind] > 0;
+        header->magic = SUBGHZ_RAW_PACKED_MAGIC;
+        header->level = level;
+        header->count = 0;
+
+        uint8_t* p = payload;
+        while(ind < count &&
+              (size_t)(p - payload) + SUBGHZ_RAW_PACKED_VARINT_MAX_SIZE <=
+                  SUBGHZ_RAW_PACKED_PAYLOAD_MAX_SIZE) {
+            // Same level twice in a row can't be expressed inside a block
+            if((data[ind] > 0) != level) break;
+            int32_t duration = level ? data[ind] : -data[ind];
+            int32_t delta = duration - last[level];
+            last[level] = duration;
+
+            uint32_t value = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+            while(value >= 0x80) {
+                *p++ = (value & 0x7F) | 0x80;
+                value >>= 7;
+            }
+            *p++ = value;
+
+            header->count++;
+            level = !level;
+            ind++;
+        }
+
+        header->size = p - payload;
+        size_t block_size = sizeof(SubGhzRawPackedBlockHeader) + header->size;
+        if(stream_write(stream, block, block_size) != block_size) {
+            FURI_LOG_E(TAG, "Unable to write block");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool subghz_raw_packed_read(Stream* stream, SubGhzRawPackedCallback callback, void* context) {
+    furi_assert(stream);
+    furi_assert(callback);
+
+    SubGhzRawPackedBlockHeader header;
+    uint8_t payload[SUBGHZ_RAW_PACKED_PAYLOAD_MAX_SIZE];
+
+    if(stream_read(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) return false;
+    if(header.magic != SUBGHZ_RAW_PACKED_MAGIC || header.size > sizeof(payload)) {
+        FURI_LOG_E(TAG, "Broken block");
+        return false;
+    }
+    if(stream_read(stream, payload, header.size) != header.size) return false;
+
+    int32_t last[2] = {0, 0};
+    bool level = header.level;
+    const uint8_t* p = payload;
+    const uint8_t* end = payload + header.size;
+    for(uint16_t i = 0; i < header.count; i++) {
+        uint32_t value = 0;
+        uint8_t shift = 0;
+        uint8_t byte;
+        do {
+            if(p == end || shift >= 7 * SUBGHZ_RAW_PACKED_VARINT_MAX_SIZE) {
+                FURI_LOG_E(TAG, "Broken block");
+                return false;
+            }
+            byte = *p++;
+            value |= (uint32_t)(byte & 0x7F) << shift;
+            shift += 7;
+        } while(byte & 0x80);
+
+        last[level] += (int32_t)((value >> 1) ^ (0 - (value & 1)));
+        callback(level ? last[level] : -last[level], context);
+        level = !level;
+    }
+    return true;
+}
+
+static bool subghz_raw_packed_convert_flush(SubGhzRawPackedConvert* instance) {
+    if(instance->count) {
+        if(instance->pack) {
+            instance->error |= !subghz_raw_packed_write(
+                flipper_format_get_raw_stream(instance->flipper_format),
+                instance->data,
+                instance->count);
+        } else {
+            instance->error |= !flipper_format_write_int32(
+                instance->flipper_format, "RAW_Data", instance->data, instance->count);
+        }
+        instance->count = 0;
+    }
+    return !instance->error;
+}
+
+static void subghz_raw_packed_convert_callback(int32_t duration, void* context) {
+    SubGhzRawPackedConvert* instance = context;
+    instance->data[instance->count++] = duration;
+    if(instance->count == SUBGHZ_RAW_PACKED_CONVERT_SIZE) {
+        subghz_raw_packed_convert_flush(instance);
+    }
+}
+
+bool subghz_raw_packed_convert(Storage* storage, const char* src_path, const char* dst_path) {
+    furi_assert(storage);
+    furi_assert(src_path);
+    furi_assert(dst_path);
+
+    FlipperFormat* src = flipper_format_file_alloc(storage);
+    SubGhzRawPackedConvert* instance = malloc(sizeof(SubGhzRawPackedConvert));
+    instance->flipper_format = flipper_format_file_alloc(storage);
+    instance->data = malloc(SUBGHZ_RAW_PACKED_CONVERT_SIZE * sizeof(int32_t));
+
+    string_t temp_str;
+    string_init(temp_str);
+    uint32_t temp_data32;
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(src, src_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for read: %s", src_path);
+            break;
+        }
+        if(!flipper_format_read_header(src, temp_str, &temp_data32)) {
+            FURI_LOG_E(TAG, "Missing or incorrect header");
+            break;
+        }
+        if(strcmp(string_get_cstr(temp_str), SUBGHZ_RAW_FILE_TYPE) != 0 ||
+           temp_data32 != SUBGHZ_KEY_FILE_VERSION) {
+            FURI_LOG_E(TAG, "Type or version mismatch");
+            break;
+        }
+        if(!flipper_format_read_string(src, "Protocol", temp_str)) {
+            FURI_LOG_E(TAG, "Missing Protocol");
+            break;
+        }
+
+        Stream* src_stream = flipper_format_get_raw_stream(src);
+        //skip the end of the previous line "\n"
+        stream_seek(src_stream, 1, StreamOffsetFromCurrent);
+        size_t data_start = stream_tell(src_stream);
+
+        if(!flipper_format_file_open_always(instance->flipper_format, dst_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for write: %s", dst_path);
+            break;
+        }
+        // Metadata is copied as is
+        Stream* dst_stream = flipper_format_get_raw_stream(instance->flipper_format);
+        stream_rewind(src_stream);
+        if(stream_copy(src_stream, dst_stream, data_start) != data_start) {
+            FURI_LOG_E(TAG, "Unable to copy metadata");
+            break;
+        }
+
+        if(!stream_read_line(src_stream, temp_str)) break;
+        string_strim(temp_str);
+        instance->pack = !subghz_raw_packed_check_line(string_get_cstr(temp_str));
+
+        if(instance->pack) {
+            uint32_t version = SUBGHZ_RAW_PACKED_VERSION;
+            if(!flipper_format_write_uint32(
+                   instance->flipper_format, SUBGHZ_RAW_PACKED_KEY, &version, 1)) {
+                FURI_LOG_E(TAG, "Unable to add " SUBGHZ_RAW_PACKED_KEY);
+                break;
+            }
+            do {
+                subghz_file_encoder_worker_parse_line(
+                    string_get_cstr(temp_str), subghz_raw_packed_convert_callback, instance);
+                if(!subghz_raw_packed_convert_flush(instance)) break;
+                if(!stream_read_line(src_stream, temp_str)) break;
+                string_strim(temp_str);
+            } while(true);
+        } else {
+            while(subghz_raw_packed_read(src_stream, subghz_raw_packed_convert_callback, instance)) {
+                if(instance->count + SUBGHZ_RAW_PACKED_BLOCK_MAX_SIZE >
+                   SUBGHZ_RAW_PACKED_CONVERT_SIZE) {
+                    if(!subghz_raw_packed_convert_flush(instance)) break;
+                }
+            }
+            subghz_raw_packed_convert_flush(instance);
+        }
+
+        result = !instance->error;
+    } while(false);
+
+    string_clear(temp_str);
+    flipper_format_free(src);
+    flipper_format_free(instance->flipper_format);
+    free(instance->data);
+    free(instance);
+
+    return result;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <furi.h>
+#include <toolbox/stream/stream.h>
+#include <storage/storage.h>
+
+/*
+ * Packed RAW data
+ * The text part of the file (header, Frequency, Preset, Protocol) is left as is,
+ * instead of "RAW_Data:" lines it holds a "RAW_Packed: <version>" line followed by binary blocks.
+ * Block: SubGhzRawPackedBlockHeader + payload. Levels alternate inside a block starting
+ * from the header level, every duration is a zigzag varint of the difference with
+ * the previous duration of the same level in this block.
+ */
+#define SUBGHZ_RAW_PACKED_KEY "RAW_Packed"
+#define SUBGHZ_RAW_PACKED_VERSION 1
+#define SUBGHZ_RAW_PACKED_BLOCK_MAX_SIZE 256
+
+typedef void (*SubGhzRawPackedCallback)(int32_t duration, void* context);
+
+/**
+ * Check that the line starts packed data of supported version.
+ * @param line Line sample: "RAW_Packed: 1"
+ * @return true if the rest of the file is packed
+ */
+bool subghz_raw_packed_check_line(const char* line);
+
+/**
+ * Pack signed durations and write them as one or more blocks.
+ * @param stream Pointer to a Stream instance, position after "RAW_Packed" line or previous block
+ * @param data Signed durations, positive is high level
+ * @param count Number of durations
+ * @return true On success
+ */
+bool subghz_raw_packed_write(Stream* stream, const int32_t* data, size_t count);
+
+/**
+ * Read one block and unpack it.
+ * @param stream Pointer to a Stream instance, position at the block
+ * @param callback Called for each signed duration, positive is high level
+ * @param context Context for callback
+ * @return false on end of file or broken block
+ */
+bool subghz_raw_packed_read(Stream* stream, SubGhzRawPackedCallback callback, void* context);
+
+/**
+ * Convert RAW file between text and packed data, direction depends on the source file.
+ * @param storage Pointer to a Storage instance
+ * @param src_path Source RAW file
+ * @param dst_path Destination RAW file, overwritten
+ * @return true On success
+ */
+bool subghz_raw_packed_convert(Storage* storage, const char* src_path, const char* dst_path);
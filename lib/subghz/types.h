@@ -8,6 +8,7 @@
 #include <lib/toolbox/level_duration.h>
 
 #include "environment.h"
+#include "blocks/const.h"
 #include <furi.h>
 #include <furi_hal.h>
 #include <subghz/helpers/subghz_types.h>
@@ -47,6 +48,31 @@ typedef void (*SubGhzGetString)(void* decoder, string_t output);
 typedef void (*SubGhzEncoderStop)(void* encoder);
 typedef LevelDuration (*SubGhzEncoderYield)(void* context);
 
+typedef enum {
+    SubGhzProtocolDecoderTeShort,
+    SubGhzProtocolDecoderTeLong,
+} SubGhzProtocolDecoderTe;
+
+/** Pulse matched as DURATION_DIFF(duration, te * te_count) < te_delta * delta_count */
+typedef struct {
+    bool level;
+    SubGhzProtocolDecoderTe te;
+    uint8_t te_count;
+    uint8_t delta_count;
+} SubGhzProtocolDecoderPulse;
+
+/** 
+ * Decoder timing, lets SubGhzReceiver skip the decoder while its parser_step is 0
+ * and the pulse can't match any of the start pulses, decoders must ignore such pulses.
+ * Decoders that don't track parser_step or reset on unmatched pulses must not set it.
+ */
+typedef struct {
+    const SubGhzBlockConst* block_const;
+    const SubGhzProtocolDecoderPulse* start;
+    size_t start_count;
+    size_t parser_step_offset;
+} SubGhzProtocolDecoderTiming;
+
 typedef struct {
     SubGhzAlloc alloc;
     SubGhzFree free;
@@ -58,6 +84,8 @@ typedef struct {
     SubGhzGetString get_string;
     SubGhzSerialize serialize;
     SubGhzDeserialize deserialize;
+
+    const SubGhzProtocolDecoderTiming* timing;
 } SubGhzProtocolDecoder;
 
 typedef struct {
@@ -1,14 +1,54 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <storage/storage.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** CRC32 calculation state */
+typedef struct {
+    uint32_t crc;
+    bool hardware;
+} Crc32Calc;
+
+/** Calculate CRC32 of a buffer in software, safe to use before kernel start
+ *
+ * @param crc       previous result to continue from, 0 to start over
+ * @param buffer    data
+ * @param size      data size
+ *
+ * @return CRC32
+ */
 uint32_t crc32_calc_buffer(uint32_t crc, const void* buffer, size_t size);
 
+/** Start streaming CRC32 calculation
+ *
+ * @param calc      Crc32Calc instance
+ * @param crc       previous result to continue from, 0 to start over
+ * @param hardware  use MCU CRC unit if it is not busy, software otherwise.
+ *                  The unit is held until crc32_calc_finish().
+ */
+void crc32_calc_start(Crc32Calc* calc, uint32_t crc, bool hardware);
+
+/** Feed data into streaming CRC32 calculation
+ *
+ * @param calc      Crc32Calc instance
+ * @param buffer    data
+ * @param size      data size
+ */
+void crc32_calc_feed(Crc32Calc* calc, const void* buffer, size_t size);
+
+/** Finish streaming CRC32 calculation
+ *
+ * @param calc      Crc32Calc instance
+ *
+ * @return CRC32
+ */
+uint32_t crc32_calc_finish(Crc32Calc* calc);
+
 typedef void (*FileCrcProgressCb)(const uint8_t progress, void* context);
 
 uint32_t crc32_calc_file(File* file, const FileCrcProgressCb progress_cb, void* context);
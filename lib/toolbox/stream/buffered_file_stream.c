@@ -26,6 +26,7 @@ static bool buffered_file_stream_delete_and_insert(
     size_t delete_size,
     StreamWriteCB write_callback,
     const void* ctx);
+static size_t buffered_file_stream_peek(BufferedFileStream* stream, const uint8_t** data);
 
 static bool buffered_file_stream_flush(BufferedFileStream* stream);
 static bool buffered_file_stream_unread(BufferedFileStream* stream);
@@ -40,6 +41,7 @@ const StreamVTable buffered_file_stream_vtable = {
     .write = (StreamWriteFn)buffered_file_stream_write,
     .read = (StreamReadFn)buffered_file_stream_read,
     .delete_and_insert = (StreamDeleteAndInsertFn)buffered_file_stream_delete_and_insert,
+    .peek = (StreamPeekFn)buffered_file_stream_peek,
 };
 
 Stream* buffered_file_stream_alloc(Storage* storage) {
@@ -221,6 +223,16 @@ static bool buffered_file_stream_delete_and_insert(
     return success;
 }
 
+static size_t buffered_file_stream_peek(BufferedFileStream* stream, const uint8_t** data) {
+    if(stream_cache_at_end(stream->cache)) {
+        if(stream->sync_pending) {
+            if(!buffered_file_stream_flush(stream)) return 0;
+        }
+        stream_cache_fill(stream->cache, stream->file_stream);
+    }
+    return stream_cache_peek(stream->cache, data);
+}
+
 // Write the cache into the underlying stream and adjust seek position
 static bool buffered_file_stream_flush(BufferedFileStream* stream) {
     bool success = false;
@@ -1,6 +1,9 @@
 #include "stream.h"
 #include "stream_i.h"
 #include "file_stream.h"
+#include "string_stream.h"
+
+#define FILE_STREAM_SHIFT_BLOCK_SIZE 512
 
 typedef struct {
     Stream stream_base;
@@ -161,11 +164,97 @@ static size_t file_stream_read(FileStream* stream, uint8_t* data, size_t size) {
     return size - need_to_read;
 }
 
-static bool file_stream_delete_and_insert(
+/**
+ * Shift the file tail from tail_start to new_tail_start in place, block by block.
+ * Blocks are moved starting from the far end of the tail,
+ * so data is never overwritten before it is read.
+ * @param stream
+ * @param tail_start
+ * @param new_tail_start
+ * @param touched set to true once the file has been modified
+ * @return true on success
+ */
+static bool file_stream_shift_tail(
+    FileStream* stream,
+    size_t tail_start,
+    size_t new_tail_start,
+    bool* touched) {
+    const size_t file_size = file_stream_size(stream);
+    const size_t tail_size = file_size - tail_start;
+    const bool forward = new_tail_start > tail_start;
+    uint8_t* buffer = malloc(FILE_STREAM_SHIFT_BLOCK_SIZE);
+    bool result = true;
+
+    size_t moved = 0;
+    while(moved < tail_size) {
+        const size_t block_size = MIN(tail_size - moved, FILE_STREAM_SHIFT_BLOCK_SIZE);
+        // forward shift goes from the end of the tail, backward shift from its start
+        const size_t offset = forward ? (tail_size - moved - block_size) : moved;
+
+        result = false;
+        if(!storage_file_seek(stream->file, tail_start + offset, true)) break;
+        if(file_stream_read(stream, buffer, block_size) != block_size) break;
+        if(!storage_file_seek(stream->file, new_tail_start + offset, true)) break;
+        *touched = true;
+        if(file_stream_write(stream, buffer, block_size) != block_size) break;
+        result = true;
+
+        moved += block_size;
+    }
+
+    free(buffer);
+    return result;
+}
+
+static bool file_stream_delete_and_insert_in_place(
+    FileStream* stream,
+    size_t delete_size,
+    Stream* insert_stream,
+    bool* touched) {
+    bool result = false;
+
+    do {
+        size_t current_position = file_stream_tell(stream);
+        size_t file_size = file_stream_size(stream);
+        size_t insert_size = stream_size(insert_stream);
+
+        size_t size_to_delete = file_size - current_position;
+        size_to_delete = MIN(delete_size, size_to_delete);
+
+        size_t tail_start = current_position + size_to_delete;
+        size_t new_tail_start = current_position + insert_size;
+
+        // move only the data after the deleted part
+        if(new_tail_start != tail_start) {
+            if(!file_stream_shift_tail(stream, tail_start, new_tail_start, touched)) break;
+        }
+
+        // write inserted data into the gap
+        if(!storage_file_seek(stream->file, current_position, true)) break;
+        *touched = true;
+        if(!stream_rewind(insert_stream)) break;
+        if(stream_copy(insert_stream, (Stream*)stream, insert_size) != insert_size) break;
+
+        // cut off the leftover of the old tail
+        if(new_tail_start < tail_start) {
+            if(!storage_file_seek(stream->file, file_size - (tail_start - new_tail_start), true))
+                break;
+            if(!storage_file_truncate(stream->file)) break;
+        }
+
+        // move seek pointer at insert end
+        if(!storage_file_seek(stream->file, new_tail_start, true)) break;
+
+        result = true;
+    } while(false);
+
+    return result;
+}
+
+static bool file_stream_delete_and_insert_scratchpad(
     FileStream* _stream,
     size_t delete_size,
-    StreamWriteCB write_callback,
-    const void* ctx) {
+    Stream* insert_stream) {
     bool result = false;
     Stream* stream = (Stream*)_stream;
 
@@ -199,9 +288,9 @@ static bool file_stream_delete_and_insert(
         if(!stream_rewind(stream)) break;
         if(stream_copy(stream, scratch_stream, size_to_copy_before) != size_to_copy_before) break;
 
-        if(write_callback) {
-            if(!write_callback(scratch_stream, ctx)) break;
-        }
+        size_t insert_size = stream_size(insert_stream);
+        if(!stream_rewind(insert_stream)) break;
+        if(stream_copy(insert_stream, scratch_stream, insert_size) != insert_size) break;
         size_t new_position = stream_tell(scratch_stream);
 
         // copy key file after insert position + size_to_delete to scratchpad
@@ -230,3 +319,35 @@ static bool file_stream_delete_and_insert(
 
     return result;
 }
+
+static bool file_stream_delete_and_insert(
+    FileStream* stream,
+    size_t delete_size,
+    StreamWriteCB write_callback,
+    const void* ctx) {
+    bool result = false;
+
+    // inserted data is usually a single line, render it first to know how far to shift the tail
+    Stream* insert_stream = string_stream_alloc();
+
+    do {
+        if(write_callback) {
+            if(!write_callback(insert_stream, ctx)) break;
+        }
+
+        size_t position = file_stream_tell(stream);
+        bool touched = false;
+        result =
+            file_stream_delete_and_insert_in_place(stream, delete_size, insert_stream, &touched);
+
+        // file is left intact if in-place update failed before the first write, retry the slow way
+        if(!result && !touched) {
+            if(!storage_file_seek(stream->file, position, true)) break;
+            result = file_stream_delete_and_insert_scratchpad(stream, delete_size, insert_stream);
+        }
+    } while(false);
+
+    stream_free(insert_stream);
+
+    return result;
+}
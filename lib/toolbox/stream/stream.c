@@ -53,6 +53,13 @@ bool stream_delete_and_insert(
     return stream->vtable->delete_and_insert(stream, delete_size, write_callback, ctx);
 }
 
+size_t stream_peek(Stream* stream, const uint8_t** data) {
+    furi_assert(stream);
+    furi_assert(data);
+    if(!stream->vtable->peek) return 0;
+    return stream->vtable->peek(stream, data);
+}
+
 /********************************** Some random helpers starts here **********************************/
 
 typedef struct {
@@ -67,38 +74,72 @@ static bool stream_write_struct(Stream* stream, const void* context) {
     return (stream_write(stream, write_data->data, write_data->size) == write_data->size);
 }
 
-bool stream_read_line(Stream* stream, string_t str_result) {
-    string_reset(str_result);
+bool stream_read_line_view(Stream* stream, string_t buffer, const char** line, size_t* size) {
+    furi_assert(stream);
+    furi_assert(line);
+    furi_assert(size);
+
+    const uint8_t* data;
+    size_t data_size = stream_peek(stream, &data);
+    if(data_size > 0) {
+        const uint8_t* eol = memchr(data, '\n', data_size);
+        if(eol) {
+            // Whole line is available in place
+            *line = (const char*)data;
+            *size = eol - data + 1;
+            return stream_seek(stream, *size, StreamOffsetFromCurrent);
+        }
+    }
+
+    // Line crosses the view boundary or the stream can't be peeked, copy it
+    string_reset(buffer);
     const uint8_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
+    uint8_t read_buffer[buffer_size];
 
+    bool result = true;
     do {
-        uint16_t bytes_were_read = stream_read(stream, buffer, buffer_size);
+        size_t bytes_were_read = stream_read(stream, read_buffer, buffer_size);
         if(bytes_were_read == 0) break;
 
-        bool result = false;
-        bool error = false;
-        for(uint16_t i = 0; i < bytes_were_read; i++) {
-            if(buffer[i] == '\n') {
-                if(!stream_seek(stream, i - bytes_were_read + 1, StreamOffsetFromCurrent)) {
-                    error = true;
-                    break;
-                }
-                string_push_back(str_result, buffer[i]);
-                result = true;
-                break;
-            } else if(buffer[i] == '\r') {
-                // Ignore
-            } else {
-                string_push_back(str_result, buffer[i]);
-            }
+        const uint8_t* eol = memchr(read_buffer, '\n', bytes_were_read);
+        size_t line_size = eol ? (size_t)(eol - read_buffer + 1) : bytes_were_read;
+        for(size_t i = 0; i < line_size; i++) {
+            string_push_back(buffer, read_buffer[i]);
         }
 
-        if(result || error) {
+        if(eol) {
+            result = stream_seek(
+                stream, (int32_t)line_size - (int32_t)bytes_were_read, StreamOffsetFromCurrent);
             break;
         }
     } while(true);
 
+    *line = string_get_cstr(buffer);
+    *size = string_size(buffer);
+    return result && *size != 0;
+}
+
+bool stream_read_line(Stream* stream, string_t str_result) {
+    string_reset(str_result);
+    const char* line;
+    size_t size;
+
+    if(stream_read_line_view(stream, str_result, &line, &size)) {
+        if(line == string_get_cstr(str_result)) {
+            // Line was copied to str_result, only drop CR
+            size_t index = 0;
+            while((index = string_search_char(str_result, '\r', index)) != STRING_FAILURE) {
+                string_replace_at(str_result, index, 1, "");
+            }
+        } else {
+            string_reset(str_result);
+            string_reserve(str_result, size);
+            for(size_t i = 0; i < size; i++) {
+                if(line[i] != '\r') string_push_back(str_result, line[i]);
+            }
+        }
+    }
+
     return string_size(str_result) != 0;
 }
 
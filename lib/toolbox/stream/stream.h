@@ -107,6 +107,31 @@ bool stream_delete_and_insert(
  */
 bool stream_read_line(Stream* stream, string_t str_result);
 
+/**
+ * Get a view of data from the current rw pointer without copying it.
+ * Does not move the rw pointer, use stream_seek to consume the data.
+ * The view is valid until the next stream call.
+ * @param stream Stream instance
+ * @param data pointer to the data
+ * @return size_t how many bytes are available,
+ * 0 on end of stream or if the stream doesn't support peeking
+ */
+size_t stream_peek(Stream* stream, const uint8_t** data);
+
+/**
+ * Read line from a stream without copying it if possible (supports LF and CRLF line endings).
+ * The line includes line ending characters, if any.
+ * If the line can't be viewed in place it is copied into the buffer.
+ * The line is valid until the next stream call or buffer modification.
+ * @param stream Stream instance
+ * @param buffer fallback storage for the line
+ * @param line pointer to the line, not null-terminated
+ * @param size line size
+ * @return true if line lenght is not zero
+ * @return false otherwise, or if the stream couldn't be positioned after the line
+ */
+bool stream_read_line_view(Stream* stream, string_t buffer, const char** line, size_t* size);
+
 /**
  * Moves the rw pointer to the start
  * @param stream Stream instance
@@ -8,6 +8,8 @@
 #define TAG "TarArch"
 #define MAX_NAME_LEN 255
 #define FILE_BLOCK_SIZE 512
+/* storage_file_write takes uint16_t size */
+#define FILE_BUFFER_SIZE_MAX (32 * 1024)
 
 #define FILE_OPEN_NTRIES 10
 #define FILE_OPEN_RETRY_DELAY 25
@@ -17,6 +19,7 @@ typedef struct TarArchive {
     mtar_t tar;
     tar_unpack_file_cb unpack_cb;
     void* unpack_cb_context;
+    size_t unpack_buffer_size;
 } TarArchive;
 
 /* API WRAPPER */
@@ -55,6 +58,7 @@ TarArchive* tar_archive_alloc(Storage* storage) {
     TarArchive* archive = malloc(sizeof(TarArchive));
     archive->storage = storage;
     archive->unpack_cb = NULL;
+    archive->unpack_buffer_size = TAR_ARCHIVE_UNPACK_BUFFER_SIZE;
     return archive;
 }
 
@@ -103,6 +107,12 @@ void tar_archive_set_file_callback(TarArchive* archive, tar_unpack_file_cb callb
     archive->unpack_cb_context = context;
 }
 
+void tar_archive_set_unpack_buffer_size(TarArchive* archive, size_t size) {
+    furi_assert(archive);
+    size = (size + FILE_BLOCK_SIZE - 1) / FILE_BLOCK_SIZE * FILE_BLOCK_SIZE;
+    archive->unpack_buffer_size = CLAMP(size, FILE_BUFFER_SIZE_MAX, FILE_BLOCK_SIZE);
+}
+
 static int tar_archive_entry_counter(mtar_t* tar, const mtar_header_t* header, void* param) {
     UNUSED(tar);
     UNUSED(header);
@@ -166,9 +176,59 @@ typedef struct {
     TarArchive* archive;
     const char* work_dir;
     Storage_name_converter converter;
+    uint8_t* buffer;
+    size_t buffer_size;
 } TarArchiveDirectoryOpParams;
 
+typedef struct {
+    TarArchive* archive;
+    const char* archive_fname;
+    const char* destination;
+    uint8_t* buffer;
+    size_t buffer_size;
+    bool found;
+} TarArchiveFileOpParams;
+
+static bool archive_extract_current_file(
+    TarArchive* archive,
+    const char* dst_path,
+    uint8_t* buffer,
+    size_t buffer_size) {
+    mtar_t* tar = &archive->tar;
+    File* out_file = storage_file_alloc(archive->storage);
+
+    bool failed = false;
+    uint8_t n_tries = FILE_OPEN_NTRIES;
+    do {
+        while(n_tries-- > 0) {
+            if(storage_file_open(out_file, dst_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+                break;
+            }
+            FURI_LOG_W(TAG, "Failed to open '%s', reties: %d", dst_path, n_tries);
+            storage_file_close(out_file);
+            furi_delay_ms(FILE_OPEN_RETRY_DELAY);
+        }
+
+        if(!storage_file_is_open(out_file)) {
+            failed = true;
+            break;
+        }
+
+        while(!mtar_eof_data(tar)) {
+            int32_t readcnt = mtar_read_data(tar, buffer, buffer_size);
+            if(!readcnt || !storage_file_write(out_file, buffer, readcnt)) {
+                failed = true;
+                break;
+            }
+        }
+    } while(false);
+
+    storage_file_free(out_file);
+    return !failed;
+}
+
 static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header, void* param) {
+    UNUSED(tar);
     TarArchiveDirectoryOpParams* op_params = param;
     TarArchive* archive = op_params->archive;
 
@@ -179,7 +239,7 @@ static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header,
     }
 
     if(skip_entry) {
-        FURI_LOG_W(TAG, "filter: skipping entry \"%s\"", header->name);
+        FURI_LOG_D(TAG, "filter: skipping entry \"%s\"", header->name);
         return 0;
     }
 
@@ -210,47 +270,14 @@ static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header,
     string_clear(converted_fname);
 
     FURI_LOG_I(TAG, "Extracting %d bytes to '%s'", header->size, header->name);
-    File* out_file = storage_file_alloc(archive->storage);
-    uint8_t* readbuf = malloc(FILE_BLOCK_SIZE);
-
-    bool failed = false;
-    uint8_t n_tries = FILE_OPEN_NTRIES;
-    do {
-        while(n_tries-- > 0) {
-            if(storage_file_open(
-                   out_file,
-                   string_get_cstr(full_extracted_fname),
-                   FSAM_WRITE,
-                   FSOM_CREATE_ALWAYS)) {
-                break;
-            }
-            FURI_LOG_W(
-                TAG,
-                "Failed to open '%s', reties: %d",
-                string_get_cstr(full_extracted_fname),
-                n_tries);
-            storage_file_close(out_file);
-            furi_delay_ms(FILE_OPEN_RETRY_DELAY);
-        }
+    bool success = archive_extract_current_file(
+        archive,
+        string_get_cstr(full_extracted_fname),
+        op_params->buffer,
+        op_params->buffer_size);
 
-        if(!storage_file_is_open(out_file)) {
-            failed = true;
-            break;
-        }
-
-        while(!mtar_eof_data(tar)) {
-            int32_t readcnt = mtar_read_data(tar, readbuf, FILE_BLOCK_SIZE);
-            if(!readcnt || !storage_file_write(out_file, readbuf, readcnt)) {
-                failed = true;
-                break;
-            }
-        }
-    } while(false);
-
-    storage_file_free(out_file);
-    free(readbuf);
     string_clear(full_extracted_fname);
-    return failed ? -1 : 0;
+    return success ? 0 : -1;
 }
 
 bool tar_archive_unpack_to(
@@ -262,13 +289,56 @@ bool tar_archive_unpack_to(
         .archive = archive,
         .work_dir = destination,
         .converter = converter,
+        .buffer = malloc(archive->unpack_buffer_size),
+        .buffer_size = archive->unpack_buffer_size,
     };
 
     FURI_LOG_I(TAG, "Restoring '%s'", destination);
 
-    return (mtar_foreach(&archive->tar, archive_extract_foreach_cb, &param) == MTAR_ESUCCESS);
+    bool success =
+        (mtar_foreach(&archive->tar, archive_extract_foreach_cb, &param) == MTAR_ESUCCESS);
+    free(param.buffer);
+    return success;
 };
 
+static int archive_extract_file_foreach_cb(mtar_t* tar, const mtar_header_t* header, void* param) {
+    UNUSED(tar);
+    TarArchiveFileOpParams* op_params = param;
+
+    if(op_params->found || header->type != MTAR_TREG ||
+       strcmp(header->name, op_params->archive_fname) != 0) {
+        return 0;
+    }
+
+    op_params->found = true;
+    FURI_LOG_I(TAG, "Extracting '%s' to '%s'", header->name, op_params->destination);
+    bool success = archive_extract_current_file(
+        op_params->archive, op_params->destination, op_params->buffer, op_params->buffer_size);
+    return success ? 0 : -1;
+}
+
+bool tar_archive_unpack_file(
+    TarArchive* archive,
+    const char* archive_fname,
+    const char* destination) {
+    furi_assert(archive);
+    furi_assert(archive_fname);
+    furi_assert(destination);
+    TarArchiveFileOpParams param = {
+        .archive = archive,
+        .archive_fname = archive_fname,
+        .destination = destination,
+        .buffer = malloc(archive->unpack_buffer_size),
+        .buffer_size = archive->unpack_buffer_size,
+        .found = false,
+    };
+
+    bool success =
+        (mtar_foreach(&archive->tar, archive_extract_file_foreach_cb, &param) == MTAR_ESUCCESS);
+    free(param.buffer);
+    return success && param.found;
+}
+
 bool tar_archive_add_file(
     TarArchive* archive,
     const char* fs_file_path,
@@ -9,6 +9,9 @@
 extern "C" {
 #endif
 
+/* Default size of the buffer used to copy entry data on unpacking */
+#define TAR_ARCHIVE_UNPACK_BUFFER_SIZE (4 * 1024)
+
 typedef struct TarArchive TarArchive;
 
 typedef struct Storage Storage;
@@ -31,6 +34,13 @@ bool tar_archive_unpack_to(
     const char* destination,
     Storage_name_converter converter);
 
+/* Extracts a single regular file entry to destination path.
+ * Entry callback is not called. Returns false if entry was not found */
+bool tar_archive_unpack_file(
+    TarArchive* archive,
+    const char* archive_fname,
+    const char* destination);
+
 bool tar_archive_add_file(
     TarArchive* archive,
     const char* fs_file_path,
@@ -46,6 +56,10 @@ typedef bool (*tar_unpack_file_cb)(const char* name, bool is_directory, void* co
 
 void tar_archive_set_file_callback(TarArchive* archive, tar_unpack_file_cb callback, void* context);
 
+/* Size of data buffer used on unpacking, rounded up to tar block size (512 bytes).
+ * Larger buffers mean fewer and better aligned SD card writes */
+void tar_archive_set_unpack_buffer_size(TarArchive* archive, size_t size);
+
 /* Low-level API */
 bool tar_archive_dir_add_element(TarArchive* archive, const char* dirpath);
 
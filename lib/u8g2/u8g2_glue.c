@@ -207,6 +207,24 @@ void u8x8_d_st756x_init(u8x8_t* u8x8, uint8_t contrast, uint8_t regulation_ratio
     u8x8_cad_EndTransfer(u8x8);
 }
 
+void u8x8_d_st756x_draw_columns(
+    u8x8_t* u8x8,
+    uint8_t page,
+    uint8_t column,
+    uint8_t count,
+    uint8_t* data) {
+    column += u8x8->x_offset;
+    furi_assert(page < u8x8->display_info->tile_height);
+    furi_assert(column + count <= 132u);
+
+    u8x8_cad_StartTransfer(u8x8);
+    u8x8_cad_SendCmd(u8x8, ST756X_CMD_SET_COLUMN_MSB | (column >> 4));
+    u8x8_cad_SendCmd(u8x8, ST756X_CMD_SET_COLUMN_LSB | (column & 15));
+    u8x8_cad_SendCmd(u8x8, ST756X_CMD_SET_PAGE | page);
+    u8x8_cad_SendData(u8x8, count, data);
+    u8x8_cad_EndTransfer(u8x8);
+}
+
 uint8_t u8x8_d_st756x_flipper(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
     /* call common procedure first and handle messages there */
     if(u8x8_d_st756x_common(u8x8, msg, arg_int, arg_ptr) == 0) {
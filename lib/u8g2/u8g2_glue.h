@@ -14,3 +14,18 @@ void u8g2_Setup_st756x_flipper(
     u8x8_msg_cb gpio_and_delay_cb);
 
 void u8x8_d_st756x_init(u8x8_t* u8x8, uint8_t contrast, uint8_t regulation_ratio, bool bias);
+
+/** Write columns of one display page, using controller page and column addressing
+ *
+ * @param      u8x8    u8x8 instance
+ * @param      page    page, 8 pixel rows band
+ * @param      column  first column
+ * @param      count   number of columns
+ * @param      data    column bytes, LSB is the top row of the page
+ */
+void u8x8_d_st756x_draw_columns(
+    u8x8_t* u8x8,
+    uint8_t page,
+    uint8_t column,
+    uint8_t count,
+    uint8_t* data);
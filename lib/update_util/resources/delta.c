@@ -0,0 +1,369 @@
+#include "delta.h"
+#include "manifest.h"
+
+#include <furi.h>
+#include <toolbox/path.h>
+
+#define TAG "ResourceDelta"
+
+#define RESOURCE_DELTA_BUFFER_SIZE (4 * 1024)
+#define RESOURCE_DELTA_TMP_PATCH "patch.tmp"
+#define RESOURCE_DELTA_TMP_SUFFIX ".tmp"
+
+#define RESOURCE_PATCH_OP_COPY 'C'
+#define RESOURCE_PATCH_OP_INSERT 'I'
+
+/* Combines small inserts into larger writes */
+typedef struct {
+    File* file;
+    uint8_t* data;
+    size_t used;
+} ResourcePatchWriter;
+
+static bool resource_patch_writer_flush(ResourcePatchWriter* writer) {
+    bool success = storage_file_write(writer->file, writer->data, writer->used) == writer->used;
+    writer->used = 0;
+    return success;
+}
+
+static bool
+    resource_patch_writer_push(ResourcePatchWriter* writer, const uint8_t* data, size_t size) {
+    while(size) {
+        size_t chunk = MIN(size, RESOURCE_DELTA_BUFFER_SIZE - writer->used);
+        memcpy(&writer->data[writer->used], data, chunk);
+        writer->used += chunk;
+        data += chunk;
+        size -= chunk;
+        if(writer->used == RESOURCE_DELTA_BUFFER_SIZE && !resource_patch_writer_flush(writer)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool resource_patch_read_u32(File* file, uint32_t* value) {
+    uint8_t data[4];
+    if(storage_file_read(file, data, sizeof(data)) != sizeof(data)) {
+        return false;
+    }
+    *value = data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+    return true;
+}
+
+/* Moves length bytes from file to writer */
+static bool resource_patch_transfer(
+    File* file,
+    ResourcePatchWriter* writer,
+    uint8_t* buffer,
+    uint32_t length) {
+    while(length) {
+        uint16_t chunk = MIN(length, RESOURCE_DELTA_BUFFER_SIZE);
+        if(storage_file_read(file, buffer, chunk) != chunk ||
+           !resource_patch_writer_push(writer, buffer, chunk)) {
+            return false;
+        }
+        length -= chunk;
+    }
+    return true;
+}
+
+bool resource_delta_patch_file(
+    Storage* storage,
+    const char* source,
+    const char* patch,
+    const char* destination) {
+    File* source_file = storage_file_alloc(storage);
+    File* patch_file = storage_file_alloc(storage);
+    ResourcePatchWriter writer = {
+        .file = storage_file_alloc(storage),
+        .data = malloc(RESOURCE_DELTA_BUFFER_SIZE),
+        .used = 0,
+    };
+    uint8_t* buffer = malloc(RESOURCE_DELTA_BUFFER_SIZE);
+    bool success = false;
+
+    do {
+        if(!storage_file_open(source_file, source, FSAM_READ, FSOM_OPEN_EXISTING) ||
+           !storage_file_open(patch_file, patch, FSAM_READ, FSOM_OPEN_EXISTING) ||
+           !storage_file_open(writer.file, destination, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+
+        const size_t magic_size = strlen(RESOURCE_PATCH_MAGIC);
+        if(storage_file_read(patch_file, buffer, magic_size) != magic_size ||
+           memcmp(buffer, RESOURCE_PATCH_MAGIC, magic_size) != 0) {
+            FURI_LOG_E(TAG, "Bad patch header");
+            break;
+        }
+
+        success = true;
+        uint8_t op;
+        while(success && storage_file_read(patch_file, &op, 1) == 1) {
+            uint32_t offset = 0;
+            uint32_t length = 0;
+            if(op == RESOURCE_PATCH_OP_COPY) {
+                success = resource_patch_read_u32(patch_file, &offset) &&
+                          resource_patch_read_u32(patch_file, &length) &&
+                          storage_file_seek(source_file, offset, true) &&
+                          resource_patch_transfer(source_file, &writer, buffer, length);
+            } else if(op == RESOURCE_PATCH_OP_INSERT) {
+                success = resource_patch_read_u32(patch_file, &length) &&
+                          resource_patch_transfer(patch_file, &writer, buffer, length);
+            } else {
+                FURI_LOG_E(TAG, "Bad patch op %02X", op);
+                success = false;
+            }
+        }
+
+        success = success && (storage_file_get_error(patch_file) == FSE_OK) &&
+                  resource_patch_writer_flush(&writer);
+    } while(false);
+
+    storage_file_free(source_file);
+    storage_file_free(patch_file);
+    storage_file_free(writer.file);
+    free(writer.data);
+    free(buffer);
+    return success;
+}
+
+static bool resource_delta_check_digest(
+    Storage* storage,
+    const char* path,
+    const uint8_t* hash,
+    uint32_t size) {
+    FileInfo file_info;
+    uint8_t digest[16];
+    return (storage_common_stat(storage, path, &file_info) == FSE_OK) &&
+           (file_info.size == size) &&
+           (storage_common_digest(storage, path, StorageDigestTypeMd5, digest) == FSE_OK) &&
+           (memcmp(digest, hash, sizeof(digest)) == 0);
+}
+
+/* Checks version, base and patch sources, counts records. Nothing is written. */
+static ResourceDeltaResult resource_delta_check(
+    Storage* storage,
+    const char* delta_path,
+    const char* destination,
+    uint32_t* total) {
+    ResourceDeltaResult result = ResourceDeltaResultError;
+    ResourceManifestReader* reader = resource_manifest_reader_alloc(storage);
+    string_t base_manifest, source;
+    string_init(base_manifest);
+    string_init(source);
+    path_concat(destination, RESOURCE_MANIFEST_FILENAME, base_manifest);
+
+    bool version_valid = false;
+    bool base_valid = false;
+    *total = 0;
+
+    if(resource_manifest_reader_open(reader, delta_path)) {
+        ResourceManifestEntry* entry;
+        while((entry = resource_manifest_reader_next(reader))) {
+            if(entry->type == ResourceManifestEntryTypeVersion) {
+                version_valid = (entry->size == RESOURCE_DELTA_VERSION);
+            } else if(entry->type == ResourceManifestEntryTypeBase) {
+                uint8_t digest[16];
+                base_valid = (storage_common_digest(
+                                  storage,
+                                  string_get_cstr(base_manifest),
+                                  StorageDigestTypeMd5,
+                                  digest) == FSE_OK) &&
+                             (memcmp(digest, entry->hash, sizeof(digest)) == 0);
+                if(!base_valid) {
+                    result = ResourceDeltaResultBaseMismatch;
+                    break;
+                }
+            } else {
+                if(entry->type == ResourceManifestEntryTypePatch) {
+                    /* Resource changed on SD card since base, patch would not apply */
+                    uint8_t digest[16];
+                    path_concat(destination, string_get_cstr(entry->name), source);
+                    if(storage_common_digest(
+                           storage, string_get_cstr(source), StorageDigestTypeMd5, digest) !=
+                           FSE_OK ||
+                       memcmp(digest, entry->source_hash, sizeof(digest)) != 0) {
+                        FURI_LOG_W(TAG, "Patch source mismatch: %s", string_get_cstr(source));
+                        base_valid = false;
+                        result = ResourceDeltaResultBaseMismatch;
+                        break;
+                    }
+                }
+                (*total)++;
+            }
+        }
+        if(version_valid && base_valid) {
+            result = ResourceDeltaResultOk;
+        }
+    }
+
+    string_clear(base_manifest);
+    string_clear(source);
+    resource_manifest_reader_free(reader);
+    return result;
+}
+
+/* Full files are unpacked in place, patches and the delta list are left for later.
+ * New Manifest goes last, so a failed delta still leaves the old base behind. */
+static bool resource_delta_unpack_filter(const char* name, bool is_directory, void* context) {
+    UNUSED(is_directory);
+    UNUSED(context);
+    size_t prefix_len = strlen(RESOURCE_DELTA_PATCH_PREFIX);
+    if(strncmp(name, RESOURCE_DELTA_PATCH_PREFIX, prefix_len) == 0 &&
+       (name[prefix_len] == '\0' || name[prefix_len] == '/')) {
+        return false;
+    }
+    return (strcmp(name, RESOURCE_DELTA_FILENAME) != 0) &&
+           (strcmp(name, RESOURCE_MANIFEST_FILENAME) != 0);
+}
+
+static bool resource_delta_apply_patch(
+    Storage* storage,
+    TarArchive* archive,
+    const ResourceManifestEntry* entry,
+    const char* work_dir,
+    const char* target) {
+    bool success = false;
+    bool keep_output = false;
+    string_t patch_name, tmp_patch, tmp_output;
+    string_init(patch_name);
+    string_init(tmp_patch);
+    string_init_printf(tmp_output, "%s%s", target, RESOURCE_DELTA_TMP_SUFFIX);
+    path_concat(RESOURCE_DELTA_PATCH_PREFIX, string_get_cstr(entry->name), patch_name);
+    path_concat(work_dir, RESOURCE_DELTA_TMP_PATCH, tmp_patch);
+
+    do {
+        uint8_t digest[16];
+        if(storage_common_digest(storage, target, StorageDigestTypeMd5, digest) != FSE_OK ||
+           memcmp(digest, entry->source_hash, sizeof(digest)) != 0) {
+            FURI_LOG_E(TAG, "Patch source mismatch: %s", target);
+            break;
+        }
+
+        if(!tar_archive_unpack_file(
+               archive, string_get_cstr(patch_name), string_get_cstr(tmp_patch)) ||
+           !resource_delta_patch_file(
+               storage, target, string_get_cstr(tmp_patch), string_get_cstr(tmp_output))) {
+            FURI_LOG_E(TAG, "Failed to patch %s", target);
+            break;
+        }
+
+        if(!resource_delta_check_digest(
+               storage, string_get_cstr(tmp_output), entry->hash, entry->size)) {
+            FURI_LOG_E(TAG, "Patch result mismatch: %s", target);
+            break;
+        }
+
+        /* Target is only touched once its replacement is verified next to it */
+        if(!storage_simply_remove(storage, target)) {
+            FURI_LOG_E(TAG, "Failed to remove %s", target);
+            break;
+        }
+        if(storage_common_rename(storage, string_get_cstr(tmp_output), target) != FSE_OK) {
+            FURI_LOG_E(TAG, "Failed to replace %s, patched file is kept", target);
+            keep_output = true;
+            break;
+        }
+        success = true;
+    } while(false);
+
+    storage_simply_remove(storage, string_get_cstr(tmp_patch));
+    if(!keep_output) {
+        storage_simply_remove(storage, string_get_cstr(tmp_output));
+    }
+    string_clear(patch_name);
+    string_clear(tmp_patch);
+    string_clear(tmp_output);
+    return success;
+}
+
+ResourceDeltaResult resource_delta_apply(
+    Storage* storage,
+    TarArchive* archive,
+    const char* work_dir,
+    const char* destination,
+    ResourceDeltaProgressCallback callback,
+    void* context) {
+    furi_assert(storage);
+    furi_assert(archive);
+
+    ResourceDeltaResult result = ResourceDeltaResultError;
+    ResourceManifestReader* reader = resource_manifest_reader_alloc(storage);
+    string_t delta_path, target;
+    string_init(delta_path);
+    string_init(target);
+    path_concat(work_dir, RESOURCE_DELTA_FILENAME, delta_path);
+
+    do {
+        if(!tar_archive_unpack_file(
+               archive, RESOURCE_DELTA_FILENAME, string_get_cstr(delta_path))) {
+            FURI_LOG_E(TAG, "No delta list");
+            break;
+        }
+
+        uint32_t total = 0;
+        result = resource_delta_check(storage, string_get_cstr(delta_path), destination, &total);
+        if(result != ResourceDeltaResultOk) {
+            FURI_LOG_W(TAG, "Delta is not applicable: %d", result);
+            break;
+        }
+        result = ResourceDeltaResultError;
+
+        tar_archive_set_file_callback(archive, resource_delta_unpack_filter, NULL);
+        if(!tar_archive_unpack_to(archive, destination, NULL)) {
+            break;
+        }
+
+        if(!resource_manifest_reader_open(reader, string_get_cstr(delta_path))) {
+            break;
+        }
+
+        bool success = true;
+        uint32_t processed = 0;
+        ResourceManifestEntry* entry;
+        while(success && (entry = resource_manifest_reader_next(reader))) {
+            path_concat(destination, string_get_cstr(entry->name), target);
+            switch(entry->type) {
+            case ResourceManifestEntryTypeDirectory:
+                success = storage_simply_mkdir(storage, string_get_cstr(target));
+                break;
+            case ResourceManifestEntryTypePatch:
+                success = resource_delta_apply_patch(
+                    storage, archive, entry, work_dir, string_get_cstr(target));
+                break;
+            case ResourceManifestEntryTypeRemove:
+                success = storage_simply_remove_recursive(storage, string_get_cstr(target));
+                break;
+            case ResourceManifestEntryTypeVersion:
+            case ResourceManifestEntryTypeBase:
+                continue;
+            default:
+                /* Full files are already in place */
+                break;
+            }
+
+            processed++;
+            if(callback) {
+                callback(processed, total, context);
+            }
+        }
+
+        if(!success) {
+            break;
+        }
+
+        path_concat(destination, RESOURCE_MANIFEST_FILENAME, target);
+        if(!tar_archive_unpack_file(
+               archive, RESOURCE_MANIFEST_FILENAME, string_get_cstr(target))) {
+            FURI_LOG_E(TAG, "No new Manifest");
+            break;
+        }
+        result = ResourceDeltaResultOk;
+    } while(false);
+
+    storage_simply_remove(storage, string_get_cstr(delta_path));
+    string_clear(delta_path);
+    string_clear(target);
+    resource_manifest_reader_free(reader);
+    return result;
+}
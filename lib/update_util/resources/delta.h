@@ -0,0 +1,77 @@
+#pragma once
+
+#include <storage/storage.h>
+#include <toolbox/tar/tar_archive.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Delta bundle is a tar archive with a "Delta" list in resource manifest format:
+ *  V:<version>
+ *  B:<md5 of base Manifest>               resources the delta applies to
+ *  D:<path>                               directory to create
+ *  F:<md5>:<size>:<path>                  new or changed file, full copy at <path>
+ *  P:<md5>:<size>:<source md5>:<path>     changed file, binary patch at .patch/<path>
+ *  R:<path>                               file or directory to remove
+ * New Manifest is always delivered as a full file. */
+#define RESOURCE_DELTA_FILENAME "Delta"
+#define RESOURCE_DELTA_PATCH_PREFIX ".patch"
+#define RESOURCE_DELTA_VERSION 0
+
+/* Binary patch: magic, then ops until end of file, all integers are little-endian
+ *  'C' <u32 offset> <u32 length>          copy length bytes from source offset
+ *  'I' <u32 length> <data>                insert length bytes of data */
+#define RESOURCE_PATCH_MAGIC "FZDP"
+
+typedef enum {
+    ResourceDeltaResultOk,
+    ResourceDeltaResultBaseMismatch, /* Resources on SD card are not the delta base */
+    ResourceDeltaResultError, /* Broken delta or storage error */
+} ResourceDeltaResult;
+
+/** Progress callback
+ * @param processed processed delta records
+ * @param total total delta records
+ * @param context callback context
+ */
+typedef void (*ResourceDeltaProgressCallback)(uint32_t processed, uint32_t total, void* context);
+
+/** Apply binary patch
+ * @param storage Storage instance
+ * @param source file the patch was made against
+ * @param patch patch file
+ * @param destination output file, overwritten
+ * @return true on success
+ */
+bool resource_delta_patch_file(
+    Storage* storage,
+    const char* source,
+    const char* patch,
+    const char* destination);
+
+/** Apply delta bundle to resources
+ * Nothing is changed if the base or any patch source doesn't match.
+ * New Manifest is written only after all records are applied.
+ * @param storage Storage instance
+ * @param archive delta bundle opened for reading
+ * @param work_dir directory for temporary files, must exist
+ * @param destination resources root
+ * @param callback optional progress callback
+ * @param context callback context
+ * @return ResourceDeltaResult
+ */
+ResourceDeltaResult resource_delta_apply(
+    Storage* storage,
+    TarArchive* archive,
+    const char* work_dir,
+    const char* destination,
+    ResourceDeltaProgressCallback callback,
+    void* context);
+
+#ifdef __cplusplus
+}
+#endif
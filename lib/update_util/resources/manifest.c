@@ -0,0 +1,139 @@
+#include "manifest.h"
+
+#include <toolbox/stream/buffered_file_stream.h>
+#include <toolbox/hex.h>
+
+#include <stdlib.h>
+
+struct ResourceManifestReader {
+    Storage* storage;
+    Stream* stream;
+    string_t linebuf;
+    ResourceManifestEntry entry;
+};
+
+ResourceManifestReader* resource_manifest_reader_alloc(Storage* storage) {
+    ResourceManifestReader* resource_manifest = malloc(sizeof(ResourceManifestReader));
+    resource_manifest->storage = storage;
+    resource_manifest->stream = buffered_file_stream_alloc(resource_manifest->storage);
+    string_init(resource_manifest->linebuf);
+    string_init(resource_manifest->entry.name);
+    return resource_manifest;
+}
+
+void resource_manifest_reader_free(ResourceManifestReader* resource_manifest) {
+    furi_assert(resource_manifest);
+
+    string_clear(resource_manifest->entry.name);
+    string_clear(resource_manifest->linebuf);
+    buffered_file_stream_close(resource_manifest->stream);
+    stream_free(resource_manifest->stream);
+    free(resource_manifest);
+}
+
+bool resource_manifest_reader_open(
+    ResourceManifestReader* resource_manifest,
+    const char* filename) {
+    furi_assert(resource_manifest);
+
+    return buffered_file_stream_open(
+        resource_manifest->stream, filename, FSAM_READ, FSOM_OPEN_EXISTING);
+}
+
+static bool resource_manifest_parse_hash(const char* hex, uint8_t* hash) {
+    for(size_t i = 0; i < 16; i++) {
+        if(!hex_chars_to_uint8(hex[i * 2], hex[i * 2 + 1], &hash[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Parses "<md5 hex>:" prefix, returns pointer past it or NULL */
+static const char* resource_manifest_parse_hash_field(const char* line, uint8_t* hash) {
+    if(strlen(line) < 32 + 1 || line[32] != ':' || !resource_manifest_parse_hash(line, hash)) {
+        return NULL;
+    }
+    return line + 32 + 1;
+}
+
+/* Parses "<size>:" prefix, returns pointer past it or NULL */
+static const char* resource_manifest_parse_size_field(const char* line, uint32_t* size) {
+    char* end = NULL;
+    *size = strtoul(line, &end, 10);
+    if(end == line || *end != ':') {
+        return NULL;
+    }
+    return end + 1;
+}
+
+/* Parses a single line, returns false if it should be skipped */
+static bool resource_manifest_parse_line(ResourceManifestEntry* entry, const char* line) {
+    if(line[0] == '\0' || line[1] != ':') {
+        return false;
+    }
+
+    const char* record = &line[2];
+    entry->size = 0;
+    string_reset(entry->name);
+
+    switch(line[0]) {
+    case 'V':
+        entry->type = ResourceManifestEntryTypeVersion;
+        entry->size = strtoul(record, NULL, 10);
+        return true;
+    case 'T':
+        entry->type = ResourceManifestEntryTypeTimestamp;
+        entry->size = strtoul(record, NULL, 10);
+        return true;
+    case 'D':
+        entry->type = ResourceManifestEntryTypeDirectory;
+        string_set_str(entry->name, record);
+        return true;
+    case 'F':
+        /* F:<md5 hex>:<size>:<path> */
+        record = resource_manifest_parse_hash_field(record, entry->hash);
+        if(record) record = resource_manifest_parse_size_field(record, &entry->size);
+        if(!record) return false;
+        entry->type = ResourceManifestEntryTypeFile;
+        string_set_str(entry->name, record);
+        return true;
+    case 'B':
+        /* B:<md5 hex of base Manifest> */
+        if(strlen(record) != 32 || !resource_manifest_parse_hash(record, entry->hash)) {
+            return false;
+        }
+        entry->type = ResourceManifestEntryTypeBase;
+        return true;
+    case 'P':
+        /* P:<md5 hex>:<size>:<source md5 hex>:<path> */
+        record = resource_manifest_parse_hash_field(record, entry->hash);
+        if(record) record = resource_manifest_parse_size_field(record, &entry->size);
+        if(record) record = resource_manifest_parse_hash_field(record, entry->source_hash);
+        if(!record) return false;
+        entry->type = ResourceManifestEntryTypePatch;
+        string_set_str(entry->name, record);
+        return true;
+    case 'R':
+        entry->type = ResourceManifestEntryTypeRemove;
+        string_set_str(entry->name, record);
+        return true;
+    default:
+        return false;
+    }
+}
+
+ResourceManifestEntry* resource_manifest_reader_next(ResourceManifestReader* resource_manifest) {
+    furi_assert(resource_manifest);
+
+    while(stream_read_line(resource_manifest->stream, resource_manifest->linebuf)) {
+        string_strim(resource_manifest->linebuf);
+        if(resource_manifest_parse_line(
+               &resource_manifest->entry, string_get_cstr(resource_manifest->linebuf))) {
+            return &resource_manifest->entry;
+        }
+        resource_manifest->entry.type = ResourceManifestEntryTypeUnknown;
+    }
+
+    return NULL;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <storage/storage.h>
+#include <m-string.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RESOURCE_MANIFEST_FILENAME "Manifest"
+
+typedef enum {
+    ResourceManifestEntryTypeUnknown = 0,
+    ResourceManifestEntryTypeVersion,
+    ResourceManifestEntryTypeTimestamp,
+    ResourceManifestEntryTypeDirectory,
+    ResourceManifestEntryTypeFile,
+    /* Delta bundle records, see resources/delta.h */
+    ResourceManifestEntryTypeBase,
+    ResourceManifestEntryTypePatch,
+    ResourceManifestEntryTypeRemove,
+} ResourceManifestEntryType;
+
+/* Version and timestamp entries only use the size field, base entry only uses hash.
+ * source_hash is only set for patch entries */
+typedef struct {
+    ResourceManifestEntryType type;
+    string_t name;
+    uint32_t size;
+    uint8_t hash[16];
+    uint8_t source_hash[16];
+} ResourceManifestEntry;
+
+typedef struct ResourceManifestReader ResourceManifestReader;
+
+/** Allocate resource manifest reader
+ * @param storage Storage instance
+ * @return ResourceManifestReader* 
+ */
+ResourceManifestReader* resource_manifest_reader_alloc(Storage* storage);
+
+/** Release resource manifest reader
+ * @param resource_manifest ResourceManifestReader instance
+ */
+void resource_manifest_reader_free(ResourceManifestReader* resource_manifest);
+
+/** Open resource manifest file
+ * @param resource_manifest ResourceManifestReader instance
+ * @param filename manifest file path
+ * @return true if file was opened
+ */
+bool resource_manifest_reader_open(
+    ResourceManifestReader* resource_manifest,
+    const char* filename);
+
+/** Read next entry from the manifest. Malformed lines are skipped.
+ * @param resource_manifest ResourceManifestReader instance
+ * @return entry, owned by the reader and valid until the next call, or NULL at end of file
+ */
+ResourceManifestEntry* resource_manifest_reader_next(ResourceManifestReader* resource_manifest);
+
+#ifdef __cplusplus
+}
+#endif
@@ -18,6 +18,7 @@
 #define MANIFEST_KEY_OB_MASK "OB mask"
 #define MANIFEST_KEY_OB_WRITE_MASK "OB write mask"
 #define MANIFEST_KEY_SPLASH_FILE "Splashscreen"
+#define MANIFEST_KEY_ASSETS_DELTA_FILE "Resources delta"
 
 UpdateManifest* update_manifest_alloc() {
     UpdateManifest* update_manifest = malloc(sizeof(UpdateManifest));
@@ -26,6 +27,7 @@ UpdateManifest* update_manifest_alloc() {
     string_init(update_manifest->radio_image);
     string_init(update_manifest->staged_loader_file);
     string_init(update_manifest->resource_bundle);
+    string_init(update_manifest->resource_delta);
     string_init(update_manifest->splash_file);
     update_manifest->target = 0;
     update_manifest->manifest_version = 0;
@@ -43,6 +45,7 @@ void update_manifest_free(UpdateManifest* update_manifest) {
     string_clear(update_manifest->radio_image);
     string_clear(update_manifest->staged_loader_file);
     string_clear(update_manifest->resource_bundle);
+    string_clear(update_manifest->resource_delta);
     string_clear(update_manifest->splash_file);
     free(update_manifest);
 }
@@ -113,10 +116,16 @@ static bool
         flipper_format_read_string(
             flipper_file, MANIFEST_KEY_SPLASH_FILE, update_manifest->splash_file);
 
+        /* Added later than other keys, don't depend on what was found before */
+        flipper_format_rewind(flipper_file);
+        flipper_format_read_string(
+            flipper_file, MANIFEST_KEY_ASSETS_DELTA_FILE, update_manifest->resource_delta);
+
         update_manifest->valid =
             (!string_empty_p(update_manifest->firmware_dfu_image) ||
              !string_empty_p(update_manifest->radio_image) ||
-             !string_empty_p(update_manifest->resource_bundle));
+             !string_empty_p(update_manifest->resource_bundle) ||
+             !string_empty_p(update_manifest->resource_delta));
     }
 
     return update_manifest->valid;
@@ -38,6 +38,7 @@ typedef struct {
     UpdateManifestRadioVersion radio_version;
     uint32_t radio_crc;
     string_t resource_bundle;
+    string_t resource_delta;
     FuriHalFlashRawOptionByteData ob_reference;
     FuriHalFlashRawOptionByteData ob_compare_mask;
     FuriHalFlashRawOptionByteData ob_write_mask;
@@ -82,6 +82,12 @@ class Main(App):
             help="Symbol and file name in dolphin output directory",
             default=None,
         )
+        self.parser_dolphin.add_argument(
+            "-p",
+            "--pack",
+            action="store_true",
+            help="Store animation frames in a single frames.pack file",
+        )
         self.parser_dolphin.add_argument(
             "input_directory", help="Dolphin source directory"
         )
@@ -264,7 +270,9 @@ class Main(App):
         self.logger.info(f"Loading data")
         dolphin.load(self.args.input_directory)
         self.logger.info(f"Packing")
-        dolphin.pack(self.args.output_directory, self.args.symbol_name)
+        dolphin.pack(
+            self.args.output_directory, self.args.symbol_name, self.args.pack
+        )
         self.logger.info(f"Complete")
 
         return 0
@@ -0,0 +1,208 @@
+import io
+import logging
+import os
+import posixpath
+import struct
+import tarfile
+
+from flipper.utils import file_md5
+from flipper.assets.manifest import (
+    Manifest,
+    ManifestRecordDirectory,
+    ManifestRecordFile,
+)
+
+# Keep in sync with lib/update_util/resources/delta.h
+DELTA_VERSION = 0
+DELTA_FILE_NAME = "Delta"
+DELTA_PATCH_PREFIX = ".patch"
+PATCH_MAGIC = b"FZDP"
+PATCH_OP_COPY = b"C"
+PATCH_OP_INSERT = b"I"
+
+PATCH_BLOCK_SIZE = 32
+# Patch is only used if it is smaller than this fraction of the file
+PATCH_MAX_RATIO = 0.5
+
+
+def make_patch(source: bytes, target: bytes):
+    """Greedy block matching diff, good enough for assets with local edits"""
+    index = {}
+    for offset in range(0, len(source) - PATCH_BLOCK_SIZE + 1, PATCH_BLOCK_SIZE):
+        index.setdefault(source[offset : offset + PATCH_BLOCK_SIZE], offset)
+
+    patch = io.BytesIO()
+    patch.write(PATCH_MAGIC)
+    literal_start = 0
+
+    def flush_literal(end):
+        if end > literal_start:
+            patch.write(PATCH_OP_INSERT + struct.pack("<I", end - literal_start))
+            patch.write(target[literal_start:end])
+
+    position = 0
+    while position + PATCH_BLOCK_SIZE <= len(target):
+        offset = index.get(target[position : position + PATCH_BLOCK_SIZE])
+        if offset is None:
+            position += 1
+            continue
+        # Extend match in both directions
+        start, source_start = position, offset
+        while (
+            start > literal_start
+            and source_start > 0
+            and target[start - 1] == source[source_start - 1]
+        ):
+            start -= 1
+            source_start -= 1
+        end, source_end = position + PATCH_BLOCK_SIZE, offset + PATCH_BLOCK_SIZE
+        while (
+            end < len(target)
+            and source_end < len(source)
+            and target[end] == source[source_end]
+        ):
+            end += 1
+            source_end += 1
+        flush_literal(start)
+        patch.write(PATCH_OP_COPY + struct.pack("<II", source_start, end - start))
+        position = literal_start = end
+    flush_literal(len(target))
+    return patch.getvalue()
+
+
+def apply_patch(source: bytes, patch: bytes):
+    """Reference implementation of lib/update_util/resources/delta.c applier"""
+    if patch[: len(PATCH_MAGIC)] != PATCH_MAGIC:
+        raise ValueError("Bad patch header")
+    result = bytearray()
+    position = len(PATCH_MAGIC)
+    while position < len(patch):
+        op = patch[position : position + 1]
+        if op == PATCH_OP_COPY:
+            offset, length = struct.unpack_from("<II", patch, position + 1)
+            result += source[offset : offset + length]
+            position += 9
+        elif op == PATCH_OP_INSERT:
+            (length,) = struct.unpack_from("<I", patch, position + 1)
+            result += patch[position + 5 : position + 5 + length]
+            position += 5 + length
+        else:
+            raise ValueError(f"Bad patch op {op}")
+    return bytes(result)
+
+
+class ResourceDelta:
+    """Difference between two resource directories with Manifest files"""
+
+    def __init__(self, base_dir: str, target_dir: str):
+        self.logger = logging.getLogger(self.__class__.__name__)
+        self.base_dir = base_dir
+        self.target_dir = target_dir
+        self.lines = [f"V:{DELTA_VERSION}\n"]
+        self.files = []
+        self.patches = []
+
+        base_manifest_path = os.path.join(base_dir, "Manifest")
+        self.lines.append(f"B:{file_md5(base_manifest_path)}\n")
+        base = self._load(base_manifest_path)
+        target = self._load(os.path.join(target_dir, "Manifest"))
+
+        for path in sorted(set(base) & set(target)):
+            if type(base[path]) != type(target[path]):
+                raise ValueError(
+                    f'"{path}" changed type, delta is not possible, use full bundle'
+                )
+
+        self._diff(base, target)
+
+    @staticmethod
+    def _load(path):
+        manifest = Manifest()
+        manifest.load(path)
+        records = {}
+        for record in manifest.records:
+            if isinstance(record, (ManifestRecordDirectory, ManifestRecordFile)):
+                records[record.path] = record
+        return records
+
+    def _diff(self, base, target):
+        for path, record in target.items():
+            if isinstance(record, ManifestRecordDirectory) and path not in base:
+                self.lines.append(f"D:{path}\n")
+
+        for path, record in target.items():
+            if not isinstance(record, ManifestRecordFile):
+                continue
+            base_record = base.get(path)
+            if base_record and (base_record.md5, base_record.size) == (
+                record.md5,
+                record.size,
+            ):
+                continue
+            if base_record and self._add_patch(base_record, record):
+                continue
+            self.lines.append(f"F:{record.md5}:{record.size}:{path}\n")
+            self.files.append(path)
+
+        # Updated Manifest makes next delta possible
+        manifest_path = os.path.join(self.target_dir, "Manifest")
+        self.lines.append(
+            f"F:{file_md5(manifest_path)}:{os.path.getsize(manifest_path)}:Manifest\n"
+        )
+        self.files.append("Manifest")
+
+        # Files first, then directories from the deepest
+        removed = sorted(set(base) - set(target), reverse=True)
+        removed.sort(key=lambda path: isinstance(base[path], ManifestRecordDirectory))
+        for path in removed:
+            self.lines.append(f"R:{path}\n")
+
+    def _add_patch(self, base_record, record):
+        with open(os.path.join(self.base_dir, base_record.path), "rb") as f:
+            source = f.read()
+        with open(os.path.join(self.target_dir, record.path), "rb") as f:
+            target = f.read()
+        patch = make_patch(source, target)
+        if len(patch) > len(target) * PATCH_MAX_RATIO:
+            return False
+        assert apply_patch(source, patch) == target
+        self.lines.append(
+            f"P:{record.md5}:{record.size}:{base_record.md5}:{record.path}\n"
+        )
+        self.patches.append((record.path, patch))
+        return True
+
+    def _add_parents(self, tarball, path, added):
+        parent = posixpath.dirname(path)
+        if not parent or parent in added:
+            return
+        self._add_parents(tarball, parent, added)
+        info = tarfile.TarInfo(parent)
+        info.type = tarfile.DIRTYPE
+        info.mode = 0o755
+        tarball.addfile(info)
+        added.add(parent)
+
+    def save(self, filename, mode="w:", format=tarfile.USTAR_FORMAT):
+        added = set()
+        with tarfile.open(filename, mode, format=format) as tarball:
+            data = "".join(self.lines).encode()
+            info = tarfile.TarInfo(DELTA_FILE_NAME)
+            info.size = len(data)
+            tarball.addfile(info, io.BytesIO(data))
+
+            for path in self.files:
+                self._add_parents(tarball, path, added)
+                tarball.add(os.path.join(self.target_dir, path), arcname=path)
+
+            for path, patch in self.patches:
+                arcname = posixpath.join(DELTA_PATCH_PREFIX, path)
+                self._add_parents(tarball, arcname, added)
+                info = tarfile.TarInfo(arcname)
+                info.size = len(patch)
+                tarball.addfile(info, io.BytesIO(patch))
+
+        self.logger.info(
+            f"Delta: {len(self.files)} files, {len(self.patches)} patches, "
+            f"{os.path.getsize(filename)} bytes"
+        )
@@ -3,6 +3,7 @@ import logging
 import os
 import sys
 import shutil
+import struct
 from collections import Counter
 
 from flipper.utils.fff import *
@@ -21,6 +22,32 @@ def _convert_image(source_filename: str):
     return image.data
 
 
+class DolphinFramesPack:
+    """Single file with all animation frames, loaded by firmware in one read
+
+    Header: magic, version, frame count, reserved
+    Index: frame count + 1 offsets from the start of frame data
+    Data: frames, same as frame_N.bm
+    """
+
+    FILE_NAME = "frames.pack"
+    MAGIC = b"Fapk"
+    VERSION = 1
+
+    @classmethod
+    def save(cls, filename: str, frames: list):
+        assert 0 < len(frames) <= 255
+        offsets = [0]
+        for frame in frames:
+            offsets.append(offsets[-1] + len(frame))
+
+        with open(filename, "wb") as file:
+            file.write(struct.pack("<4sBBH", cls.MAGIC, cls.VERSION, len(frames), 0))
+            file.write(struct.pack(f"<{len(offsets)}I", *offsets))
+            for frame in frames:
+                file.write(frame)
+
+
 class DolphinBubbleAnimation:
 
     FILE_TYPE = "Flipper Animation"
@@ -183,7 +210,7 @@ class DolphinBubbleAnimation:
             if bubbles_in_slots[slot] != 0:
                 bubble["_NextBubbleIndex"] = bubble_index + 1
 
-    def save(self, output_directory: str):
+    def save(self, output_directory: str, pack: bool = False):
         animation_directory = os.path.join(output_directory, self.name)
         os.makedirs(animation_directory, exist_ok=True)
         meta_filename = os.path.join(animation_directory, "meta.txt")
@@ -221,6 +248,14 @@ class DolphinBubbleAnimation:
 
         file.save(meta_filename)
 
+        if pack:
+            self.process()
+            DolphinFramesPack.save(
+                os.path.join(animation_directory, DolphinFramesPack.FILE_NAME),
+                self.frames,
+            )
+            return
+
         to_pack = []
         for index, frame in enumerate(self.frames):
             to_pack.append(
@@ -329,7 +364,7 @@ class DolphinManifest:
             symbol_name=symbol_name,
         )
 
-    def save2folder(self, output_directory: str):
+    def save2folder(self, output_directory: str, pack: bool = False):
         manifest_filename = os.path.join(output_directory, "manifest.txt")
         file = FlipperFormatFile()
         file.setHeader(self.FILE_TYPE, self.FILE_VERSION)
@@ -344,16 +379,16 @@ class DolphinManifest:
             file.writeKey("Weight", animation.weight)
             file.writeEmptyLine()
 
-            animation.save(output_directory)
+            animation.save(output_directory, pack)
 
         file.save(manifest_filename)
 
-    def save(self, output_directory: str, symbol_name: str):
+    def save(self, output_directory: str, symbol_name: str, pack: bool = False):
         os.makedirs(output_directory, exist_ok=True)
         if symbol_name:
             self.save2code(output_directory, symbol_name)
         else:
-            self.save2folder(output_directory)
+            self.save2folder(output_directory, pack)
 
 
 class Dolphin:
@@ -367,5 +402,7 @@ class Dolphin:
         self.logger.info(f"Loading directory {source_directory}")
         self.manifest.load(source_directory)
 
-    def pack(self, output_directory: str, symbol_name: str = None):
-        self.manifest.save(output_directory, symbol_name)
+    def pack(
+        self, output_directory: str, symbol_name: str = None, frames_pack: bool = False
+    ):
+        self.manifest.save(output_directory, symbol_name, frames_pack)
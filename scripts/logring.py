@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+
+from flipper.app import App
+
+import re
+import struct
+
+# Keep in sync with furi/core/log.c
+RING_HEADER = struct.Struct("<III")
+RING_SIZE = 4096
+RECORD_HEADER = struct.Struct("<HBBIII")
+
+LEVELS = {2: "E", 3: "W", 4: "I", 5: "D", 6: "T"}
+SPEC_RE = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?([hlzjtL]*)([a-zA-Z%])")
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument(
+            "firmware", help="Firmware .bin the ring was dumped from"
+        )
+        self.parser.add_argument(
+            "ring",
+            help="Ring dump, for example from gdb: dump binary memory ring.bin "
+            "furi_log.ring ((char*)furi_log.ring + sizeof(*furi_log.ring))",
+        )
+        self.parser.add_argument(
+            "-b",
+            "--base",
+            type=lambda x: int(x, 0),
+            default=0x08000000,
+            help="Firmware load address",
+        )
+        self.parser.set_defaults(func=self.decode)
+
+    def _cstring(self, address):
+        offset = address - self.args.base
+        if offset < 0 or offset >= len(self.firmware):
+            return f"<0x{address:08x}>"
+        end = self.firmware.find(b"\0", offset)
+        return self.firmware[offset:end].decode("utf-8", errors="replace")
+
+    def _format(self, format, args):
+        words = list(args)
+        output = ""
+        position = 0
+        for match in SPEC_RE.finditer(format):
+            output += format[position : match.start()]
+            position = match.end()
+            flags, width, precision, length, conversion = match.groups()
+            if conversion == "%":
+                output += "%"
+                continue
+            if width == "*":
+                width = str(struct.unpack("<i", struct.pack("<I", words.pop(0)))[0])
+            if precision == "*":
+                precision = str(struct.unpack("<i", struct.pack("<I", words.pop(0)))[0])
+            spec = "%" + flags + (width or "")
+            if precision is not None:
+                spec += "." + (precision or "0")
+            wide = length.count("l") >= 2 or "j" in length
+            if conversion in "diuxXoc":
+                if wide:
+                    value = words.pop(0) | words.pop(0) << 32
+                    bits = 64
+                else:
+                    value = words.pop(0)
+                    bits = 32
+                if conversion in "di":
+                    value -= (value >> (bits - 1)) << bits
+                    conversion = "d"
+                elif conversion == "u":
+                    conversion = "d"
+                output += (spec + conversion) % value
+            elif conversion in "fFeEgGaA":
+                raw = struct.pack("<II", words.pop(0), words.pop(0))
+                value = struct.unpack("<d", raw)[0]
+                conversion = conversion.replace("a", "e").replace("A", "E")
+                output += (spec + conversion) % value
+            elif conversion == "p":
+                output += "0x%08x" % words.pop(0)
+            elif conversion == "s":
+                length = words.pop(0)
+                count = (length + 4) // 4
+                data = struct.pack(f"<{count}I", *words[:count])[:length]
+                del words[:count]
+                output += (spec + "s") % data.decode("utf-8", errors="replace")
+        return output + format[position:]
+
+    def decode(self):
+        with open(self.args.firmware, "rb") as f:
+            self.firmware = f.read()
+        with open(self.args.ring, "rb") as f:
+            dump = f.read()
+
+        head, tail, dropped = RING_HEADER.unpack_from(dump)
+        buffer = dump[RING_HEADER.size :]
+        if len(buffer) < RING_SIZE:
+            self.logger.error(f"Ring dump is too short: {len(dump)} bytes")
+            return 1
+
+        while tail != head:
+            offset = tail % RING_SIZE
+            size, level = struct.unpack_from("<HB", buffer, offset)
+            if size == 0:
+                self.logger.warning("Uncommitted record, stopping")
+                break
+            # Padding at the end of the ring may be shorter than record header
+            if level in LEVELS:
+                _, _, args_count, timestamp, tag, format = RECORD_HEADER.unpack_from(
+                    buffer, offset
+                )
+                args = struct.unpack_from(
+                    f"<{args_count}I", buffer, offset + RECORD_HEADER.size
+                )
+                message = self._format(self._cstring(format), args)
+                print(f"{timestamp} [{LEVELS[level]}][{self._cstring(tag)}] {message}")
+            tail = (tail + size) & 0xFFFFFFFF
+
+        print(f"Dropped records: {dropped}")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+
+from flipper.app import App
+
+import struct
+
+# Keep in sync with lib/subghz/subghz_keystore.c
+KEYSTORE_FILE_TYPE = "Flipper SubGhz Keystore File"
+KEYSTORE_BINARY_FILE_TYPE = "Flipper SubGhz Keystore Binary File"
+KEYSTORE_FILE_VERSION = 0
+KEYSTORE_BINARY_KEYS_MAX = 0x10000
+KEYSTORE_BINARY_NAMES_MAX = 0x10000
+RECORD = struct.Struct("<QHHI")
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_compile = self.subparsers.add_parser(
+            "compile",
+            help="Convert unencrypted text keystore to binary keystore. "
+            "Encrypt result on device with 'subghz encrypt_keeloq_bin'",
+        )
+        self.parser_compile.add_argument("source", help="Text keystore")
+        self.parser_compile.add_argument("output", help="Binary keystore")
+        self.parser_compile.set_defaults(func=self.compile)
+
+        self.parser_decompile = self.subparsers.add_parser(
+            "decompile", help="Convert unencrypted binary keystore to text keystore"
+        )
+        self.parser_decompile.add_argument("source", help="Binary keystore")
+        self.parser_decompile.add_argument("output", help="Text keystore")
+        self.parser_decompile.set_defaults(func=self.decompile)
+
+    def _read_header(self, file, filetype):
+        header = {}
+        for key in ("Filetype", "Version", "Encryption"):
+            line = file.readline().decode().strip()
+            name, _, value = line.partition(": ")
+            if name != key:
+                raise ValueError(f"Missing {key}")
+            header[key] = value
+        if header["Filetype"] != filetype:
+            raise ValueError(f"Unexpected file type: {header['Filetype']}")
+        if int(header["Version"]) != KEYSTORE_FILE_VERSION:
+            raise ValueError(f"Unsupported version: {header['Version']}")
+        if int(header["Encryption"]) != 0:
+            raise ValueError("Encrypted keystores can only be processed on device")
+        return header
+
+    def compile(self):
+        keys = []
+        with open(self.args.source, "rb") as file:
+            self._read_header(file, KEYSTORE_FILE_TYPE)
+            for line in file:
+                line = line.decode().strip()
+                if not line:
+                    continue
+                key, key_type, name = line.split(":", 2)
+                keys.append((int(key, 16), int(key_type), name))
+
+        # Equal names are stored once, in order of first use
+        offsets = {}
+        names = bytearray()
+        for _, _, name in keys:
+            if name not in offsets:
+                offsets[name] = len(names)
+                names += name.encode() + b"\0"
+        if not names or len(names) % 16:
+            names += b"\0" * (16 - len(names) % 16)
+
+        if (
+            len(keys) > KEYSTORE_BINARY_KEYS_MAX
+            or len(names) > KEYSTORE_BINARY_NAMES_MAX
+        ):
+            self.logger.error("Keystore is too large")
+            return 1
+
+        with open(self.args.output, "wb") as file:
+            file.write(
+                f"Filetype: {KEYSTORE_BINARY_FILE_TYPE}\n"
+                f"Version: {KEYSTORE_FILE_VERSION}\n"
+                "Encryption: 0\n"
+                f"Keys: {len(keys)}\n"
+                f"Names: {len(names)}\n"
+                "Encrypt_data: BIN\n".encode()
+            )
+            for key, key_type, name in keys:
+                file.write(RECORD.pack(key, key_type, 0, offsets[name]))
+            file.write(names)
+
+        self.logger.info(f"Compiled {len(keys)} keys, {len(names)} bytes of names")
+        return 0
+
+    def decompile(self):
+        with open(self.args.source, "rb") as file:
+            self._read_header(file, KEYSTORE_BINARY_FILE_TYPE)
+            fields = {}
+            for key in ("Keys", "Names", "Encrypt_data"):
+                name, _, value = file.readline().decode().strip().partition(": ")
+                if name != key:
+                    raise ValueError(f"Missing {key}")
+                fields[key] = value
+            count = int(fields["Keys"])
+            records = file.read(count * RECORD.size)
+            names = file.read(int(fields["Names"]))
+
+        with open(self.args.output, "w") as file:
+            file.write(
+                f"Filetype: {KEYSTORE_FILE_TYPE}\n"
+                f"Version: {KEYSTORE_FILE_VERSION}\n"
+                "Encryption: 0\n"
+            )
+            for key, key_type, _, offset in RECORD.iter_unpack(records):
+                name = names[offset : names.index(b"\0", offset)].decode()
+                file.write(f"{key:016X}:{key_type}:{name}\n")
+
+        self.logger.info(f"Decompiled {count} keys")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -4,6 +4,7 @@ from flipper.app import App
 from flipper.utils.fff import FlipperFormatFile
 from flipper.assets.coprobin import CoproBinary, get_stack_type
 from flipper.assets.obdata import OptionBytesData, ObReferenceValues
+from flipper.assets.delta import ResourceDelta
 from os.path import basename, join, exists
 import os
 import shutil
@@ -22,6 +23,7 @@ class Main(App):
     RESOURCE_TAR_MODE = "w:"
     RESOURCE_TAR_FORMAT = tarfile.USTAR_FORMAT
     RESOURCE_FILE_NAME = "resources.tar"
+    RESOURCE_DELTA_FILE_NAME = "resources_delta.tar"
 
     WHITELISTED_STACK_TYPES = set(
         map(
@@ -51,6 +53,18 @@ class Main(App):
             "--dfu", dest="dfu", default="", required=False
         )
         self.parser_generate.add_argument("-r", dest="resources", required=False)
+        self.parser_generate.add_argument(
+            "--resources-base",
+            dest="resources_base",
+            required=False,
+            help="Previous resources directory, to generate a delta bundle against",
+        )
+        self.parser_generate.add_argument(
+            "--delta-only",
+            dest="delta_only",
+            action="store_true",
+            help="Don't include full resources bundle, update requires delta base",
+        )
         self.parser_generate.add_argument("--stage", dest="stage", required=True)
         self.parser_generate.add_argument(
             "--radio", dest="radiobin", default="", required=False
@@ -80,6 +94,7 @@ class Main(App):
         dfu_basename = basename(self.args.dfu)
         radiobin_basename = basename(self.args.radiobin)
         resources_basename = ""
+        resources_delta_basename = ""
 
         radio_version = 0
         radio_meta = None
@@ -118,7 +133,16 @@ class Main(App):
             shutil.copyfile(
                 self.args.radiobin, join(self.args.directory, radiobin_basename)
             )
-        if self.args.resources:
+        if self.args.resources and self.args.resources_base:
+            resources_delta_basename = self.RESOURCE_DELTA_FILE_NAME
+            ResourceDelta(self.args.resources_base, self.args.resources).save(
+                join(self.args.directory, resources_delta_basename),
+                self.RESOURCE_TAR_MODE,
+                self.RESOURCE_TAR_FORMAT,
+            )
+        if self.args.resources and not (
+            self.args.delta_only and resources_delta_basename
+        ):
             resources_basename = self.RESOURCE_FILE_NAME
             self.package_resources(
                 self.args.resources, join(self.args.directory, resources_basename)
@@ -172,6 +196,7 @@ class Main(App):
         file.writeKey("OB mask", self.bytes2ffhex(obvalues.compare_mask))
         file.writeKey("OB write mask", self.bytes2ffhex(obvalues.write_mask))
         file.writeKey("Splashscreen", self.SPLASH_BIN_NAME if self.args.splash else "")
+        file.writeKey("Resources delta", resources_delta_basename)
         file.save(join(self.args.directory, self.UPDATE_MANIFEST_NAME))
 
         return 0
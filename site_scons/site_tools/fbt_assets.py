@@ -37,13 +37,21 @@ def dolphin_emitter(target, source, env):
     env.Replace(_DOLPHIN_OUT_DIR=target[0])
 
     if env["DOLPHIN_RES_TYPE"] == "external":
+        # Frames of every animation are packed into a single file
+        def packed_path(rel_path):
+            if rel_path.endswith(".png"):
+                return os.path.join(os.path.dirname(rel_path), "frames.pack")
+            return rel_path
+
         target = []
         target.extend(
             map(
-                lambda node: target_base_dir.File(
-                    res_root_dir.rel_path(node).replace(".png", ".bm")
+                target_base_dir.File,
+                dict.fromkeys(
+                    packed_path(res_root_dir.rel_path(node))
+                    for node in source
+                    if isinstance(node, SCons.Node.FS.File)
                 ),
-                filter(lambda node: isinstance(node, SCons.Node.FS.File), source),
             )
         )
     else:
@@ -132,7 +140,7 @@ def generate(env):
             ),
             "DolphinExtBuilder": Builder(
                 action=Action(
-                    '${PYTHON3} "${ASSETS_COMPILER}" dolphin "${SOURCE}" "${_DOLPHIN_OUT_DIR}"',
+                    '${PYTHON3} "${ASSETS_COMPILER}" dolphin --pack "${SOURCE}" "${_DOLPHIN_OUT_DIR}"',
                     "${DOLPHINCOMSTR}",
                 ),
                 emitter=dolphin_emitter,